@@ -13,17 +13,14 @@
 #include "ring_buffer.h"
 
 /* External declarations -----------------------------------------------------*/
-#if RING_BUFFER_ENABLE_LOCKFREE
-extern const ring_buffer_ops_t ring_buffer_lockfree_ops;
-#endif
-#if RING_BUFFER_ENABLE_DISABLE_IRQ
-extern const ring_buffer_ops_t ring_buffer_disable_irq_ops;
-#endif
+/* 内置策略的操作表声明在 ring_buffer.h（静态定义）中 */
 #if RING_BUFFER_ENABLE_MUTEX
-extern const ring_buffer_ops_t ring_buffer_mutex_ops;
 extern bool ring_buffer_mutex_init(ring_buffer_t *rb);
 extern void ring_buffer_mutex_deinit(ring_buffer_t *rb);
 #endif
+#if RING_BUFFER_ENABLE_TRACE
+extern void ring_buffer_trace_record(ring_buffer_trace_t *tr, uint32_t len, ring_buffer_size_t done);
+#endif
 
 /* Private types -------------------------------------------------------------*/
 typedef struct {
@@ -36,7 +33,7 @@ static custom_ops_entry_t custom_ops_registry[RING_BUFFER_MAX_CUSTOM_OPS];
 static uint8_t custom_ops_count = 0;
 
 /* Private functions ---------------------------------------------------------*/
-static bool ring_buffer_init_common(ring_buffer_t *rb, uint8_t *buffer, uint16_t size)
+static bool ring_buffer_init_common(ring_buffer_t *rb, uint8_t *buffer, ring_buffer_size_t size)
 {
     if (!rb) {
         RB_LOG_ERROR("rb is NULL");
@@ -53,6 +50,13 @@ static bool ring_buffer_init_common(ring_buffer_t *rb, uint8_t *buffer, uint16_t
         return false;
     }
     
+#if RING_BUFFER_SIZE_32BIT
+    if (size > RING_BUFFER_SIZE_MAX) {
+        RB_LOG_ERROR("size=%lu > SIZE_MAX=%lu", (unsigned long)size, RING_BUFFER_SIZE_MAX);
+        return false;
+    }
+#endif
+    
     rb->buffer = buffer;
     rb->size = size;
     rb->head = 0;
@@ -66,6 +70,26 @@ static bool ring_buffer_init_common(ring_buffer_t *rb, uint8_t *buffer, uint16_t
     rb->overflow_count = 0;
 #endif
     
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+    rb->shadow_head = 0;
+    rb->tail_cache = 0;
+    rb->head_stamp = 0;
+    rb->shadow_tail = 0;
+    rb->head_cache = 0;
+    rb->tail_stamp = 0;
+    rb->batch_bytes = RING_BUFFER_BATCH_BYTES;
+    rb->batch_delay = RING_BUFFER_BATCH_MAX_DELAY;
+#endif
+    
+#if RING_BUFFER_ENABLE_SPINLOCK
+    rb->spin_next = 0;
+    rb->spin_owner = 0;
+#endif
+    
+#if RING_BUFFER_ENABLE_TRACE
+    rb->trace = NULL;
+#endif
+    
     return true;
 }
 
@@ -83,7 +107,7 @@ static const struct ring_buffer_ops* find_custom_ops(ring_buffer_type_t type)
 bool ring_buffer_create(
     ring_buffer_t *rb,
     uint8_t *buffer,
-    uint16_t size,
+    ring_buffer_size_t size,
     ring_buffer_type_t type)
 {
     if (!ring_buffer_init_common(rb, buffer, size)) {
@@ -117,6 +141,23 @@ bool ring_buffer_create(
             return true;
 #endif
         
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+        case RING_BUFFER_TYPE_LOCKFREE_BATCH:
+            rb->ops = &ring_buffer_lockfree_batch_ops;
+            if (rb->batch_bytes > RING_BUFFER_BATCH_LIMIT(size)) {
+                rb->batch_bytes = RING_BUFFER_BATCH_LIMIT(size);
+            }
+            RB_LOG_INFO("Created lockfree_batch buffer (size=%u, batch=%u)", size, rb->batch_bytes);
+            return true;
+#endif
+        
+#if RING_BUFFER_ENABLE_SPINLOCK
+        case RING_BUFFER_TYPE_SPINLOCK:
+            rb->ops = &ring_buffer_spinlock_ops;
+            RB_LOG_INFO("Created spinlock buffer (size=%u)", size);
+            return true;
+#endif
+        
         default:
             if (type >= RING_BUFFER_TYPE_CUSTOM_BASE) {
                 const struct ring_buffer_ops *custom_ops = find_custom_ops(type);
@@ -155,6 +196,10 @@ void ring_buffer_destroy(ring_buffer_t *rb)
     rb->tail = 0;
     rb->lock = NULL;
     rb->ops = NULL;
+    
+#if RING_BUFFER_ENABLE_TRACE
+    rb->trace = NULL;
+#endif
 }
 
 bool ring_buffer_register_ops(ring_buffer_type_t type, const ring_buffer_ops_t *ops)
@@ -224,7 +269,7 @@ bool ring_buffer_read(ring_buffer_t *rb, uint8_t *data)
     return rb->ops->read(rb, data);
 }
 
-uint16_t ring_buffer_write_multi(ring_buffer_t *rb, const uint8_t *data, uint16_t len)
+ring_buffer_size_t ring_buffer_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len)
 {
     if (!rb) {
         RB_LOG_ERROR("rb is NULL");
@@ -246,10 +291,19 @@ uint16_t ring_buffer_write_multi(ring_buffer_t *rb, const uint8_t *data, uint16_
         return 0;
     }
     
+#if RING_BUFFER_ENABLE_TRACE
+    ring_buffer_trace_t *tr = rb->trace;
+    if (tr) {
+        ring_buffer_size_t done = rb->ops->write_multi(rb, data, len);
+        ring_buffer_trace_record(tr, (uint32_t)len, done);
+        return done;
+    }
+#endif
+    
     return rb->ops->write_multi(rb, data, len);
 }
 
-uint16_t ring_buffer_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t len)
+ring_buffer_size_t ring_buffer_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len)
 {
     if (!rb) {
         RB_LOG_ERROR("rb is NULL");
@@ -271,10 +325,19 @@ uint16_t ring_buffer_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t len)
         return 0;
     }
     
+#if RING_BUFFER_ENABLE_TRACE
+    ring_buffer_trace_t *tr = rb->trace;
+    if (tr) {
+        ring_buffer_size_t done = rb->ops->read_multi(rb, data, len);
+        ring_buffer_trace_record(tr, (uint32_t)len | RING_BUFFER_TRACE_OP_READ, done);
+        return done;
+    }
+#endif
+    
     return rb->ops->read_multi(rb, data, len);
 }
 
-uint16_t ring_buffer_available(const ring_buffer_t *rb)
+ring_buffer_size_t ring_buffer_available(const ring_buffer_t *rb)
 {
     if (!rb) {
         RB_LOG_ERROR("rb is NULL");
@@ -289,7 +352,7 @@ uint16_t ring_buffer_available(const ring_buffer_t *rb)
     return rb->ops->available(rb);
 }
 
-uint16_t ring_buffer_free_space(const ring_buffer_t *rb)
+ring_buffer_size_t ring_buffer_free_space(const ring_buffer_t *rb)
 {
     if (!rb) {
         RB_LOG_ERROR("rb is NULL");
@@ -348,3 +411,73 @@ void ring_buffer_clear(ring_buffer_t *rb)
     
     rb->ops->clear(rb);
 }
+
+void ring_buffer_flush(ring_buffer_t *rb, uint8_t flags)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return;
+    }
+    
+    if (!rb->ops) {
+        RB_LOG_ERROR("ops is NULL");
+        return;
+    }
+    
+    /* 未实现 flush 的策略每次操作都立即发布 */
+    if (rb->ops->flush) {
+        rb->ops->flush(rb, flags);
+    }
+}
+
+ring_buffer_size_t ring_buffer_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                         ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL");
+        return 0;
+    }
+    
+    if (len == 0) {
+        RB_LOG_WARN("len is 0");
+        return 0;
+    }
+    
+    if (!rb->ops || !rb->ops->read_span) {
+        RB_LOG_ERROR("ops or read_span is NULL");
+        return 0;
+    }
+    
+    return rb->ops->read_span(rb, len, fn, ctx, flags);
+}
+
+ring_buffer_size_t ring_buffer_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                          ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL");
+        return 0;
+    }
+    
+    if (len == 0) {
+        RB_LOG_WARN("len is 0");
+        return 0;
+    }
+    
+    if (!rb->ops || !rb->ops->write_span) {
+        RB_LOG_ERROR("ops or write_span is NULL");
+        return 0;
+    }
+    
+    return rb->ops->write_span(rb, len, fn, ctx, flags);
+}
@@ -21,8 +21,20 @@ extern "C" {
 
 /* Forward declarations ------------------------------------------------------*/
 typedef struct ring_buffer_ops ring_buffer_ops_t;
+typedef struct ring_buffer_trace ring_buffer_trace_t;
 
 /* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 长度/索引类型（由 RING_BUFFER_SIZE_32BIT 选择）
+ */
+#if RING_BUFFER_SIZE_32BIT
+typedef uint32_t ring_buffer_size_t;
+#define RING_BUFFER_SIZE_MAX  0x7FFFFFFFUL      /**< 保证 head + len 不溢出 */
+#else
+typedef uint16_t ring_buffer_size_t;
+#define RING_BUFFER_SIZE_MAX  UINT16_MAX
+#endif
+
 /**
  * @brief 线程安全策略枚举
  */
@@ -30,6 +42,8 @@ typedef enum {
     RING_BUFFER_TYPE_LOCKFREE = 0,   /**< 无锁模式（SPSC）*/
     RING_BUFFER_TYPE_DISABLE_IRQ,    /**< 关中断模式（裸机）*/
     RING_BUFFER_TYPE_MUTEX,          /**< 互斥锁模式（RTOS）*/
+    RING_BUFFER_TYPE_LOCKFREE_BATCH, /**< 无锁批量发布模式（SPSC 高吞吐）*/
+    RING_BUFFER_TYPE_SPINLOCK,       /**< 排队自旋锁模式（多核主机，短临界区）*/
     RING_BUFFER_TYPE_CUSTOM_BASE     /**< 自定义策略起始值 */
 } ring_buffer_type_t;
 
@@ -38,9 +52,9 @@ typedef enum {
  */
 typedef struct {
     uint8_t *buffer;                        /**< 数据缓冲区指针 */
-    uint16_t size;                          /**< 缓冲区总大小（字节）*/
-    volatile uint16_t head;                 /**< 写指针（生产者）*/
-    volatile uint16_t tail;                 /**< 读指针（消费者）*/
+    ring_buffer_size_t size;                /**< 缓冲区总大小（字节）*/
+    volatile ring_buffer_size_t head;       /**< 写指针（生产者）*/
+    volatile ring_buffer_size_t tail;       /**< 读指针（消费者）*/
     void *lock;                             /**< 锁句柄（互斥锁模式）*/
     const ring_buffer_ops_t *ops;           /**< 操作接口指针 */
     
@@ -49,21 +63,88 @@ typedef struct {
     uint32_t read_count;                    /**< 读取次数 */
     uint32_t overflow_count;                /**< 溢出次数 */
 #endif
+    
+#if RING_BUFFER_ENABLE_SPINLOCK
+    volatile uint32_t spin_next;            /**< 下一个发放的票号 */
+    volatile uint32_t spin_owner;           /**< 当前持锁的票号 */
+#endif
+    
+#if RING_BUFFER_ENABLE_TRACE
+    ring_buffer_trace_t *trace;             /**< 轨迹录制器（NULL = 不录制）*/
+#endif
+    
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+    ring_buffer_size_t batch_bytes;         /**< 发布阈值（字节）*/
+    uint32_t batch_delay;                   /**< 最长滞留时间（时基单位，0=不限）*/
+    
+    /* 生产者私有（独占缓存行，每次写入只修改本行）*/
+    ring_buffer_size_t shadow_head RB_CACHE_ALIGNED; /**< 未发布的写指针 */
+    ring_buffer_size_t tail_cache;          /**< 上次读到的读指针 */
+    uint32_t head_stamp;                    /**< 最早未发布写入的时间戳 */
+    
+    /* 消费者私有（独占缓存行，每次读取只修改本行）*/
+    ring_buffer_size_t shadow_tail RB_CACHE_ALIGNED; /**< 未发布的读指针 */
+    ring_buffer_size_t head_cache;          /**< 上次读到的写指针 */
+    uint32_t tail_stamp;                    /**< 最早未发布读取的时间戳 */
+#endif
 } ring_buffer_t;
 
+/**
+ * @brief 连续数据段描述
+ * @note 数据跨越缓冲区末尾时被拆分为两段
+ */
+typedef struct {
+    uint8_t *data;                          /**< 段起始地址（指向缓冲区内部）*/
+    ring_buffer_size_t len;                 /**< 段长度（字节）*/
+} ring_buffer_span_t;
+
+/**
+ * @brief 数据段访问回调
+ * @param ctx   用户上下文
+ * @param spans 数据段数组（按逻辑顺序排列）
+ * @param count 数据段数量（1 或 2）
+ * @return 已处理的字节数（从第一段起算，不得超过各段长度之和）
+ * @note 回调在策略的临界区内执行（关中断/持锁），应尽量简短
+ */
+typedef ring_buffer_size_t (*ring_buffer_span_fn_t)(void *ctx, const ring_buffer_span_t *spans, uint8_t count);
+
+/**
+ * @brief 分散/聚集读写的数据块描述（与 POSIX struct iovec 对应）
+ */
+typedef struct {
+    void *base;                             /**< 数据块起始地址 */
+    ring_buffer_size_t len;                 /**< 数据块长度（字节）*/
+} ring_buffer_iovec_t;
+
+/**
+ * @brief 刷新标志（ring_buffer_flush）
+ */
+#define RING_BUFFER_FLUSH_WRITE  0x01U  /**< 发布生产者累积的写指针（仅生产者调用）*/
+#define RING_BUFFER_FLUSH_READ   0x02U  /**< 发布消费者累积的读指针（仅消费者调用）*/
+
+/**
+ * @brief 数据段访问标志
+ */
+#define RING_BUFFER_SPAN_PEEK   0x01U       /**< 仅查看，不移动读指针 */
+
 /**
  * @brief 操作接口结构体（策略模式）
  */
 typedef struct ring_buffer_ops {
     bool (*write)(ring_buffer_t *rb, uint8_t data);
     bool (*read)(ring_buffer_t *rb, uint8_t *data);
-    uint16_t (*write_multi)(ring_buffer_t *rb, const uint8_t *data, uint16_t len);
-    uint16_t (*read_multi)(ring_buffer_t *rb, uint8_t *data, uint16_t len);
-    uint16_t (*available)(const ring_buffer_t *rb);
-    uint16_t (*free_space)(const ring_buffer_t *rb);
+    ring_buffer_size_t (*write_multi)(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len);
+    ring_buffer_size_t (*read_multi)(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len);
+    ring_buffer_size_t (*available)(const ring_buffer_t *rb);
+    ring_buffer_size_t (*free_space)(const ring_buffer_t *rb);
     bool (*is_empty)(const ring_buffer_t *rb);
     bool (*is_full)(const ring_buffer_t *rb);
     void (*clear)(ring_buffer_t *rb);
+    ring_buffer_size_t (*read_span)(ring_buffer_t *rb, ring_buffer_size_t len,
+                                    ring_buffer_span_fn_t fn, void *ctx, uint8_t flags);
+    ring_buffer_size_t (*write_span)(ring_buffer_t *rb, ring_buffer_size_t len,
+                                     ring_buffer_span_fn_t fn, void *ctx, uint8_t flags);
+    void (*flush)(ring_buffer_t *rb, uint8_t flags);
 } ring_buffer_ops_t;
 
 /* Exported functions --------------------------------------------------------*/
@@ -93,7 +174,7 @@ typedef struct ring_buffer_ops {
 bool ring_buffer_create(
     ring_buffer_t *rb,
     uint8_t *buffer,
-    uint16_t size,
+    ring_buffer_size_t size,
     ring_buffer_type_t type
 );
 
@@ -148,7 +229,7 @@ bool ring_buffer_read(ring_buffer_t *rb, uint8_t *data);
  * - 返回值 < len 表示缓冲区空间不足，部分数据已写入
  * - 如需原子性写入，调用前先检查 ring_buffer_free_space()
  */
-uint16_t ring_buffer_write_multi(ring_buffer_t *rb, const uint8_t *data, uint16_t len);
+ring_buffer_size_t ring_buffer_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len);
 
 /**
  * @brief 批量读取数据
@@ -158,21 +239,21 @@ uint16_t ring_buffer_write_multi(ring_buffer_t *rb, const uint8_t *data, uint16_
  * @return 实际读取的字节数（0 表示参数错误或缓冲区为空）
  * @note 返回值 < len 表示缓冲区数据不足，已读取所有可用数据
  */
-uint16_t ring_buffer_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t len);
+ring_buffer_size_t ring_buffer_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len);
 
 /**
  * @brief 查询可读数据量
  * @param rb 缓冲区指针
  * @return 可读字节数（参数错误返回 0）
  */
-uint16_t ring_buffer_available(const ring_buffer_t *rb);
+ring_buffer_size_t ring_buffer_available(const ring_buffer_t *rb);
 
 /**
  * @brief 查询剩余空间
  * @param rb 缓冲区指针
  * @return 剩余可写字节数（参数错误返回 0）
  */
-uint16_t ring_buffer_free_space(const ring_buffer_t *rb);
+ring_buffer_size_t ring_buffer_free_space(const ring_buffer_t *rb);
 
 /**
  * @brief 判断缓冲区是否为空
@@ -195,6 +276,1349 @@ bool ring_buffer_is_full(const ring_buffer_t *rb);
  */
 void ring_buffer_clear(ring_buffer_t *rb);
 
+/* ============================= 批量发布 API ============================== */
+
+/**
+ * @brief 立即发布累积的读/写指针
+ * @param rb    缓冲区指针
+ * @param flags RING_BUFFER_FLUSH_WRITE（生产者调用）和/或 RING_BUFFER_FLUSH_READ（消费者调用）
+ * @note
+ * - 仅批量发布模式需要，其他策略每次操作都立即发布，调用无副作用
+ * - 生产者在一批消息末尾（或空闲时）调用，避免数据滞留
+ */
+void ring_buffer_flush(ring_buffer_t *rb, uint8_t flags);
+
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+/**
+ * @brief 给定容量下允许的最大发布阈值（容量的 1/4，至少 1 字节）
+ */
+#define RING_BUFFER_BATCH_LIMIT(size)         ((size) / 4U > 0U ? (size) / 4U : 1U)
+
+/**
+ * @brief 将发布阈值限制在 RING_BUFFER_BATCH_LIMIT 以内
+ */
+#define RING_BUFFER_BATCH_CLAMP(bytes, size)  ((bytes) < RING_BUFFER_BATCH_LIMIT(size) ? \
+                                               (bytes) : RING_BUFFER_BATCH_LIMIT(size))
+
+/**
+ * @brief 调整批量发布参数（吞吐与延迟的折中）
+ * @param rb        以 RING_BUFFER_TYPE_LOCKFREE_BATCH 创建的缓冲区
+ * @param bytes     累积多少字节后发布（>= 1，1 = 每次操作都发布；超过 RING_BUFFER_BATCH_LIMIT 时截断）
+ * @param max_delay 未发布数据的最长滞留时间（RING_BUFFER_BATCH_TICKS 单位，0 = 不限）
+ * @return true=成功, false=参数错误或策略不匹配
+ * @note
+ * - 应在生产者/消费者开始访问前调用
+ * - 滞留时间仅在下一次读写操作时检查，长时间无操作时需调用 ring_buffer_flush()
+ * - 写满或读空时（含恰好写满/读空）总是立即发布，轮询 is_full/is_empty 不会死锁
+ */
+bool ring_buffer_set_batch(ring_buffer_t *rb, ring_buffer_size_t bytes, uint32_t max_delay);
+#endif
+
+/* ========================== 零拷贝访问与查找 API ========================== */
+
+/**
+ * @brief 以数据段形式访问可读数据（零拷贝）
+ * @param rb    缓冲区指针
+ * @param len   最多访问的字节数
+ * @param fn    数据段回调，返回已处理的字节数
+ * @param ctx   回调上下文
+ * @param flags RING_BUFFER_SPAN_PEEK=仅查看；0=按回调返回值移动读指针
+ * @return 回调处理的字节数（0 表示参数错误、缓冲区为空或回调未处理数据）
+ * @note 回调最多被调用一次，数据环绕时一次收到两个数据段
+ */
+ring_buffer_size_t ring_buffer_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                         ring_buffer_span_fn_t fn, void *ctx, uint8_t flags);
+
+/**
+ * @brief 以数据段形式直接填充空闲空间（零拷贝）
+ * @param rb    缓冲区指针
+ * @param len   最多写入的字节数
+ * @param fn    数据段回调，向空闲段写入数据并返回已写入的字节数
+ * @param ctx   回调上下文
+ * @param flags 保留，传 0
+ * @return 回调写入的字节数（写指针按此前移）
+ * @note 回调最多被调用一次，空闲空间环绕时一次收到两个数据段
+ */
+ring_buffer_size_t ring_buffer_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                          ring_buffer_span_fn_t fn, void *ctx, uint8_t flags);
+
+/**
+ * @brief 随机位置预读（不移除数据）
+ * @param rb     缓冲区指针
+ * @param offset 相对读指针的偏移（字节）
+ * @param data   读取数据存放地址
+ * @param len    期望读取的字节数
+ * @return 实际复制的字节数（可读数据不足 offset + len 时 < len）
+ */
+ring_buffer_size_t ring_buffer_peek_at(ring_buffer_t *rb, ring_buffer_size_t offset, uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 查找指定字节（不移除数据）
+ * @param rb   缓冲区指针
+ * @param byte 待查找的字节
+ * @param pos  找到时存放相对读指针的偏移
+ * @return true=找到, false=未找到或参数错误
+ * @note 直接扫描缓冲区内的一或两个数据段，不做额外拷贝
+ */
+bool ring_buffer_find(ring_buffer_t *rb, uint8_t byte, ring_buffer_size_t *pos);
+
+/**
+ * @brief 查找字节集合中任意一个字节首次出现的位置（不移除数据）
+ * @param rb      缓冲区指针
+ * @param set     字节集合
+ * @param set_len 集合大小（>= 1）
+ * @param pos     找到时存放相对读指针的偏移
+ * @return true=找到, false=未找到或参数错误
+ * @note 在 SSE2/AVX2/NEON 平台上使用向量指令比较，集合越小越快
+ */
+bool ring_buffer_find_any(ring_buffer_t *rb, const uint8_t *set, uint8_t set_len, ring_buffer_size_t *pos);
+
+/**
+ * @brief 读取直到分隔符（含分隔符）
+ * @param rb    缓冲区指针
+ * @param delim 分隔符
+ * @param data  读取数据存放地址
+ * @param len   data 容量（字节）
+ * @return 实际读取的字节数（含分隔符）
+ * @note 
+ * - 未找到分隔符或整帧超过 len 时返回 0，不移除任何数据
+ * - 缓冲区已满且仍无分隔符时，调用者应自行丢弃数据以免阻塞
+ */
+ring_buffer_size_t ring_buffer_read_until(ring_buffer_t *rb, uint8_t delim, uint8_t *data, ring_buffer_size_t len);
+
+/* ============================== 大块拷贝引擎 ============================== */
+
+#if RING_BUFFER_ENABLE_COPY_ENGINE
+
+/**
+ * @brief 拷贝数据进入缓冲区（超过阈值时使用流式存储，不污染生产者缓存）
+ * @param dst 缓冲区内目标地址
+ * @param src 源地址
+ * @param len 字节数
+ * @note 返回前已执行存储屏障，调用者可直接发布写指针
+ */
+void ring_buffer_copy_in(void *dst, const void *src, ring_buffer_size_t len);
+
+/**
+ * @brief 从缓冲区拷贝数据（超过阈值时提前预取源数据）
+ * @param dst 目标地址
+ * @param src 缓冲区内源地址
+ * @param len 字节数
+ */
+void ring_buffer_copy_out(void *dst, const void *src, ring_buffer_size_t len);
+
+/**
+ * @brief 运行时调整拷贝引擎阈值（用于基准标定）
+ * @param nt_threshold       流式存储阈值（RING_BUFFER_SIZE_MAX 表示禁用）
+ * @param prefetch_threshold 预取阈值（RING_BUFFER_SIZE_MAX 表示禁用）
+ */
+void ring_buffer_copy_set_threshold(ring_buffer_size_t nt_threshold,
+                                    ring_buffer_size_t prefetch_threshold);
+
+/**
+ * @brief 查询运行时选中的流式拷贝内核
+ * @return 内核名称（"avx512"/"avx2"/"sse2"/"memcpy"）
+ */
+const char *ring_buffer_copy_kernel_name(void);
+
+#define RB_COPY_IN(dst, src, len)   ring_buffer_copy_in((dst), (src), (len))
+#define RB_COPY_OUT(dst, src, len)  ring_buffer_copy_out((dst), (src), (len))
+
+#else
+
+#define RB_COPY_IN(dst, src, len)   memcpy((dst), (src), (len))
+#define RB_COPY_OUT(dst, src, len)  memcpy((dst), (src), (len))
+
+#endif /* RING_BUFFER_ENABLE_COPY_ENGINE */
+
+/* ============================ 融合变换读写 API ============================ */
+
+/**
+ * @brief 计算 CRC32C（Castagnoli），可分段累加
+ * @param crc  上一段的结果（首段传 0）
+ * @param data 数据指针
+ * @param len  字节数
+ * @return 累加后的 CRC32C
+ */
+uint32_t ring_buffer_crc32c(uint32_t crc, const uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 批量写入并同时累加 CRC32C
+ * @param rb   缓冲区指针
+ * @param data 待写入的数据指针
+ * @param len  待写入的字节数
+ * @param crc  CRC 累加值（输入上一段结果，首段为 0；输出覆盖实际写入部分）
+ * @return 实际写入的字节数
+ * @note 拷贝与校验在同一遍历中完成，SSE4.2/ARMv8 CRC 指令可用时自动使用
+ */
+ring_buffer_size_t ring_buffer_write_multi_crc32c(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len, uint32_t *crc);
+
+/**
+ * @brief 批量读取并同时累加 CRC32C
+ * @param rb   缓冲区指针
+ * @param data 读取数据存放地址
+ * @param len  期望读取的字节数
+ * @param crc  CRC 累加值（输入上一段结果，首段为 0；输出覆盖实际读取部分）
+ * @return 实际读取的字节数
+ */
+ring_buffer_size_t ring_buffer_read_multi_crc32c(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len, uint32_t *crc);
+
+/**
+ * @brief 按字宽字节序翻转后写入
+ * @param rb    缓冲区指针
+ * @param data  待写入的数据指针
+ * @param len   待写入的字节数
+ * @param width 字宽（2/4/8）
+ * @return 实际写入的字节数（总是 width 的整数倍）
+ * @note 空间不足时只写入完整的字，不会拆分半个字
+ */
+ring_buffer_size_t ring_buffer_write_multi_bswap(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len, uint8_t width);
+
+/**
+ * @brief 读取并按字宽翻转字节序
+ * @param rb    缓冲区指针
+ * @param data  读取数据存放地址
+ * @param len   期望读取的字节数
+ * @param width 字宽（2/4/8）
+ * @return 实际读取的字节数（总是 width 的整数倍）
+ */
+ring_buffer_size_t ring_buffer_read_multi_bswap(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len, uint8_t width);
+
+/**
+ * @brief 读取 int16 采样并转换为 float
+ * @param rb    缓冲区指针（存放本机字节序的 int16 采样）
+ * @param data  输出采样地址
+ * @param count 期望读取的采样数
+ * @param scale 缩放系数（如 1.0f / 32768 归一化）
+ * @return 实际读取的采样数
+ */
+ring_buffer_size_t ring_buffer_read_s16_to_f32(ring_buffer_t *rb, float *data, ring_buffer_size_t count, float scale);
+
+/* ============================ 分散/聚集读写 API =========================== */
+
+/**
+ * @brief 聚集写入：多个数据块作为一条消息整体写入
+ * @param rb  缓冲区指针
+ * @param iov 数据块数组
+ * @param cnt 数据块个数
+ * @return 写入的总字节数（空间不足时返回 0，不写入任何数据）
+ * @note
+ * - 只预留一次空间、只发布一次写指针，消费者不会看到半条消息
+ * - 典型用法：帧头 + 负载 + 帧尾分别存放时一次写入
+ */
+ring_buffer_size_t ring_buffer_writev(ring_buffer_t *rb, const ring_buffer_iovec_t *iov, uint8_t cnt);
+
+/**
+ * @brief 分散读取：按顺序填满多个数据块
+ * @param rb  缓冲区指针
+ * @param iov 数据块数组
+ * @param cnt 数据块个数
+ * @return 读取的总字节数（数据不足时 < 各块长度之和）
+ * @note 直接从缓冲区复制到调用者的数据块，无中间缓冲
+ */
+ring_buffer_size_t ring_buffer_readv(ring_buffer_t *rb, const ring_buffer_iovec_t *iov, uint8_t cnt);
+
+/**
+ * @brief 缓冲区间直接搬运数据（不经过中间缓冲）
+ * @param dst 目标缓冲区
+ * @param src 源缓冲区（不得与 dst 相同）
+ * @param max 最多搬运的字节数
+ * @return 搬运的字节数（受源数据量与目标空闲空间限制）
+ * @note
+ * - 在源数据段与目标空闲段之间拷贝一次，代替 read_multi + write_multi 的两次拷贝
+ * - 两个缓冲区各按自己的策略保证线程安全：拷贝期间同时处于两者的临界区内，
+ *   临界区按缓冲区地址顺序嵌套，反向搬运的线程之间不会死锁
+ * - 调用者同时担任 src 的消费者与 dst 的生产者
+ */
+ring_buffer_size_t ring_buffer_transfer(ring_buffer_t *dst, ring_buffer_t *src, ring_buffer_size_t max);
+
+#if RING_BUFFER_ENABLE_FD_IO
+/**
+ * @brief 从文件描述符直接读入缓冲区空闲空间
+ * @param rb  缓冲区指针
+ * @param fd  文件描述符（文件、管道、套接字、串口等）
+ * @param max 最多读取的字节数
+ * @return 读入的字节数；0=对端关闭或缓冲区已满；-1=出错（errno 保留，非阻塞时可能为 EAGAIN）
+ * @note 对一或两个空闲段发起一次 readv()，省去用户态中转缓冲
+ */
+int32_t ring_buffer_fill_from_fd(ring_buffer_t *rb, int fd, ring_buffer_size_t max);
+
+/**
+ * @brief 将可读数据直接写出到文件描述符
+ * @param rb  缓冲区指针
+ * @param fd  文件描述符
+ * @param max 最多写出的字节数
+ * @return 写出的字节数；0=缓冲区为空；-1=出错（errno 保留）
+ * @note 对一或两个数据段发起一次 writev()，读指针按实际写出量前移
+ */
+int32_t ring_buffer_drain_to_fd(ring_buffer_t *rb, int fd, ring_buffer_size_t max);
+#endif
+
+/* ============================== 异步写出引擎 ============================== */
+
+#if RING_BUFFER_ENABLE_AIO
+/**
+ * @brief 异步写出后端
+ */
+typedef enum {
+    RING_BUFFER_AIO_AUTO = 0,        /**< 优先 io_uring，不可用时使用线程池 */
+    RING_BUFFER_AIO_URING,           /**< 仅 io_uring */
+    RING_BUFFER_AIO_THREAD,          /**< 仅线程池 pwrite/write */
+} ring_buffer_aio_backend_t;
+
+/**
+ * @brief 异步写出引擎（作为缓冲区的唯一消费者）
+ */
+typedef struct {
+    ring_buffer_t *rb;                      /**< 数据来源 */
+    int fd;                                 /**< 目标文件描述符 */
+    int64_t offset;                         /**< 下一次写入的文件偏移（-1 = 管道/流）*/
+    ring_buffer_size_t inflight;            /**< 已提交未完成的字节数 */
+    ring_buffer_aio_backend_t backend;      /**< 实际使用的后端 */
+    int error;                              /**< 首个错误的 errno（0 = 无错误）*/
+    void *impl;                             /**< 后端私有数据 */
+} ring_buffer_aio_t;
+
+/**
+ * @brief 初始化异步写出引擎
+ * @param aio     引擎控制结构（用户分配）
+ * @param rb      数据来源缓冲区（任意策略）
+ * @param fd      目标文件描述符
+ * @param offset  文件起始偏移；-1 表示管道/套接字等流式 fd（按顺序逐个写出）
+ * @param backend 后端选择
+ * @return true=成功, false=参数错误或后端不可用
+ * @note 引擎取代应用成为消费者：数据写出完成后才移动读指针，在途数据不会被生产者覆盖
+ */
+bool ring_buffer_aio_init(ring_buffer_aio_t *aio, ring_buffer_t *rb, int fd, int64_t offset,
+                          ring_buffer_aio_backend_t backend);
+
+/**
+ * @brief 提交新数据并回收已完成的写请求（由提交线程循环调用）
+ * @param aio  引擎指针
+ * @param wait true=有在途请求时至少等待一个完成
+ * @return 本次完成（读指针前移）的字节数；-1=写出出错（见 aio->error）
+ * @note 文件目标最多 RING_BUFFER_AIO_DEPTH 个请求同时在途；流式目标一次一个以保证顺序
+ */
+int32_t ring_buffer_aio_poll(ring_buffer_aio_t *aio, bool wait);
+
+/**
+ * @brief 写出缓冲区中的全部数据并等待完成
+ * @param aio 引擎指针
+ * @return true=成功, false=写出出错
+ */
+bool ring_buffer_aio_drain(ring_buffer_aio_t *aio);
+
+/**
+ * @brief 等待在途请求完成并释放后端资源（不写出剩余数据）
+ * @param aio 引擎指针
+ */
+void ring_buffer_aio_deinit(ring_buffer_aio_t *aio);
+
+/**
+ * @brief 查询实际使用的后端名称（"io_uring" / "thread"）
+ */
+const char *ring_buffer_aio_backend_name(const ring_buffer_aio_t *aio);
+#endif
+
+/* ============================== 持久化缓冲区 ============================== */
+
+#if RING_BUFFER_ENABLE_PERSIST
+/**
+ * @brief 文件映射持久化缓冲区
+ * @note rb 为首成员，&pr.rb 可直接传给所有缓冲区 API
+ */
+typedef struct {
+    ring_buffer_t rb;                       /**< 缓冲区（数据区位于映射文件中）*/
+    void *map;                              /**< 文件映射起始地址（控制块）*/
+    size_t map_len;                         /**< 映射长度 */
+    int fd;                                 /**< 映射文件描述符 */
+    uint32_t sync_bytes;                    /**< msync 批量阈值（0 = 仅 flush 时同步）*/
+    uint32_t dirty;                         /**< 上次同步后写入的字节数 */
+} ring_buffer_persist_t;
+
+/**
+ * @brief 打开（或创建）文件映射持久化缓冲区
+ * @param pr         持久化缓冲区（用户分配）
+ * @param path       映射文件路径，不存在时创建
+ * @param size       数据区大小，须与文件创建时一致
+ * @param sync_bytes 每写入多少字节执行一次 msync（0 = 仅 ring_buffer_flush 时同步）
+ * @return true=成功（已存在的文件会恢复上次提交的数据）, false=失败
+ * @note 底层为无锁策略，仅支持单生产者单消费者
+ * @note 进程崩溃不丢失已提交数据；掉电时最多丢失最近 sync_bytes 字节
+ */
+bool ring_buffer_persist_open(ring_buffer_persist_t *pr, const char *path,
+                              ring_buffer_size_t size, uint32_t sync_bytes);
+
+/**
+ * @brief 同步并关闭持久化缓冲区（文件保留，可再次打开）
+ * @param pr 持久化缓冲区
+ */
+void ring_buffer_persist_close(ring_buffer_persist_t *pr);
+#endif
+
+/* =============================== 分段队列 ================================ */
+
+#if RING_BUFFER_ENABLE_SEGQ
+typedef struct ring_buffer_seg ring_buffer_seg_t;
+
+/**
+ * @brief 分段队列（单生产者单消费者，容量按需增长）
+ */
+typedef struct {
+    ring_buffer_seg_t *write_seg;           /**< 生产者当前段 */
+    ring_buffer_seg_t *read_seg;            /**< 消费者当前段（消费者发布）*/
+    ring_buffer_seg_t *reclaim;             /**< 最早未回收的段（生产者私有）*/
+    ring_buffer_seg_t *free_list;           /**< 空闲段链表（生产者私有）*/
+    ring_buffer_size_t seg_size;            /**< 每段容量（字节）*/
+    uint32_t max_segs;                      /**< 段数上限（0 = 不限）*/
+    uint32_t seg_count;                     /**< 已分配段数 */
+} ring_buffer_segq_t;
+
+/**
+ * @brief 初始化分段队列（立即分配第一个段）
+ * @param q        队列控制结构（用户分配）
+ * @param seg_size 每段容量
+ * @param max_segs 段数上限，即内存上限约为 max_segs * seg_size（0 = 不限）
+ * @return true=成功, false=参数错误或内存不足
+ */
+bool ring_buffer_segq_init(ring_buffer_segq_t *q, ring_buffer_size_t seg_size, uint32_t max_segs);
+
+/**
+ * @brief 释放全部段（生产者与消费者均已停止后调用）
+ */
+void ring_buffer_segq_deinit(ring_buffer_segq_t *q);
+
+/**
+ * @brief 写入数据（仅生产者调用），当前段写满时链接新段
+ * @return 实际写入的字节数，小于 len 表示已达段数上限
+ */
+ring_buffer_size_t ring_buffer_segq_write(ring_buffer_segq_t *q, const uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 读取数据（仅消费者调用），当前段读空后跟随链接
+ * @return 实际读取的字节数
+ */
+ring_buffer_size_t ring_buffer_segq_read(ring_buffer_segq_t *q, uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 查询可读字节数（仅消费者调用，超过长度类型上限时截断）
+ */
+ring_buffer_size_t ring_buffer_segq_available(ring_buffer_segq_t *q);
+#endif
+
+/* ================================ 缓冲区池 ================================ */
+
+#if RING_BUFFER_ENABLE_POOL
+/**
+ * @brief 按缓存行向上对齐
+ */
+#define RB_POOL_ALIGN(x)  (((size_t)(x) + RING_BUFFER_CACHE_LINE - 1U) & ~(size_t)(RING_BUFFER_CACHE_LINE - 1U))
+
+/**
+ * @brief 单个槽位大小（控制块 + 存储区），用于计算静态 arena 大小
+ * @note 静态 arena 需额外预留 RING_BUFFER_CACHE_LINE 字节用于起始对齐
+ */
+#define RING_BUFFER_POOL_SLOT_SIZE(ring_size)  (RB_POOL_ALIGN(sizeof(ring_buffer_t)) + RB_POOL_ALIGN(ring_size))
+
+#define RING_BUFFER_POOL_HUGEPAGE  0x01U   /**< 优先使用大页（MAP_HUGETLB，失败时 MADV_HUGEPAGE）*/
+
+/**
+ * @brief 缓冲区池
+ */
+typedef struct {
+    uint8_t *arena;                         /**< 对齐后的 arena 起始地址 */
+    void *map;                              /**< mmap 起始地址（用户 arena 为 NULL）*/
+    size_t map_len;                         /**< mmap 长度 */
+    uint32_t stride;                        /**< 槽位大小 */
+    uint32_t capacity;                      /**< 槽位总数 */
+    uint32_t used;                          /**< 已分配槽位数 */
+    uint32_t free_head;                     /**< 空闲链表头 */
+    ring_buffer_size_t ring_size;           /**< 每个缓冲区的容量 */
+    ring_buffer_type_t type;                /**< 缓冲区策略 */
+    bool huge;                              /**< 是否由大页承载 */
+} ring_buffer_pool_t;
+
+/**
+ * @brief 在用户提供的内存上初始化缓冲区池
+ * @param pool      池控制结构（用户分配）
+ * @param mem       arena 内存（如静态数组），起始地址自动对齐到缓存行
+ * @param mem_len   arena 长度，槽位数 = (mem_len - 对齐填充) / RING_BUFFER_POOL_SLOT_SIZE(ring_size)
+ * @param ring_size 每个缓冲区的容量
+ * @param type      缓冲区策略
+ * @return true=成功, false=参数错误或 arena 不足一个槽位
+ */
+bool ring_buffer_pool_init(ring_buffer_pool_t *pool, void *mem, size_t mem_len,
+                           ring_buffer_size_t ring_size, ring_buffer_type_t type);
+
+#if defined(__unix__) || defined(__APPLE__)
+/**
+ * @brief 使用 mmap 分配 arena 并初始化缓冲区池（主机端）
+ * @param pool      池控制结构（用户分配）
+ * @param count     缓冲区数量
+ * @param ring_size 每个缓冲区的容量
+ * @param type      缓冲区策略
+ * @param flags     RING_BUFFER_POOL_HUGEPAGE 或 0
+ * @return true=成功, false=参数错误或内存不足
+ * @note 大页不可用时自动退化为普通页，实际结果见 pool->huge
+ */
+bool ring_buffer_pool_create(ring_buffer_pool_t *pool, uint32_t count,
+                             ring_buffer_size_t ring_size, ring_buffer_type_t type, uint8_t flags);
+#endif
+
+/**
+ * @brief 释放缓冲区池（mmap 分配的 arena 同时解除映射）
+ */
+void ring_buffer_pool_deinit(ring_buffer_pool_t *pool);
+
+/**
+ * @brief 从池中分配一个缓冲区，O(1)
+ * @return 已按池配置创建的缓冲区，池耗尽时返回 NULL
+ */
+ring_buffer_t *ring_buffer_pool_alloc(ring_buffer_pool_t *pool);
+
+/**
+ * @brief 将缓冲区归还池中，O(1)
+ * @return true=成功, false=不属于本池或重复释放
+ */
+bool ring_buffer_pool_free(ring_buffer_pool_t *pool, ring_buffer_t *rb);
+#endif
+
+/* ============================= 多优先级通道 ============================== */
+
+#if RING_BUFFER_ENABLE_PRIO
+#define RING_BUFFER_PRIO_MAX_LANES  8       /**< 最大通道数（位图宽度）*/
+
+/**
+ * @brief 通道选择方式
+ */
+typedef enum {
+    RING_BUFFER_PRIO_STRICT = 0,     /**< 严格优先级：总是服务编号最小的非空通道 */
+    RING_BUFFER_PRIO_WEIGHTED,       /**< 加权轮询：每个通道连续服务 weight 次读取 */
+} ring_buffer_prio_mode_t;
+
+/**
+ * @brief 通道配置
+ */
+typedef struct {
+    uint8_t *buffer;                        /**< 通道存储区 */
+    ring_buffer_size_t size;                /**< 通道容量 */
+    uint8_t weight;                         /**< 加权轮询权重（0 视为 1，严格模式忽略）*/
+} ring_buffer_prio_lane_t;
+
+/**
+ * @brief 多优先级通道缓冲区（通道 0 优先级最高）
+ */
+typedef struct {
+    ring_buffer_t lanes[RING_BUFFER_PRIO_MAX_LANES];  /**< 各通道缓冲区 */
+    volatile uint8_t nonempty;              /**< 非空通道位图 */
+    uint8_t lane_count;                     /**< 通道数 */
+    ring_buffer_prio_mode_t mode;           /**< 选择方式 */
+    uint8_t weight[RING_BUFFER_PRIO_MAX_LANES];  /**< 各通道权重 */
+    uint8_t cursor;                         /**< 加权轮询当前通道（消费者私有）*/
+    uint8_t credit;                         /**< 当前通道剩余服务次数（消费者私有）*/
+} ring_buffer_prio_t;
+
+/**
+ * @brief 创建多优先级通道缓冲区
+ * @param p          控制结构（用户分配）
+ * @param lanes      通道配置数组，下标即优先级（0 最高）
+ * @param lane_count 通道数（2~8）
+ * @param type       各通道使用的策略
+ * @param mode       选择方式
+ * @return true=成功, false=参数错误或通道创建失败
+ */
+bool ring_buffer_prio_create(ring_buffer_prio_t *p, const ring_buffer_prio_lane_t *lanes,
+                             uint8_t lane_count, ring_buffer_type_t type, ring_buffer_prio_mode_t mode);
+
+/**
+ * @brief 销毁多优先级通道缓冲区
+ */
+void ring_buffer_prio_destroy(ring_buffer_prio_t *p);
+
+/**
+ * @brief 写入指定通道并置位非空位图
+ * @return 实际写入的字节数
+ */
+ring_buffer_size_t ring_buffer_prio_write(ring_buffer_prio_t *p, uint8_t lane,
+                                          const uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 从选中的通道读取数据（仅消费者调用）
+ * @param p    控制结构
+ * @param data 目标地址
+ * @param len  最大读取长度
+ * @param lane 输出：数据所属通道（可为 NULL）
+ * @return 实际读取的字节数，0 表示所有通道为空
+ */
+ring_buffer_size_t ring_buffer_prio_read(ring_buffer_prio_t *p, uint8_t *data,
+                                         ring_buffer_size_t len, uint8_t *lane);
+
+/**
+ * @brief 查询非空通道位图（bit i = 通道 i 有数据）
+ */
+static inline uint8_t ring_buffer_prio_pending(const ring_buffer_prio_t *p)
+{
+    return (p ? RB_LOAD_ACQUIRE(&p->nonempty) : 0U);
+}
+#endif
+
+/* =============================== 缓冲区集合 =============================== */
+
+#if RING_BUFFER_ENABLE_SET
+#define RING_BUFFER_SET_WAIT_FOREVER  UINT32_MAX    /**< 无限等待 */
+
+/**
+ * @brief 缓冲区集合（一个消费者等待多个缓冲区）
+ */
+typedef struct {
+    ring_buffer_t *rings[RING_BUFFER_SET_MAX_RINGS];           /**< 成员缓冲区 */
+    volatile uint32_t ready[RING_BUFFER_SET_MAX_RINGS / 32];   /**< 就绪位图 */
+    volatile uint32_t seq;                  /**< 就绪通知序号（futex 字）*/
+    volatile uint32_t waiters;              /**< 等待中的消费者数 */
+    uint16_t count;                         /**< 成员数量 */
+    uint16_t cursor;                        /**< 轮询起点（消费者私有）*/
+} ring_buffer_set_t;
+
+/**
+ * @brief 初始化空集合
+ */
+bool ring_buffer_set_init(ring_buffer_set_t *set);
+
+/**
+ * @brief 加入缓冲区（在生产者/消费者开始工作前调用）
+ * @return 成员编号，集合已满返回 -1
+ */
+int32_t ring_buffer_set_add(ring_buffer_set_t *set, ring_buffer_t *rb);
+
+/**
+ * @brief 写入成员缓冲区并通知消费者（生产者调用）
+ * @return 实际写入的字节数
+ */
+ring_buffer_size_t ring_buffer_set_write(ring_buffer_set_t *set, uint16_t idx,
+                                         const uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 标记成员缓冲区就绪（用其他 API 直接写入成员后调用）
+ * @note 位已置位时只有一次加载，不写共享位图
+ */
+void ring_buffer_set_notify(ring_buffer_set_t *set, uint16_t idx);
+
+/**
+ * @brief 按轮询顺序取出下一个就绪成员（仅消费者调用）
+ * @param set        集合
+ * @param timeout_ms 无就绪成员时最长等待时间；0=不等待，RING_BUFFER_SET_WAIT_FOREVER=无限等待
+ * @return 成员编号（其就绪位已清除），超时返回 -1
+ * @note 读取后未读完的成员需调用 ring_buffer_set_done() 重新标记
+ */
+int32_t ring_buffer_set_next(ring_buffer_set_t *set, uint32_t timeout_ms);
+
+/**
+ * @brief 处理完成员后调用，仍有数据时重新标记就绪（仅消费者调用）
+ */
+void ring_buffer_set_done(ring_buffer_set_t *set, uint16_t idx);
+#endif
+
+/* ============================ 工作窃取双端队列 ============================ */
+
+#if RING_BUFFER_ENABLE_DEQUE
+/**
+ * @brief 窃取结果
+ */
+typedef enum {
+    RING_BUFFER_STEAL_EMPTY = 0,     /**< 队列为空 */
+    RING_BUFFER_STEAL_OK,            /**< 窃取成功 */
+    RING_BUFFER_STEAL_RETRY,         /**< 与其他线程竞争失败，可重试或换一个队列 */
+} ring_buffer_steal_t;
+
+/**
+ * @brief Chase-Lev 工作窃取双端队列（元素为任务指针）
+ */
+typedef struct {
+    void **slots;                           /**< 元素数组（指向用户存储区）*/
+    uintptr_t mask;                         /**< 容量 - 1 */
+    volatile uintptr_t top;                 /**< 窃取端（窃取者 CAS 竞争）*/
+    volatile uintptr_t bottom;              /**< 所有者端（仅所有者修改）*/
+} ring_buffer_deque_t;
+
+/**
+ * @brief 创建工作窃取双端队列
+ * @param dq     队列控制结构（用户分配）
+ * @param buffer 存储区，需按指针对齐
+ * @param size   存储区大小（字节），size / sizeof(void *) 必须是 2 的幂
+ * @return true=成功, false=参数错误
+ */
+bool ring_buffer_deque_create(ring_buffer_deque_t *dq, uint8_t *buffer, uint32_t size);
+
+/**
+ * @brief 压入任务（仅所有者线程调用）
+ * @return true=成功, false=队列已满（不扩容）
+ */
+bool ring_buffer_deque_push(ring_buffer_deque_t *dq, void *task);
+
+/**
+ * @brief 弹出最近压入的任务，LIFO（仅所有者线程调用）
+ * @return true=成功, false=队列为空或最后一个任务已被窃取
+ */
+bool ring_buffer_deque_pop(ring_buffer_deque_t *dq, void **task);
+
+/**
+ * @brief 窃取最早压入的任务，FIFO（任意线程调用）
+ * @return 窃取结果，仅 RING_BUFFER_STEAL_OK 时 *task 有效
+ */
+ring_buffer_steal_t ring_buffer_deque_steal(ring_buffer_deque_t *dq, void **task);
+
+/**
+ * @brief 查询任务数（并发访问时仅为近似值）
+ */
+uint32_t ring_buffer_deque_size(const ring_buffer_deque_t *dq);
+#endif
+
+/* ============================ 分片多生产者通道 ============================ */
+
+#if RING_BUFFER_ENABLE_MPSC
+/**
+ * @brief 生产者通道（独占缓存行，相邻通道的控制块互不干扰）
+ */
+typedef struct RB_CACHE_ALIGNED {
+    ring_buffer_t rb;                       /**< 通道缓冲区（无锁策略，单生产者单消费者）*/
+} ring_buffer_mpsc_lane_t;
+
+/**
+ * @brief 分片多生产者单消费者缓冲区
+ */
+typedef struct {
+    ring_buffer_mpsc_lane_t lanes[RING_BUFFER_MPSC_MAX_LANES]; /**< 每个生产者一条通道 */
+    volatile uint32_t registered;           /**< 已注册生产者数（注册时递增）*/
+    uint8_t max_lanes;                      /**< 通道数 */
+    volatile uint32_t hint RB_CACHE_ALIGNED; /**< 非空提示位图（通道由空变非空时置位）*/
+    uint8_t cursor;                         /**< 轮询位置（仅消费者）*/
+} ring_buffer_mpsc_t;
+
+/**
+ * @brief 初始化分片多生产者缓冲区
+ * @param m         控制结构（用户分配，建议静态或按缓存行对齐分配）
+ * @param storage   存储区，大小为 lane_size * max_lanes
+ * @param lane_size 每条通道容量（字节），建议为缓存行的整数倍
+ * @param max_lanes 通道数（1 ~ RING_BUFFER_MPSC_MAX_LANES）
+ * @return true=成功, false=参数错误
+ */
+bool ring_buffer_mpsc_init(ring_buffer_mpsc_t *m, uint8_t *storage,
+                           ring_buffer_size_t lane_size, uint8_t max_lanes);
+
+/**
+ * @brief 释放全部通道
+ */
+void ring_buffer_mpsc_deinit(ring_buffer_mpsc_t *m);
+
+/**
+ * @brief 注册生产者（每个生产者线程调用一次）
+ * @return 通道编号，通道已用完返回 -1
+ */
+int32_t ring_buffer_mpsc_register(ring_buffer_mpsc_t *m);
+
+/**
+ * @brief 写入自己的通道（仅该通道的生产者调用）
+ * @return 实际写入字节数，通道满时可能小于 len
+ */
+ring_buffer_size_t ring_buffer_mpsc_write(ring_buffer_mpsc_t *m, uint8_t lane,
+                                          const uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 轮询读取（仅消费者调用）
+ * @param lane 输出本次数据所属通道（可为 NULL）
+ * @return 实际读取字节数，每次只从一条通道读取，全部为空返回 0
+ */
+ring_buffer_size_t ring_buffer_mpsc_read(ring_buffer_mpsc_t *m, uint8_t *data,
+                                         ring_buffer_size_t len, uint8_t *lane);
+
+/**
+ * @brief 查询全部通道的可读字节总数（并发访问时仅为近似值）
+ */
+uint32_t ring_buffer_mpsc_available(ring_buffer_mpsc_t *m);
+#endif
+
+/* ============================ 时间戳归并读取 ============================ */
+
+#if RING_BUFFER_ENABLE_MERGE
+/**
+ * @brief 记录头长度：[uint32_t 负载长度][uint64_t 时间戳]，本机字节序
+ */
+#define RING_BUFFER_MERGE_HDR_SIZE  12U
+
+/**
+ * @brief 归并读取标志
+ */
+#define RING_BUFFER_MERGE_FLUSH     0x01U   /**< 忽略乱序窗口，输出当前最早的记录（收尾时使用）*/
+
+/**
+ * @brief 归并输出的一条记录（零拷贝，负载直接指向缓冲区内部）
+ */
+typedef struct {
+    uint64_t ts;                            /**< 时间戳 */
+    ring_buffer_span_t spans[2];            /**< 负载数据段（环绕时为两段）*/
+    uint8_t count;                          /**< 数据段数量（0~2，空负载为 0）*/
+    uint32_t len;                           /**< 负载长度 */
+    uint8_t ring;                           /**< 来源缓冲区编号 */
+} ring_buffer_merge_rec_t;
+
+/**
+ * @brief 多缓冲区时间戳归并读取器（单消费者）
+ */
+typedef struct {
+    ring_buffer_t *rings[RING_BUFFER_MERGE_MAX_RINGS];       /**< 输入缓冲区 */
+    ring_buffer_merge_rec_t heads[RING_BUFFER_MERGE_MAX_RINGS]; /**< 各缓冲区的队首记录 */
+    uint8_t heap[RING_BUFFER_MERGE_MAX_RINGS];  /**< 按时间戳排列的小顶堆（缓冲区编号）*/
+    bool loaded[RING_BUFFER_MERGE_MAX_RINGS];   /**< 队首记录已载入堆中 */
+    uint8_t heap_len;                       /**< 堆中元素数（已载入队首的缓冲区数）*/
+    uint8_t count;                          /**< 缓冲区数 */
+    bool pending;                           /**< 已输出、尚未释放的记录 */
+    uint64_t window;                        /**< 乱序窗口（时间戳单位）*/
+    uint64_t max_seen;                      /**< 已见过的最大时间戳 */
+    uint64_t last_ts;                       /**< 上一条输出记录的时间戳 */
+    uint32_t late;                          /**< 超出窗口、晚于已输出记录到达的记录数 */
+} ring_buffer_merge_t;
+
+/**
+ * @brief 写入一条带时间戳的记录（记录头与负载一次发布）
+ * @return true=成功, false=空间不足或参数错误（不写入任何数据）
+ */
+bool ring_buffer_merge_put(ring_buffer_t *rb, uint64_t ts, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 初始化归并读取器
+ * @param window 乱序窗口：某些缓冲区暂无数据时，记录需比已见最大时间戳早 window 以上才输出
+ */
+bool ring_buffer_merge_init(ring_buffer_merge_t *m, uint64_t window);
+
+/**
+ * @brief 加入输入缓冲区（每个缓冲区内的记录需按时间戳递增写入）
+ * @return 缓冲区编号，已满返回 -1
+ */
+int32_t ring_buffer_merge_add(ring_buffer_merge_t *m, ring_buffer_t *rb);
+
+/**
+ * @brief 取出全局最早的记录（不移除，处理完后调用 ring_buffer_merge_release）
+ * @param flags RING_BUFFER_MERGE_FLUSH=忽略乱序窗口；0=正常
+ * @return true=rec 有效, false=暂无可安全输出的记录
+ */
+bool ring_buffer_merge_next(ring_buffer_merge_t *m, ring_buffer_merge_rec_t *rec, uint8_t flags);
+
+/**
+ * @brief 释放 ring_buffer_merge_next 输出的记录（移动对应缓冲区的读指针）
+ */
+void ring_buffer_merge_release(ring_buffer_merge_t *m);
+#endif
+
+/* ============================ 压缩记录模式 ============================ */
+
+#if RING_BUFFER_ENABLE_LZ
+/**
+ * @brief 压缩记录头长度：[uint16_t 存储长度][uint16_t 原始长度]，存储长度等于原始长度表示未压缩
+ */
+#define RING_BUFFER_LZ_HDR_SIZE  4U
+
+/**
+ * @brief 压缩统计
+ */
+typedef struct {
+    /* 生产者 */
+    uint32_t records;                       /**< 写入记录数 */
+    uint32_t dropped;                       /**< 空间不足丢弃的记录数 */
+    uint64_t raw_bytes;                     /**< 写入的原始字节数 */
+    uint64_t stored_bytes;                  /**< 实际占用缓冲区的字节数（含记录头）*/
+    uint64_t compress_ticks;                /**< 压缩耗时（RING_BUFFER_LZ_TICKS 单位）*/
+    
+    /* 消费者 */
+    uint32_t corrupt;                       /**< 解压失败丢弃的记录数 */
+    uint64_t decompress_ticks;              /**< 解压耗时 */
+} ring_buffer_lz_stats_t;
+
+/**
+ * @brief 压缩记录缓冲区（包装一个普通缓冲区）
+ */
+typedef struct {
+    ring_buffer_t *rb;                      /**< 底层缓冲区（任意策略）*/
+    const uint8_t *dict;                    /**< 共享字典（生产者与消费者相同，可为 NULL）*/
+    uint16_t dict_len;                      /**< 字典长度 */
+    uint32_t base;                          /**< 当前记录在压缩流中的起始位置（生产者私有）*/
+    uint32_t table[1U << RING_BUFFER_LZ_HASH_LOG];      /**< 记录内匹配哈希表（生产者私有）*/
+    uint16_t dict_table[1U << RING_BUFFER_LZ_HASH_LOG]; /**< 字典匹配哈希表（初始化后只读）*/
+    uint8_t wbuf[RING_BUFFER_LZ_MAX_RECORD];            /**< 压缩输出暂存区（生产者私有）*/
+    uint8_t rbuf[RING_BUFFER_LZ_MAX_RECORD];            /**< 环绕记录拼接区（消费者私有）*/
+    ring_buffer_lz_stats_t stats;           /**< 统计 */
+} ring_buffer_lz_t;
+
+/**
+ * @brief 初始化压缩记录缓冲区
+ * @param lz       控制结构（用户分配）
+ * @param rb       已创建的底层缓冲区
+ * @param dict     共享字典（典型日志行拼接而成，可为 NULL），生命周期需覆盖 lz
+ * @param dict_len 字典长度（< 65535）
+ * @return true=成功, false=参数错误
+ */
+bool ring_buffer_lz_init(ring_buffer_lz_t *lz, ring_buffer_t *rb, const uint8_t *dict, uint16_t dict_len);
+
+/**
+ * @brief 压缩并写入一条记录（不能缩短时原样存储）
+ * @return true=成功, false=空间不足（计入 dropped）或参数错误
+ */
+bool ring_buffer_lz_write(ring_buffer_lz_t *lz, const uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 读取并解压一条记录
+ * @param out 输出缓冲区
+ * @param cap 输出缓冲区大小，小于记录原始长度时不读取
+ * @return 记录原始长度，无记录或出错返回 0
+ */
+ring_buffer_size_t ring_buffer_lz_read(ring_buffer_lz_t *lz, uint8_t *out, ring_buffer_size_t cap);
+
+/**
+ * @brief 压缩率（原始字节数 / 占用字节数 × 100，未写入时返回 100）
+ */
+uint32_t ring_buffer_lz_ratio(const ring_buffer_lz_t *lz);
+#endif
+
+/* ============================== 快照读取 ============================== */
+
+#if RING_BUFFER_ENABLE_SNAPSHOT
+/**
+ * @brief 快照读取标志：复制最近写入的 len 字节（默认复制最早的 len 字节）
+ */
+#define RING_BUFFER_SNAPSHOT_LATEST  0x01U
+
+/**
+ * @brief 快照读取（监控/调试转储用，不移除数据、不加锁、不修改任何字段）
+ * @param rb    缓冲区指针（任意内置策略）
+ * @param data  输出缓冲区
+ * @param len   期望复制的字节数
+ * @param flags RING_BUFFER_SNAPSHOT_LATEST 或 0
+ * @return 实际复制的字节数；可读数据不足 len 时 < len，
+ *         复制期间数据连续 RING_BUFFER_SNAPSHOT_RETRIES 次被释放时返回 0
+ * @note 复制后重新读取读指针，所复制区域被消费者释放（可能已被生产者覆盖）时重试
+ */
+ring_buffer_size_t ring_buffer_snapshot(const ring_buffer_t *rb, uint8_t *data,
+                                        ring_buffer_size_t len, uint8_t flags);
+#endif
+
+/* ============================ 大页/NUMA 存储 ============================ */
+
+#if RING_BUFFER_ENABLE_HUGEMEM
+/**
+ * @brief 存储分配标志
+ */
+#define RING_BUFFER_HUGEMEM_THP       0x01U  /**< 透明大页（按大页对齐 + madvise）*/
+#define RING_BUFFER_HUGEMEM_HUGETLB   0x02U  /**< 显式大页（MAP_HUGETLB，需预留大页，失败时退回透明大页）*/
+#define RING_BUFFER_HUGEMEM_PREFAULT  0x04U  /**< 预先触碰每一页，避免突发期间缺页 */
+#define RING_BUFFER_HUGEMEM_MLOCK     0x08U  /**< 锁定在物理内存中 */
+
+#define RING_BUFFER_HUGEMEM_NODE_ANY    (-1) /**< 不绑定 NUMA 节点 */
+#define RING_BUFFER_HUGEMEM_NODE_LOCAL  (-2) /**< 绑定到调用线程当前所在的节点（由消费者线程分配）*/
+
+/**
+ * @brief 大页/NUMA 存储
+ */
+typedef struct {
+    uint8_t *base;                          /**< 数据区起始地址 */
+    size_t map_len;                         /**< 映射长度（按页取整）*/
+    int node;                               /**< 实际绑定的节点（-1 = 未绑定）*/
+    uint8_t applied;                        /**< 实际生效的标志（其余为尽力而为，失败时已告警）*/
+} ring_buffer_hugemem_t;
+
+/**
+ * @brief 分配缓冲区数据区，配合 ring_buffer_create 使用
+ * @param mem   存储描述（用户分配）
+ * @param size  数据区大小（字节）
+ * @param node  NUMA 节点编号，或 RING_BUFFER_HUGEMEM_NODE_ANY / RING_BUFFER_HUGEMEM_NODE_LOCAL
+ * @param flags RING_BUFFER_HUGEMEM_xxx 组合
+ * @return 数据区地址，映射失败返回 NULL
+ * @note 顺序：映射 -> 大页 -> 绑定节点 -> 预先缺页 -> 锁定，保证页在绑定的节点上分配
+ */
+uint8_t *ring_buffer_hugemem_alloc(ring_buffer_hugemem_t *mem, size_t size, int node, uint8_t flags);
+
+/**
+ * @brief 释放数据区（缓冲区须先销毁）
+ */
+void ring_buffer_hugemem_free(ring_buffer_hugemem_t *mem);
+#endif
+
+/* ============================ 读写轨迹录制/回放 ============================ */
+
+#if RING_BUFFER_ENABLE_TRACE
+/**
+ * @brief 记录长度字段的最高位：1 = read_multi，0 = write_multi
+ * @note RING_BUFFER_SIZE_MAX 保证长度本身不会用到最高位
+ */
+#define RING_BUFFER_TRACE_OP_READ  0x80000000UL
+
+/**
+ * @brief 单条轨迹记录（16 字节，按主机字节序存入文件）
+ */
+typedef struct {
+    uint64_t time;                          /**< 相对开始录制的时间（纳秒）*/
+    uint32_t len;                           /**< 请求长度（最高位为操作类型）*/
+    uint32_t done;                          /**< 实际完成的字节数 */
+} ring_buffer_trace_rec_t;
+
+/**
+ * @brief 轨迹录制器
+ */
+struct ring_buffer_trace {
+    ring_buffer_trace_rec_t *recs;          /**< 记录数组（用户提供）*/
+    uint32_t capacity;                      /**< 记录数组容量 */
+    volatile uint32_t count;                /**< 已预留的记录槽位数（可略超过 capacity）*/
+    volatile uint32_t dropped;              /**< 数组写满后丢弃的记录数 */
+    uint32_t ring_size;                     /**< 录制时的缓冲区大小 */
+    uint64_t start;                         /**< 开始录制的时刻（单调时钟，纳秒）*/
+};
+
+/**
+ * @brief 回放结果
+ */
+typedef struct {
+    uint64_t written;                       /**< 写入总字节数 */
+    uint64_t read;                          /**< 读出总字节数 */
+    uint32_t short_writes;                  /**< 写入不足请求长度的次数（空间不足）*/
+    uint32_t empty_reads;                   /**< 读取时无数据的次数 */
+    ring_buffer_size_t peak_used;           /**< 写入后观测到的最大占用（字节）*/
+    uint64_t elapsed_ns;                    /**< 回放总耗时（纳秒）*/
+    uint64_t max_lag_ns;                    /**< 操作落后于时间表的最大值（纳秒）*/
+} ring_buffer_trace_result_t;
+
+/**
+ * @brief 初始化录制器
+ * @param tr       录制器
+ * @param recs     记录数组（用户分配）
+ * @param capacity 记录数组容量（条）
+ * @return true=成功, false=参数错误
+ */
+bool ring_buffer_trace_init(ring_buffer_trace_t *tr, ring_buffer_trace_rec_t *recs, uint32_t capacity);
+
+/**
+ * @brief 开始录制：此后每次 ring_buffer_write_multi/ring_buffer_read_multi 追加一条记录
+ * @return true=成功, false=参数错误
+ * @note 记录槽位以原子加法预留，多个生产者/消费者可同时录制；数组写满后丢弃并计数
+ */
+bool ring_buffer_trace_start(ring_buffer_t *rb, ring_buffer_trace_t *tr);
+
+/**
+ * @brief 停止录制（正在进行的读写可能仍在写入最后一条记录，保存前须等读写线程停下）
+ */
+void ring_buffer_trace_stop(ring_buffer_t *rb);
+
+/**
+ * @brief 查询记录数
+ * @param dropped 输出：数组写满后丢弃的记录数（可为 NULL）
+ * @return 有效记录数
+ */
+uint32_t ring_buffer_trace_count(const ring_buffer_trace_t *tr, uint32_t *dropped);
+
+/**
+ * @brief 按时间排序后保存为二进制文件（16 字节文件头 + 记录）
+ * @return true=成功, false=文件错误
+ */
+bool ring_buffer_trace_save(ring_buffer_trace_t *tr, const char *path);
+
+/**
+ * @brief 从文件载入轨迹
+ * @param recs     记录数组（用户分配）
+ * @param capacity 记录数组容量，文件中的记录更多时截断并告警
+ * @return true=成功, false=文件错误或格式不符
+ */
+bool ring_buffer_trace_load(ring_buffer_trace_t *tr, ring_buffer_trace_rec_t *recs,
+                            uint32_t capacity, const char *path);
+
+/**
+ * @brief 按录制时的到达节奏重放到缓冲区
+ * @param tr     轨迹
+ * @param rb     目标缓冲区（任意策略，已创建，容量可与录制时不同）
+ * @param speed  加速倍数（1 = 原速，0 = 不等待、尽快执行）
+ * @param result 输出：回放结果
+ * @return true=成功, false=参数错误或线程创建失败
+ * @note 写记录在新建线程上执行，读记录在调用线程上执行；写入内容为填充数据
+ */
+bool ring_buffer_trace_replay(const ring_buffer_trace_t *tr, ring_buffer_t *rb, uint32_t speed,
+                              ring_buffer_trace_result_t *result);
+#endif
+
+/* ============================== 多级流水线 ============================== */
+
+#if RING_BUFFER_ENABLE_PIPELINE
+/**
+ * @brief 流水线级处理函数
+ * @param ctx   用户上下文
+ * @param spans 本级输入数据段（1 或 2 段，合计不超过 RING_BUFFER_PIPE_DRAIN）
+ * @param count 数据段数量
+ * @param out   下一级的输入缓冲区（最后一级为 NULL）
+ * @return 已处理、可从输入中移除的字节数
+ * @note 下游写不下时只处理能写下的部分并返回其长度，其余数据留在输入中下次重新交给处理函数，
+ *       背压由此逐级向上游传递
+ */
+typedef ring_buffer_size_t (*ring_buffer_stage_fn_t)(void *ctx, const ring_buffer_span_t *spans,
+                                                     uint8_t count, ring_buffer_t *out);
+
+/**
+ * @brief 流水线级
+ */
+typedef struct {
+    ring_buffer_t in;                       /**< 输入缓冲区（上一级为唯一生产者）*/
+    uint8_t *storage;                       /**< 输入缓冲区存储（malloc）*/
+    ring_buffer_stage_fn_t fn;              /**< 处理函数 */
+    void *ctx;                              /**< 处理函数上下文 */
+    int cpu;                                /**< 绑定的 CPU（-1 = 不绑定）*/
+    
+    /* 统计：仅本级线程更新 */
+    volatile uint64_t bytes;                /**< 已处理字节数 */
+    volatile uint64_t batches;              /**< 处理函数调用次数 */
+    volatile uint64_t stalls;               /**< 未处理完整批输入的次数（下游已满或数据不完整）*/
+    volatile ring_buffer_size_t peak_depth; /**< 输入缓冲区的最大深度 */
+} ring_buffer_stage_t;
+
+/**
+ * @brief 流水线
+ * @note &pl.stages[0].in 即流水线入口，由唯一的生产者以任意缓冲区 API 写入
+ */
+typedef struct {
+    ring_buffer_stage_t stages[RING_BUFFER_PIPE_MAX_STAGES]; /**< 各级（按数据流向排列）*/
+    uint8_t count;                          /**< 级数 */
+    volatile bool running;                  /**< 各级线程运行中 */
+    void *impl;                             /**< 线程句柄 */
+} ring_buffer_pipeline_t;
+
+/**
+ * @brief 单级统计快照
+ */
+typedef struct {
+    uint64_t bytes;                         /**< 已处理字节数（两次采样之差除以间隔即吞吐）*/
+    uint64_t batches;                       /**< 处理函数调用次数 */
+    uint64_t stalls;                        /**< 未处理完整批输入的次数 */
+    ring_buffer_size_t depth;               /**< 当前输入队列深度 */
+    ring_buffer_size_t peak_depth;          /**< 输入队列最大深度 */
+} ring_buffer_stage_stats_t;
+
+/**
+ * @brief 初始化流水线（不含任何级）
+ */
+bool ring_buffer_pipeline_init(ring_buffer_pipeline_t *pl);
+
+/**
+ * @brief 在末尾追加一级
+ * @param pl      流水线
+ * @param fn      处理函数
+ * @param ctx     处理函数上下文
+ * @param in_size 本级输入缓冲区大小（字节，存储由 malloc 分配）
+ * @param cpu     线程绑定的 CPU 编号（-1 = 不绑定；仅 Linux 支持绑定）
+ * @return true=成功, false=参数错误、级数已满、已启动或内存不足
+ */
+bool ring_buffer_pipeline_add_stage(ring_buffer_pipeline_t *pl, ring_buffer_stage_fn_t fn, void *ctx,
+                                    ring_buffer_size_t in_size, int cpu);
+
+/**
+ * @brief 为每一级启动线程
+ * @return true=成功, false=无级或线程创建失败（已启动的线程被停止）
+ * @note 每级线程循环批量取出输入（每次最多 RING_BUFFER_PIPE_DRAIN 字节）交给处理函数；
+ *       连续 RING_BUFFER_PIPE_IDLE_SPINS 轮无进展后改为短暂睡眠
+ */
+bool ring_buffer_pipeline_start(ring_buffer_pipeline_t *pl);
+
+/**
+ * @brief 停止各级线程
+ * @param drain true=先等待各级输入按顺序排空（入口须已停止写入），false=立即停止
+ */
+void ring_buffer_pipeline_stop(ring_buffer_pipeline_t *pl, bool drain);
+
+/**
+ * @brief 读取单级统计（任意线程可调用，运行中为近似值）
+ * @return true=成功, false=参数错误
+ */
+bool ring_buffer_pipeline_stats(const ring_buffer_pipeline_t *pl, uint8_t stage, ring_buffer_stage_stats_t *st);
+
+/**
+ * @brief 释放各级存储（须先停止）
+ */
+void ring_buffer_pipeline_deinit(ring_buffer_pipeline_t *pl);
+#endif
+
+/* ============================== 水位通知 ============================== */
+
+#if RING_BUFFER_ENABLE_NOTIFY
+/**
+ * @brief 通知事件
+ */
+#define RING_BUFFER_NOTIFY_DATA   0x01U     /**< 通知消费者：有数据待读 */
+#define RING_BUFFER_NOTIFY_SPACE  0x02U     /**< 通知生产者：占用已降到低水位 */
+
+/**
+ * @brief 通知回调（在触发方的上下文中执行，可能是 ISR，应尽量简短，如释放信号量）
+ * @param ctx   用户上下文
+ * @param event RING_BUFFER_NOTIFY_DATA 或 RING_BUFFER_NOTIFY_SPACE
+ */
+typedef void (*ring_buffer_notify_fn_t)(void *ctx, uint8_t event);
+
+/**
+ * @brief 水位通知
+ */
+typedef struct {
+    ring_buffer_t *rb;                      /**< 所属缓冲区 */
+    ring_buffer_notify_fn_t fn;             /**< 通知回调 */
+    void *ctx;                              /**< 回调上下文 */
+    ring_buffer_size_t high;                /**< 高水位：可读数据达到此值时通知消费者 */
+    ring_buffer_size_t low;                 /**< 低水位：可读数据降到此值时通知等待空间的生产者 */
+    uint32_t max_delay;                     /**< 首个未读字节的最长等待（RING_BUFFER_NOTIFY_TICKS 单位，0 = 不限）*/
+    volatile uint32_t stamp;                /**< 缓冲区由空变为非空的时刻（生产者写入）*/
+    volatile uint8_t armed;                 /**< 已布防、尚未触发的事件（高位为内部刷新请求）*/
+    volatile uint32_t data_events;          /**< 已触发的 DATA 通知次数 */
+    volatile uint32_t space_events;         /**< 已触发的 SPACE 通知次数 */
+} ring_buffer_notify_t;
+
+/**
+ * @brief 初始化水位通知（DATA 初始已布防）
+ * @param nt        通知控制结构（用户分配）
+ * @param rb        缓冲区（任意策略，SPSC 使用）
+ * @param high      高水位（字节，>= 1）
+ * @param low       低水位（字节，< high）
+ * @param max_delay 首个未读字节的最长等待（时基单位，0 = 只按水位与刷新通知）
+ * @param fn        通知回调
+ * @param ctx       回调上下文
+ * @return true=成功, false=参数错误
+ */
+bool ring_buffer_notify_init(ring_buffer_notify_t *nt, ring_buffer_t *rb, ring_buffer_size_t high,
+                             ring_buffer_size_t low, uint32_t max_delay,
+                             ring_buffer_notify_fn_t fn, void *ctx);
+
+/**
+ * @brief 写入并按需通知消费者（生产者调用）
+ * @return 实际写入的字节数；写入不足时布防 SPACE，占用降到低水位时通知
+ * @note 可读数据达到高水位或首个未读字节等待超过 max_delay 时触发 DATA，之后直到消费者读取前不再重复
+ */
+ring_buffer_size_t ring_buffer_notify_write(ring_buffer_notify_t *nt, const uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 读取，读空时重新布防 DATA（消费者调用）
+ * @return 实际读取的字节数
+ * @note 收到 DATA 通知后须反复读取直到返回 0 再等待；未读空前不会再次通知
+ */
+ring_buffer_size_t ring_buffer_notify_read(ring_buffer_notify_t *nt, uint8_t *data, ring_buffer_size_t len);
+
+/**
+ * @brief 检查超时（由周期性定时器或空闲的生产者调用）
+ * @note 生产者停止写入后，只有此函数能发现首个未读字节已超时
+ */
+void ring_buffer_notify_poll(ring_buffer_notify_t *nt);
+
+/**
+ * @brief 显式刷新：有未读数据时尽快通知消费者（生产者在一批数据末尾调用）
+ * @note DATA 已布防时立即通知；否则在消费者读取后重新布防时通知
+ */
+void ring_buffer_notify_flush(ring_buffer_notify_t *nt);
+#endif
+
+/* ============================== 静态定义 ============================== */
+
+/**
+ * @brief 内置策略的操作表（供 RING_BUFFER_DEFINE 在编译期绑定）
+ */
+#if RING_BUFFER_ENABLE_LOCKFREE
+extern const ring_buffer_ops_t ring_buffer_lockfree_ops;
+#define RB_STATIC_OPS_LOCKFREE        ring_buffer_lockfree_ops
+#endif
+#if RING_BUFFER_ENABLE_DISABLE_IRQ
+extern const ring_buffer_ops_t ring_buffer_disable_irq_ops;
+#define RB_STATIC_OPS_DISABLE_IRQ     ring_buffer_disable_irq_ops
+#endif
+#if RING_BUFFER_ENABLE_MUTEX
+extern const ring_buffer_ops_t ring_buffer_mutex_ops;
+/* 互斥锁须在运行时创建，不提供 RB_STATIC_OPS_MUTEX，使用时编译报错 */
+#endif
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+extern const ring_buffer_ops_t ring_buffer_lockfree_batch_ops;
+#define RB_STATIC_OPS_LOCKFREE_BATCH  ring_buffer_lockfree_batch_ops
+#define RB_STATIC_BATCH_INIT(bytes)   .batch_bytes = RING_BUFFER_BATCH_CLAMP(RING_BUFFER_BATCH_BYTES, bytes), \
+                                      .batch_delay = RING_BUFFER_BATCH_MAX_DELAY,
+#else
+#define RB_STATIC_BATCH_INIT(bytes)
+#endif
+#if RING_BUFFER_ENABLE_SPINLOCK
+extern const ring_buffer_ops_t ring_buffer_spinlock_ops;
+#define RB_STATIC_OPS_SPINLOCK        ring_buffer_spinlock_ops
+#endif
+
+#define RB_STATIC_CAT_(a, b)  a##b
+#define RB_STATIC_CAT(a, b)   RB_STATIC_CAT_(a, b)
+
+/**
+ * @brief 以指定操作表静态定义缓冲区（自定义策略直接绑定操作表，无需注册与查找）
+ * @param name  控制结构变量名（存储区为 name##_storage）
+ * @param bytes 缓冲区大小（字节，编译期常量）
+ * @param table 操作表（const ring_buffer_ops_t 对象）
+ * @note 控制结构与存储区均为文件内 static，常量初始化，main() 之前即可使用
+ */
+#define RING_BUFFER_DEFINE_OPS(name, bytes, table) \
+    typedef char name##_size_check[((bytes) >= RING_BUFFER_MIN_SIZE && \
+                                     (bytes) <= RING_BUFFER_SIZE_MAX) ? 1 : -1]; \
+    static uint8_t name##_storage[(bytes)]; \
+    static ring_buffer_t name = { \
+        .buffer = name##_storage, \
+        .size = (ring_buffer_size_t)(bytes), \
+        .ops = &(table), \
+        RB_STATIC_BATCH_INIT(bytes) \
+    }
+
+/**
+ * @brief 编译期定义缓冲区，无需调用 ring_buffer_create
+ * @param name     控制结构变量名
+ * @param bytes    缓冲区大小（字节，编译期常量，范围检查在编译期完成）
+ * @param strategy 策略名：LOCKFREE / DISABLE_IRQ / LOCKFREE_BATCH / SPINLOCK
+ * @note 
+ * - 控制结构与存储区放在 .data/.bss，启动时不执行初始化、工厂分支与自定义策略查找
+ * - 与 ring_buffer_create 得到的缓冲区完全相同，所有 API 均可使用
+ * - 互斥锁模式须在运行时创建锁，不支持静态定义
+ * - LOCKFREE 额外生成 name##_put / name##_get 单字节内联函数：
+ *   大小为编译期常量，取模由编译器化简（2 的幂时为掩码），不经操作表与参数检查，
+ *   不更新统计与轨迹，仅限 SPSC 使用
+ * - 在 C 源文件的文件作用域中使用（指定初始化器）
+ * @code
+ * RING_BUFFER_DEFINE(uart_rx, 256, LOCKFREE);
+ * 
+ * void USART1_IRQHandler(void)
+ * {
+ *     uart_rx_put((uint8_t)USART1->DR);
+ * }
+ * 
+ * ring_buffer_read_multi(&uart_rx, frame, sizeof(frame));
+ * @endcode
+ */
+#define RING_BUFFER_DEFINE(name, bytes, strategy) \
+    RING_BUFFER_DEFINE_OPS(name, bytes, RB_STATIC_CAT(RB_STATIC_OPS_, strategy)); \
+    RB_STATIC_CAT(RB_STATIC_INLINE_, strategy)(name, bytes)
+
+/* 各策略附加的内联函数（最后一个声明承接宏调用处的分号）*/
+#define RB_STATIC_INLINE_DISABLE_IRQ(name, bytes)     typedef int name##_inline_none
+#define RB_STATIC_INLINE_LOCKFREE_BATCH(name, bytes)  typedef int name##_inline_none
+#define RB_STATIC_INLINE_SPINLOCK(name, bytes)        typedef int name##_inline_none
+#define RB_STATIC_INLINE_LOCKFREE(name, bytes) \
+    static inline bool name##_put(uint8_t data) \
+    { \
+        ring_buffer_size_t head = name.head; \
+        ring_buffer_size_t next = (ring_buffer_size_t)((head + 1U) % (bytes)); \
+        if (next == RB_LOAD_ACQUIRE(&name.tail)) { \
+            return false; \
+        } \
+        name##_storage[head] = data; \
+        RB_STORE_RELEASE(&name.head, next); \
+        return true; \
+    } \
+    static inline bool name##_get(uint8_t *data) \
+    { \
+        ring_buffer_size_t tail = name.tail; \
+        if (tail == RB_LOAD_ACQUIRE(&name.head)) { \
+            return false; \
+        } \
+        *data = name##_storage[tail]; \
+        RB_STORE_RELEASE(&name.tail, (ring_buffer_size_t)((tail + 1U) % (bytes))); \
+        return true; \
+    } \
+    typedef int name##_inline_none
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,741 @@
+/**
+ * @file    ring_buffer.hpp
+ * @brief   环形缓冲区 C++ 模板前端（仅头文件）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - C++ 服务中按元素类型收发对象，不想手工转换 uint8_t 与字节长度
+ * - 热路径上不希望每次操作经过操作接口表的间接调用
+ *
+ * 实现要点：
+ * - rb::ring<T, N, Policy>：容量 N 与元素大小均为编译期常量，
+ *   指针前进为"加 sizeof(T)、到末尾归零"，无取模、无除法
+ * - 线程安全策略为模板参数（policy::spsc / mpsc / mpmc / locked），编译期选定，无间接调用
+ * - 非平凡类型 T 通过 emplace 原地构造、try_pop 移动取出并析构
+ * - 控制块就是 ring_buffer_t：head/tail 为字节偏移，留一个元素空位区分满/空，
+ *   T 可平凡复制时 c_handle() 可直接交给 C 接口（如 ring_buffer_snapshot、fd 读写）
+ * - 生产者缓存读指针、消费者缓存写指针，各占独立缓存行，
+ *   未满/未空时不读取对方频繁修改的字段
+ * - rb::async_ring（C++20 协程）：co_await read_some / write_all 在读空/写满时挂起，
+ *   由对方发布时直接交接恢复，替代定时轮询
+ *
+ * @note 需要 C++17（协程接口需要 C++20）；控制块字节大小 (N + 1) * sizeof(T) 受 ring_buffer_size_t 限制，
+ *       较大容量需启用 RING_BUFFER_SIZE_32BIT
+ */
+
+#ifndef __RING_BUFFER_HPP
+#define __RING_BUFFER_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "ring_buffer.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <span>
+#define RB_HAS_COROUTINES 1
+#else
+#define RB_HAS_COROUTINES 0
+#endif
+
+#if RING_BUFFER_ENABLE_LOCKFREE
+extern "C" const ring_buffer_ops_t ring_buffer_lockfree_ops;
+#endif
+
+namespace rb {
+
+/* Policies ------------------------------------------------------------------*/
+
+namespace policy {
+
+struct spsc {};     /**< 单生产者单消费者：全程无锁 */
+struct mpsc {};     /**< 多生产者单消费者：生产者之间排队自旋锁，消费者无锁 */
+struct mpmc {};     /**< 多生产者多消费者：生产端、消费端各一把排队自旋锁，两端互不阻塞 */
+struct locked {};   /**< 多生产者多消费者：一把 std::mutex，线程数可能超过核数时使用 */
+
+} // namespace policy
+
+namespace detail {
+
+/**
+ * @brief 空锁（无需互斥的一端）
+ */
+struct null_lock {
+    void lock() noexcept {}
+    void unlock() noexcept {}
+};
+
+/**
+ * @brief 排队自旋锁（与 C 端 RING_BUFFER_TYPE_SPINLOCK 相同的票号锁与退避参数）
+ */
+class ticket_lock {
+public:
+    void lock() noexcept
+    {
+        uint32_t me = next_.fetch_add(1U, std::memory_order_relaxed);
+        uint32_t rounds = 0;
+        
+        for (;;) {
+            uint32_t owner = owner_.load(std::memory_order_acquire);
+            if (owner == me) {
+                return;
+            }
+            
+            for (uint32_t n = (me - owner) * RING_BUFFER_SPIN_BACKOFF; n > 0; n--) {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+                __asm__ __volatile__("yield" ::: "memory");
+#endif
+            }
+            
+            if (RING_BUFFER_SPIN_YIELD_AFTER > 0 && ++rounds >= RING_BUFFER_SPIN_YIELD_AFTER) {
+                rounds = 0;
+                std::this_thread::yield();
+            }
+        }
+    }
+    
+    void unlock() noexcept
+    {
+        owner_.store(owner_.load(std::memory_order_relaxed) + 1U, std::memory_order_release);
+    }
+    
+private:
+    std::atomic<uint32_t> next_{0};
+    std::atomic<uint32_t> owner_{0};
+};
+
+/**
+ * @brief 策略到两端锁类型的映射；shared 为 true 时两端共用生产端的锁
+ */
+template <typename Policy>
+struct policy_traits;
+
+template <>
+struct policy_traits<policy::spsc> {
+    using producer_lock = null_lock;
+    using consumer_lock = null_lock;
+    static constexpr bool shared = false;
+};
+
+template <>
+struct policy_traits<policy::mpsc> {
+    using producer_lock = ticket_lock;
+    using consumer_lock = null_lock;
+    static constexpr bool shared = false;
+};
+
+template <>
+struct policy_traits<policy::mpmc> {
+    using producer_lock = ticket_lock;
+    using consumer_lock = ticket_lock;
+    static constexpr bool shared = false;
+};
+
+template <>
+struct policy_traits<policy::locked> {
+    using producer_lock = std::mutex;
+    using consumer_lock = null_lock;
+    static constexpr bool shared = true;
+};
+
+} // namespace detail
+
+/* Ring ----------------------------------------------------------------------*/
+
+/**
+ * @brief 编译期容量、编译期策略的类型化环形缓冲区
+ * @tparam T      元素类型（须可移动构造）
+ * @tparam N      容量（元素个数）
+ * @tparam Policy 线程安全策略，见 rb::policy
+ */
+template <typename T, std::size_t N, typename Policy = policy::spsc>
+class ring {
+    using traits = detail::policy_traits<Policy>;
+    
+public:
+    using value_type = T;
+    using policy_type = Policy;
+    
+    /** 控制块中的数据区字节数（留一个元素空位） */
+    static constexpr std::size_t bytes = (N + 1U) * sizeof(T);
+    
+    static_assert(N >= 1U, "容量至少为 1");
+    static_assert(bytes <= RING_BUFFER_SIZE_MAX, "容量超出 ring_buffer_size_t 范围，请启用 RING_BUFFER_SIZE_32BIT");
+    static_assert(std::is_move_constructible<T>::value, "元素类型须可移动构造");
+    
+    ring() noexcept
+    {
+        std::memset(&hdr_, 0, sizeof(hdr_));
+        hdr_.buffer = storage_;
+        hdr_.size = static_cast<ring_buffer_size_t>(bytes);
+    }
+    
+    ~ring()
+    {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (ring_buffer_size_t i = hdr_.tail; i != hdr_.head; i = step(i)) {
+                slot(i)->~T();
+            }
+        }
+    }
+    
+    ring(const ring &) = delete;
+    ring &operator=(const ring &) = delete;
+    
+    /**
+     * @brief 原地构造一个元素
+     * @return true=成功, false=已满（未构造）
+     * @note 构造函数抛出异常时元素不会发布
+     */
+    template <typename... Args>
+    bool emplace(Args &&...args)
+    {
+        std::lock_guard<typename traits::producer_lock> guard(producer_lock());
+        
+        ring_buffer_size_t head = hdr_.head;
+        ring_buffer_size_t next = step(head);
+        
+        /* 缓存的读指针显示已满时才重新读取 */
+        if (next == tail_cache_) {
+            tail_cache_ = RB_LOAD_ACQUIRE(&hdr_.tail);
+            if (next == tail_cache_) {
+                return false;
+            }
+        }
+        
+        ::new (static_cast<void *>(storage_ + head)) T(std::forward<Args>(args)...);
+        RB_STORE_RELEASE(&hdr_.head, next);
+        return true;
+    }
+    
+    bool try_push(const T &value) { return emplace(value); }
+    bool try_push(T &&value) { return emplace(std::move(value)); }
+    
+    /**
+     * @brief 移动取出一个元素
+     * @return true=成功, false=为空（out 不变）
+     */
+    bool try_pop(T &out)
+    {
+        if constexpr (traits::shared) {
+            std::lock_guard<typename traits::producer_lock> guard(producer_lock());
+            return pop_locked(out);
+        } else {
+            std::lock_guard<typename traits::consumer_lock> guard(consumer_lock_);
+            return pop_locked(out);
+        }
+    }
+    
+    /**
+     * @brief 当前元素个数（并发读写时为近似值）
+     */
+    std::size_t size() const noexcept
+    {
+        ring_buffer_size_t tail = RB_LOAD_ACQUIRE(&hdr_.tail);
+        ring_buffer_size_t head = RB_LOAD_ACQUIRE(&hdr_.head);
+        std::size_t used = (head >= tail) ? (std::size_t)(head - tail) : (bytes - tail + head);
+        return used / sizeof(T);
+    }
+    
+    bool empty() const noexcept { return size() == 0U; }
+    bool full() const noexcept { return size() == N; }
+    static constexpr std::size_t capacity() noexcept { return N; }
+    
+    /**
+     * @brief 以 C 接口访问同一块存储（无锁策略，按整元素读写）
+     * @note 仅限 T 可平凡复制；C 端与 C++ 端各担任生产者或消费者之一
+     * @note C 端的长度一律向下取整到 sizeof(T) 的倍数，接近满/空时不会读写半个元素；
+     *       sizeof(T) > 1 时单字节 write/read 总是失败，span 回调须按整元素处理
+     */
+    ring_buffer_t *c_handle() noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "仅可平凡复制的元素类型可交给 C 接口");
+#if RING_BUFFER_ENABLE_LOCKFREE
+        hdr_.ops = c_ops();
+#endif
+        return &hdr_;
+    }
+    
+private:
+#if RING_BUFFER_ENABLE_LOCKFREE
+    /**
+     * @brief C 端操作表：在无锁策略之上把长度取整到整元素
+     */
+    static const ring_buffer_ops_t *c_ops() noexcept
+    {
+        static const ring_buffer_ops_t ops = [] {
+            ring_buffer_ops_t o = ring_buffer_lockfree_ops;
+            o.write = c_write;
+            o.read = c_read;
+            o.write_multi = c_write_multi;
+            o.read_multi = c_read_multi;
+            o.free_space = c_free_space;
+            o.is_full = c_is_full;
+            o.read_span = c_read_span;
+            o.write_span = c_write_span;
+            return o;
+        }();
+        return &ops;
+    }
+    
+    static ring_buffer_size_t whole(ring_buffer_size_t len) noexcept
+    {
+        return static_cast<ring_buffer_size_t>(len - len % sizeof(T));
+    }
+    
+    static bool c_write(ring_buffer_t *rb, uint8_t data)
+    {
+        return sizeof(T) == 1U && ring_buffer_lockfree_ops.write(rb, data);
+    }
+    
+    static bool c_read(ring_buffer_t *rb, uint8_t *data)
+    {
+        return sizeof(T) == 1U && ring_buffer_lockfree_ops.read(rb, data);
+    }
+    
+    static ring_buffer_size_t c_free_space(const ring_buffer_t *rb)
+    {
+        return whole(ring_buffer_lockfree_ops.free_space(rb));
+    }
+    
+    static bool c_is_full(const ring_buffer_t *rb)
+    {
+        return c_free_space(rb) == 0U;
+    }
+    
+    /*
+     * 对方只会让可写空间/可读数据变多，取整后的长度总能整段完成；
+     * 不足一个元素时直接返回 0（空/满是正常情况，不打印告警）
+     */
+    static ring_buffer_size_t c_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len)
+    {
+        ring_buffer_size_t n = c_free_space(rb);
+        n = (len < n) ? whole(len) : n;
+        return (n == 0U) ? 0U : ring_buffer_lockfree_ops.write_multi(rb, data, n);
+    }
+    
+    static ring_buffer_size_t c_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len)
+    {
+        ring_buffer_size_t n = whole(ring_buffer_lockfree_ops.available(rb));
+        n = (len < n) ? whole(len) : n;
+        return (n == 0U) ? 0U : ring_buffer_lockfree_ops.read_multi(rb, data, n);
+    }
+    
+    static ring_buffer_size_t c_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                          ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+    {
+        ring_buffer_size_t n = whole(ring_buffer_lockfree_ops.available(rb));
+        n = (len < n) ? whole(len) : n;
+        return (n == 0U) ? 0U : ring_buffer_lockfree_ops.read_span(rb, n, fn, ctx, flags);
+    }
+    
+    static ring_buffer_size_t c_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                           ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+    {
+        ring_buffer_size_t n = c_free_space(rb);
+        n = (len < n) ? whole(len) : n;
+        return (n == 0U) ? 0U : ring_buffer_lockfree_ops.write_span(rb, n, fn, ctx, flags);
+    }
+#endif
+    
+    static constexpr ring_buffer_size_t step(ring_buffer_size_t i) noexcept
+    {
+        i = static_cast<ring_buffer_size_t>(i + sizeof(T));
+        return (i == bytes) ? 0 : i;
+    }
+    
+    T *slot(ring_buffer_size_t i) noexcept
+    {
+        return std::launder(reinterpret_cast<T *>(storage_ + i));
+    }
+    
+    typename traits::producer_lock &producer_lock() noexcept { return producer_lock_; }
+    
+    bool pop_locked(T &out)
+    {
+        ring_buffer_size_t tail = hdr_.tail;
+        
+        /* 缓存的写指针显示为空时才重新读取 */
+        if (tail == head_cache_) {
+            head_cache_ = RB_LOAD_ACQUIRE(&hdr_.head);
+            if (tail == head_cache_) {
+                return false;
+            }
+        }
+        
+        T *p = slot(tail);
+        out = std::move(*p);
+        p->~T();
+        RB_STORE_RELEASE(&hdr_.tail, step(tail));
+        return true;
+    }
+    
+    ring_buffer_t hdr_;                                     /**< 与 C 接口共用的控制块 */
+    
+    alignas(RING_BUFFER_CACHE_LINE) ring_buffer_size_t tail_cache_ = 0;  /**< 生产者私有 */
+    typename traits::producer_lock producer_lock_;
+    
+    alignas(RING_BUFFER_CACHE_LINE) ring_buffer_size_t head_cache_ = 0;  /**< 消费者私有 */
+    typename traits::consumer_lock consumer_lock_;
+    
+    alignas(alignof(T) > RING_BUFFER_CACHE_LINE ? alignof(T) : RING_BUFFER_CACHE_LINE)
+    uint8_t storage_[bytes];                                /**< 数据区 */
+};
+
+/* Coroutines ----------------------------------------------------------------*/
+
+#if RB_HAS_COROUTINES
+
+namespace detail {
+
+/**
+ * @brief 挂起中的协程（侵入式节点，位于协程帧内的 awaiter 中，无堆分配）
+ */
+struct waiter {
+    std::coroutine_handle<> handle;
+    waiter *next = nullptr;
+    uint64_t ticket = 0;       /**< 本次登记的编号（入队时在锁内分配）*/
+};
+
+/**
+ * @brief 等待队列（先进先出，短临界区用排队自旋锁）
+ */
+class wait_list {
+public:
+    /** 无锁判空，供发布方在全屏障之后快速检查 */
+    bool empty() const noexcept { return head_.load(std::memory_order_relaxed) == nullptr; }
+    
+    /**
+     * @return 本次登记的编号，供 remove 认领；入队后节点可能随时被取走并恢复
+     */
+    uint64_t push(waiter *w) noexcept
+    {
+        std::lock_guard<ticket_lock> guard(lock_);
+        w->next = nullptr;
+        w->ticket = ++seq_;
+        if (tail_) {
+            tail_->next = w;
+        } else {
+            head_.store(w, std::memory_order_relaxed);
+        }
+        tail_ = w;
+        return w->ticket;
+    }
+    
+    waiter *pop() noexcept
+    {
+        std::lock_guard<ticket_lock> guard(lock_);
+        waiter *w = head_.load(std::memory_order_relaxed);
+        if (w) {
+            head_.store(w->next, std::memory_order_relaxed);
+            if (!w->next) {
+                tail_ = nullptr;
+            }
+        }
+        return w;
+    }
+    
+    /**
+     * @brief 撤回编号为 ticket 的登记
+     * @return true=已移除, false=该次登记已被唤醒方取走
+     * @note 按地址加编号匹配：协程被恢复后可能在同一地址重新登记，旧编号不会误删新登记
+     */
+    bool remove(waiter *w, uint64_t ticket) noexcept
+    {
+        std::lock_guard<ticket_lock> guard(lock_);
+        waiter *prev = nullptr;
+        for (waiter *it = head_.load(std::memory_order_relaxed); it; prev = it, it = it->next) {
+            if (it != w || it->ticket != ticket) {
+                continue;
+            }
+            if (prev) {
+                prev->next = it->next;
+            } else {
+                head_.store(it->next, std::memory_order_relaxed);
+            }
+            if (tail_ == it) {
+                tail_ = prev;
+            }
+            return true;
+        }
+        return false;
+    }
+    
+private:
+    ticket_lock lock_;
+    std::atomic<waiter *> head_{nullptr};
+    waiter *tail_ = nullptr;
+    uint64_t seq_ = 0;
+};
+
+} // namespace detail
+
+/**
+ * @brief 可 co_await 的环形缓冲区（包装 rb::ring，读空/写满时挂起协程）
+ * @tparam T      元素类型（write_all 需可复制）
+ * @tparam N      容量（元素个数）
+ * @tparam Policy 线程安全策略，见 rb::policy
+ *
+ * @details
+ * - 读空时 read_some 挂起，写满时 write_all 挂起，不阻塞任何线程
+ * - 对方发布数据/空间后，由发布方直接代为完成读写，再恢复挂起的协程（直接交接）
+ * - 等待节点位于协程帧内，每次 co_await 无堆分配
+ * - 发布方与挂起方各以"写共享状态 -> 全屏障 -> 读对方状态"配对，不会丢失唤醒
+ *
+ * @note 默认在发布方线程上直接恢复协程；需要回到执行器线程时构造时传入 resume 回调
+ * @note 挂起中的协程不得被销毁；多个协程同时 write_all 时彼此的数据可能交错
+ */
+template <typename T, std::size_t N, typename Policy = policy::spsc>
+class async_ring {
+public:
+    /** 恢复回调：把协程投递给执行器（ctx 为构造时传入的上下文） */
+    using resume_fn = void (*)(void *ctx, std::coroutine_handle<> handle);
+    
+    explicit async_ring(resume_fn resume = nullptr, void *ctx = nullptr) noexcept
+        : resume_(resume), resume_ctx_(ctx)
+    {
+    }
+    
+    async_ring(const async_ring &) = delete;
+    async_ring &operator=(const async_ring &) = delete;
+    
+    /* 非挂起接口：成功后唤醒对方 */
+    template <typename... Args>
+    bool emplace(Args &&...args)
+    {
+        bool ok = ring_.emplace(std::forward<Args>(args)...);
+        if (ok) {
+            pump();
+        }
+        return ok;
+    }
+    
+    bool try_push(const T &value) { return emplace(value); }
+    bool try_push(T &&value) { return emplace(std::move(value)); }
+    
+    bool try_pop(T &out)
+    {
+        bool ok = ring_.try_pop(out);
+        if (ok) {
+            pump();
+        }
+        return ok;
+    }
+    
+    std::size_t size() const noexcept { return ring_.size(); }
+    bool empty() const noexcept { return ring_.empty(); }
+    static constexpr std::size_t capacity() noexcept { return N; }
+    
+    /**
+     * @brief 读取至少一个元素的 awaiter（co_await 结果为读取个数，cap 为 0 时立即返回 0）
+     */
+    class read_awaiter : detail::waiter {
+    public:
+        read_awaiter(async_ring &r, T *buf, std::size_t cap) noexcept : r_(r), buf_(buf), cap_(cap) {}
+        
+        bool await_ready()
+        {
+            n_ = r_.pop_some(buf_, cap_);
+            return n_ > 0 || cap_ == 0;
+        }
+        
+        /**
+         * @note 入队后本对象可能已被发布方取走、恢复并销毁，
+         *       在撤回登记成功之前只访问局部变量
+         */
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            async_ring &r = r_;
+            handle = h;
+            for (;;) {
+                uint64_t ticket = r.readers_.push(this);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (r.ring_.empty()) {
+                    return true;
+                }
+                
+                /* 已被发布方取走：由其代为读取并恢复 */
+                if (!r.readers_.remove(this, ticket)) {
+                    return true;
+                }
+                
+                n_ = r.pop_some(buf_, cap_);
+                if (n_ > 0) {
+                    return false;
+                }
+            }
+        }
+        
+        std::size_t await_resume() const noexcept { return n_; }
+        
+    private:
+        friend class async_ring;
+        
+        async_ring &r_;
+        T *buf_;
+        std::size_t cap_;
+        std::size_t n_ = 0;
+    };
+    
+    /**
+     * @brief 全部写入的 awaiter（写满时挂起，直到 len 个元素全部进入缓冲区）
+     */
+    class write_awaiter : detail::waiter {
+    public:
+        write_awaiter(async_ring &r, const T *data, std::size_t len) noexcept : r_(r), data_(data), len_(len) {}
+        
+        bool await_ready()
+        {
+            done_ = r_.push_some(data_, len_);
+            return done_ == len_;
+        }
+        
+        /** @note 同 read_awaiter::await_suspend */
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            async_ring &r = r_;
+            handle = h;
+            for (;;) {
+                uint64_t ticket = r.writers_.push(this);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (r.ring_.full()) {
+                    return true;
+                }
+                
+                /* 已被发布方取走：由其代为写入并恢复 */
+                if (!r.writers_.remove(this, ticket)) {
+                    return true;
+                }
+                
+                done_ += r.push_some(data_ + done_, len_ - done_);
+                if (done_ == len_) {
+                    return false;
+                }
+            }
+        }
+        
+        void await_resume() const noexcept {}
+        
+    private:
+        friend class async_ring;
+        
+        async_ring &r_;
+        const T *data_;
+        std::size_t len_;
+        std::size_t done_ = 0;
+    };
+    
+    read_awaiter read_some(T *buf, std::size_t cap) noexcept { return read_awaiter(*this, buf, cap); }
+    read_awaiter read_some(std::span<T> buf) noexcept { return read_awaiter(*this, buf.data(), buf.size()); }
+    
+    write_awaiter write_all(const T *data, std::size_t len) noexcept { return write_awaiter(*this, data, len); }
+    write_awaiter write_all(std::span<const T> data) noexcept { return write_awaiter(*this, data.data(), data.size()); }
+    
+private:
+    /**
+     * @brief 批量读取，有数据被取走时唤醒等待空间的写方
+     */
+    std::size_t pop_some(T *buf, std::size_t cap)
+    {
+        std::size_t n = 0;
+        while (n < cap && ring_.try_pop(buf[n])) {
+            n++;
+        }
+        if (n > 0) {
+            pump();
+        }
+        return n;
+    }
+    
+    std::size_t push_some(const T *data, std::size_t len)
+    {
+        std::size_t n = 0;
+        while (n < len && ring_.try_push(data[n])) {
+            n++;
+        }
+        if (n > 0) {
+            pump();
+        }
+        return n;
+    }
+    
+    void resume(detail::waiter *w)
+    {
+        if (resume_) {
+            resume_(resume_ctx_, w->handle);
+        } else {
+            w->handle.resume();
+        }
+    }
+    
+    /**
+     * @brief 代挂起的协程完成读写并恢复，直到没有可服务的等待者
+     * @note 发布之后调用；与挂起方的"入队 -> 全屏障 -> 检查缓冲区"配对
+     */
+    void pump()
+    {
+        for (;;) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            
+            if (!readers_.empty() && !ring_.empty()) {
+                auto *w = static_cast<read_awaiter *>(readers_.pop());
+                if (w) {
+                    std::size_t n = 0;
+                    while (n < w->cap_ && ring_.try_pop(w->buf_[n])) {
+                        n++;
+                    }
+                    if (n > 0) {
+                        w->n_ = n;
+                        resume(w);
+                    } else {
+                        readers_.push(w);   /* 数据被其他消费者取走，重新排队后复查 */
+                    }
+                    continue;
+                }
+            }
+            
+            if (!writers_.empty() && !ring_.full()) {
+                auto *w = static_cast<write_awaiter *>(writers_.pop());
+                if (w) {
+                    std::size_t n = 0;
+                    while (w->done_ + n < w->len_ && ring_.try_push(w->data_[w->done_ + n])) {
+                        n++;
+                    }
+                    w->done_ += n;
+                    if (w->done_ == w->len_) {
+                        resume(w);
+                    } else {
+                        writers_.push(w);   /* 仍未写完，继续等待空间 */
+                    }
+                    continue;
+                }
+            }
+            
+            return;
+        }
+    }
+    
+    ring<T, N, Policy> ring_;
+    detail::wait_list readers_;
+    detail::wait_list writers_;
+    resume_fn resume_;
+    void *resume_ctx_;
+};
+
+#endif /* RB_HAS_COROUTINES */
+
+} // namespace rb
+
+#endif /* __RING_BUFFER_HPP */
@@ -0,0 +1,720 @@
+/**
+ * @file    ring_buffer_aio.c
+ * @brief   环形缓冲区异步写出引擎（io_uring / 线程池）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - Linux 主机上将缓冲区数据持续写入磁盘文件或管道
+ * - 消费者线程不希望阻塞在 write() 系统调用中
+ *
+ * 实现要点：
+ * - 引擎作为唯一消费者：以 RING_BUFFER_SPAN_PEEK 取得待写数据段直接提交，
+ *   写出完成后才按缓冲区顺序移动读指针，在途数据不会被生产者覆盖
+ * - 文件目标按显式偏移最多 RING_BUFFER_AIO_DEPTH 个请求同时在途，可乱序完成；
+ *   流式目标（管道/套接字）一次只在途一个请求以保证顺序
+ * - io_uring 后端直接使用系统调用（不依赖 liburing），不可用时退化为
+ *   pthread 线程池执行 pwrite()/write()
+ * - 短写自动提交剩余部分
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_AIO
+
+#include <errno.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+        #include <sys/uio.h>
+        #define AIO_USE_URING
+    #endif
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+
+#define AIO_DEPTH  RING_BUFFER_AIO_DEPTH
+
+/**
+ * @brief 单个写请求的最大字节数（不超过长度类型上限）
+ */
+#define AIO_CHUNK  ((ring_buffer_size_t)((RING_BUFFER_AIO_CHUNK > RING_BUFFER_SIZE_MAX) ? \
+                                         RING_BUFFER_SIZE_MAX : RING_BUFFER_AIO_CHUNK))
+
+/* Private types -------------------------------------------------------------*/
+
+typedef enum {
+    AIO_SLOT_FREE = 0,               /**< 空闲 */
+    AIO_SLOT_BUSY,                   /**< 已提交，等待完成 */
+    AIO_SLOT_DONE,                   /**< 已完成（或出错），等待按序回收 */
+} aio_slot_state_t;
+
+/**
+ * @brief 写请求槽位，按缓冲区顺序循环使用
+ */
+typedef struct {
+    uint8_t *data;                   /**< 待写数据（指向缓冲区内部）*/
+    ring_buffer_size_t len;          /**< 请求长度 */
+    ring_buffer_size_t done;         /**< 已写出字节数 */
+    int64_t off;                     /**< 文件偏移（-1 = 流）*/
+    uint8_t state;                   /**< aio_slot_state_t */
+} aio_slot_t;
+
+#ifdef AIO_USE_URING
+typedef struct {
+    int ring_fd;                     /**< io_uring 实例 */
+    void *sq_ptr;                    /**< 提交队列映射 */
+    size_t sq_size;
+    void *cq_ptr;                    /**< 完成队列映射（可能与 sq_ptr 相同）*/
+    size_t cq_size;
+    struct io_uring_sqe *sqes;       /**< SQE 数组映射 */
+    size_t sqes_size;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+    unsigned to_submit;              /**< 已填写未提交的 SQE 数 */
+    struct iovec iov[AIO_DEPTH];     /**< 每个槽位的 writev 描述 */
+} aio_uring_t;
+#endif
+
+typedef struct {
+    pthread_t threads[RING_BUFFER_AIO_THREADS];
+    uint8_t nthreads;
+    pthread_mutex_t lock;
+    pthread_cond_t work;             /**< 有新请求 */
+    pthread_cond_t done;             /**< 有请求完成 */
+    uint8_t sq[AIO_DEPTH];           /**< 待执行槽位队列 */
+    uint8_t sq_head;
+    uint8_t sq_count;
+    uint8_t cq[AIO_DEPTH];           /**< 已完成槽位队列 */
+    int32_t cq_res[AIO_DEPTH];       /**< 完成结果（字节数或 -errno）*/
+    uint8_t cq_head;
+    uint8_t cq_count;
+    bool stop;
+} aio_pool_t;
+
+typedef struct {
+    int fd;                          /**< 目标文件描述符 */
+    aio_slot_t slots[AIO_DEPTH];
+    uint8_t first;                   /**< 最早提交的槽位 */
+    uint8_t count;                   /**< 未回收的槽位数 */
+    uint8_t busy;                    /**< 后端在途请求数 */
+#ifdef AIO_USE_URING
+    aio_uring_t uring;
+#endif
+    aio_pool_t pool;
+} aio_impl_t;
+
+typedef struct {
+    ring_buffer_size_t skip;         /**< 跳过的在途字节数 */
+    uint8_t *data;                   /**< 首个连续待写段 */
+    ring_buffer_size_t len;
+} aio_peek_t;
+
+/* Private functions: io_uring -----------------------------------------------*/
+
+#ifdef AIO_USE_URING
+
+static bool uring_setup(aio_uring_t *u)
+{
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    
+    long fd = syscall(__NR_io_uring_setup, AIO_DEPTH, &p);
+    if (fd < 0) {
+        RB_LOG_INFO("io_uring unavailable (errno=%d)", errno);
+        return false;
+    }
+    u->ring_fd = (int)fd;
+    
+    u->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    u->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_size > u->sq_size) {
+            u->sq_size = u->cq_size;
+        }
+        u->cq_size = u->sq_size;
+    }
+    
+    u->sq_ptr = mmap(NULL, u->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     u->ring_fd, IORING_OFF_SQ_RING);
+    if (u->sq_ptr == MAP_FAILED) {
+        close(u->ring_fd);
+        return false;
+    }
+    
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        u->cq_ptr = u->sq_ptr;
+    } else {
+        u->cq_ptr = mmap(NULL, u->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         u->ring_fd, IORING_OFF_CQ_RING);
+        if (u->cq_ptr == MAP_FAILED) {
+            munmap(u->sq_ptr, u->sq_size);
+            close(u->ring_fd);
+            return false;
+        }
+    }
+    
+    u->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = (struct io_uring_sqe *)mmap(NULL, u->sqes_size, PROT_READ | PROT_WRITE,
+                                          MAP_SHARED | MAP_POPULATE, u->ring_fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED) {
+        if (u->cq_ptr != u->sq_ptr) {
+            munmap(u->cq_ptr, u->cq_size);
+        }
+        munmap(u->sq_ptr, u->sq_size);
+        close(u->ring_fd);
+        return false;
+    }
+    
+    uint8_t *sq = (uint8_t *)u->sq_ptr;
+    uint8_t *cq = (uint8_t *)u->cq_ptr;
+    u->sq_tail = (unsigned *)(void *)(sq + p.sq_off.tail);
+    u->sq_mask = (unsigned *)(void *)(sq + p.sq_off.ring_mask);
+    u->sq_array = (unsigned *)(void *)(sq + p.sq_off.array);
+    u->cq_head = (unsigned *)(void *)(cq + p.cq_off.head);
+    u->cq_tail = (unsigned *)(void *)(cq + p.cq_off.tail);
+    u->cq_mask = (unsigned *)(void *)(cq + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe *)(void *)(cq + p.cq_off.cqes);
+    u->to_submit = 0;
+    
+    return true;
+}
+
+static void uring_teardown(aio_uring_t *u)
+{
+    munmap(u->sqes, u->sqes_size);
+    if (u->cq_ptr != u->sq_ptr) {
+        munmap(u->cq_ptr, u->cq_size);
+    }
+    munmap(u->sq_ptr, u->sq_size);
+    close(u->ring_fd);
+}
+
+/**
+ * @brief 填写一个 writev SQE（暂不进入内核）
+ */
+static void uring_submit(aio_impl_t *im, uint8_t idx)
+{
+    aio_uring_t *u = &im->uring;
+    aio_slot_t *slot = &im->slots[idx];
+    unsigned tail = *u->sq_tail;
+    unsigned i = tail & *u->sq_mask;
+    struct io_uring_sqe *sqe = &u->sqes[i];
+    
+    u->iov[idx].iov_base = slot->data + slot->done;
+    u->iov[idx].iov_len = slot->len - slot->done;
+    
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = im->fd;
+    sqe->addr = (uint64_t)(uintptr_t)&u->iov[idx];
+    sqe->len = 1;
+    sqe->off = (slot->off < 0) ? (uint64_t)-1 : (uint64_t)(slot->off + slot->done);
+    sqe->user_data = idx;
+    
+    u->sq_array[i] = i;
+    __atomic_store_n(u->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    u->to_submit++;
+}
+
+/**
+ * @brief 提交已填写的 SQE，可选等待至少一个完成
+ */
+static void uring_enter(aio_uring_t *u, bool wait)
+{
+    if (u->to_submit == 0 && !wait) {
+        return;
+    }
+    
+    long ret;
+    do {
+        ret = syscall(__NR_io_uring_enter, u->ring_fd, u->to_submit, wait ? 1U : 0U,
+                      wait ? IORING_ENTER_GETEVENTS : 0U, NULL, 0);
+    } while (ret < 0 && errno == EINTR);
+    
+    if (ret > 0) {
+        u->to_submit -= (unsigned)ret;
+    }
+}
+
+static uint8_t uring_reap(aio_uring_t *u, bool wait, uint8_t *idx, int32_t *res)
+{
+    uint8_t n = 0;
+    
+    uring_enter(u, wait);
+    
+    unsigned head = *u->cq_head;
+    unsigned tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+    
+    while (head != tail && n < AIO_DEPTH) {
+        struct io_uring_cqe *cqe = &u->cqes[head & *u->cq_mask];
+        idx[n] = (uint8_t)cqe->user_data;
+        res[n] = cqe->res;
+        n++;
+        head++;
+    }
+    
+    __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+}
+
+#endif /* AIO_USE_URING */
+
+/* Private functions: 线程池 -------------------------------------------------*/
+
+static void *pool_worker(void *arg)
+{
+    aio_impl_t *im = (aio_impl_t *)arg;
+    aio_pool_t *p = &im->pool;
+    
+    pthread_mutex_lock(&p->lock);
+    
+    for (;;) {
+        while (!p->stop && p->sq_count == 0) {
+            pthread_cond_wait(&p->work, &p->lock);
+        }
+        
+        if (p->sq_count == 0) {
+            break;
+        }
+        
+        uint8_t idx = p->sq[p->sq_head];
+        p->sq_head = (uint8_t)((p->sq_head + 1) % AIO_DEPTH);
+        p->sq_count--;
+        pthread_mutex_unlock(&p->lock);
+        
+        /* 槽位在完成前只由本线程访问 */
+        aio_slot_t *slot = &im->slots[idx];
+        const uint8_t *data = slot->data + slot->done;
+        size_t len = slot->len - slot->done;
+        ssize_t n;
+        
+        do {
+            if (slot->off < 0) {
+                n = write(im->fd, data, len);
+            } else {
+                n = pwrite(im->fd, data, len, (off_t)(slot->off + slot->done));
+            }
+        } while (n < 0 && errno == EINTR);
+        
+        int32_t res = (n < 0) ? -errno : (int32_t)n;
+        
+        pthread_mutex_lock(&p->lock);
+        uint8_t tail = (uint8_t)((p->cq_head + p->cq_count) % AIO_DEPTH);
+        p->cq[tail] = idx;
+        p->cq_res[tail] = res;
+        p->cq_count++;
+        pthread_cond_signal(&p->done);
+    }
+    
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+static bool pool_setup(aio_impl_t *im, uint8_t nthreads)
+{
+    aio_pool_t *p = &im->pool;
+    
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->work, NULL);
+    pthread_cond_init(&p->done, NULL);
+    p->stop = false;
+    p->nthreads = 0;
+    
+    for (uint8_t i = 0; i < nthreads; i++) {
+        if (pthread_create(&p->threads[i], NULL, pool_worker, im) != 0) {
+            RB_LOG_ERROR("pthread_create failed (i=%u)", i);
+            break;
+        }
+        p->nthreads++;
+    }
+    
+    return p->nthreads > 0;
+}
+
+static void pool_teardown(aio_pool_t *p)
+{
+    pthread_mutex_lock(&p->lock);
+    p->stop = true;
+    pthread_cond_broadcast(&p->work);
+    pthread_mutex_unlock(&p->lock);
+    
+    for (uint8_t i = 0; i < p->nthreads; i++) {
+        pthread_join(p->threads[i], NULL);
+    }
+    
+    pthread_cond_destroy(&p->done);
+    pthread_cond_destroy(&p->work);
+    pthread_mutex_destroy(&p->lock);
+}
+
+static void pool_submit(aio_pool_t *p, uint8_t idx)
+{
+    pthread_mutex_lock(&p->lock);
+    p->sq[(p->sq_head + p->sq_count) % AIO_DEPTH] = idx;
+    p->sq_count++;
+    pthread_cond_signal(&p->work);
+    pthread_mutex_unlock(&p->lock);
+}
+
+static uint8_t pool_reap(aio_pool_t *p, bool wait, uint8_t *idx, int32_t *res)
+{
+    uint8_t n = 0;
+    
+    pthread_mutex_lock(&p->lock);
+    
+    while (wait && p->cq_count == 0) {
+        pthread_cond_wait(&p->done, &p->lock);
+    }
+    
+    while (p->cq_count > 0) {
+        idx[n] = p->cq[p->cq_head];
+        res[n] = p->cq_res[p->cq_head];
+        n++;
+        p->cq_head = (uint8_t)((p->cq_head + 1) % AIO_DEPTH);
+        p->cq_count--;
+    }
+    
+    pthread_mutex_unlock(&p->lock);
+    return n;
+}
+
+/* Private functions: 公共逻辑 -----------------------------------------------*/
+
+static void aio_backend_submit(ring_buffer_aio_t *aio, aio_impl_t *im, uint8_t idx)
+{
+#ifdef AIO_USE_URING
+    if (aio->backend == RING_BUFFER_AIO_URING) {
+        uring_submit(im, idx);
+    } else
+#endif
+    {
+        (void)aio;
+        pool_submit(&im->pool, idx);
+    }
+    
+    im->busy++;
+}
+
+static uint8_t aio_backend_reap(ring_buffer_aio_t *aio, aio_impl_t *im, bool wait,
+                                uint8_t *idx, int32_t *res)
+{
+#ifdef AIO_USE_URING
+    if (aio->backend == RING_BUFFER_AIO_URING) {
+        return uring_reap(&im->uring, wait, idx, res);
+    }
+#endif
+    
+    (void)aio;
+    return pool_reap(&im->pool, wait, idx, res);
+}
+
+/**
+ * @brief 定位在途数据之后的首个连续可读段（仅查看）
+ */
+static ring_buffer_size_t aio_peek_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    aio_peek_t *pk = (aio_peek_t *)ctx;
+    ring_buffer_size_t skip = pk->skip;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        if (skip >= spans[i].len) {
+            skip -= spans[i].len;
+            continue;
+        }
+        
+        pk->data = spans[i].data + skip;
+        pk->len = spans[i].len - skip;
+        break;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief 丢弃已写出的数据（移动读指针）
+ */
+static ring_buffer_size_t aio_consume_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    ring_buffer_size_t total = 0;
+    
+    (void)ctx;
+    for (uint8_t i = 0; i < count; i++) {
+        total += spans[i].len;
+    }
+    
+    return total;
+}
+
+/**
+ * @brief 为尚未提交的可读数据分配槽位并提交
+ */
+static void aio_fill(ring_buffer_aio_t *aio, aio_impl_t *im)
+{
+    /* 流式目标无法指定偏移，只能逐个写出 */
+    uint8_t limit = (aio->offset < 0) ? 1 : AIO_DEPTH;
+    ring_buffer_size_t chunk = AIO_CHUNK;
+    
+    while (im->count < limit) {
+        aio_peek_t pk = {
+            .skip = aio->inflight,
+            .data = NULL,
+            .len = 0,
+        };
+        
+        /* inflight + chunk 不超过 2 * RING_BUFFER_SIZE_MAX，32 位内不会溢出 */
+        uint32_t want = (uint32_t)aio->inflight + chunk;
+        if (want > RING_BUFFER_SIZE_MAX) {
+            want = RING_BUFFER_SIZE_MAX;
+        }
+        
+        ring_buffer_read_span(aio->rb, (ring_buffer_size_t)want, aio_peek_cb, &pk, RING_BUFFER_SPAN_PEEK);
+        if (pk.len == 0) {
+            break;
+        }
+        
+        if (pk.len > chunk) {
+            pk.len = chunk;
+        }
+        
+        uint8_t idx = (uint8_t)((im->first + im->count) % AIO_DEPTH);
+        aio_slot_t *slot = &im->slots[idx];
+        
+        slot->data = pk.data;
+        slot->len = pk.len;
+        slot->done = 0;
+        slot->off = aio->offset;
+        slot->state = AIO_SLOT_BUSY;
+        
+        if (aio->offset >= 0) {
+            aio->offset += pk.len;
+        }
+        aio->inflight += pk.len;
+        im->count++;
+        
+        aio_backend_submit(aio, im, idx);
+    }
+}
+
+/**
+ * @brief 回收完成的请求，按缓冲区顺序移动读指针
+ * @return 本次前移的字节数
+ */
+static ring_buffer_size_t aio_complete(ring_buffer_aio_t *aio, aio_impl_t *im, bool wait)
+{
+    uint8_t idx[AIO_DEPTH];
+    int32_t res[AIO_DEPTH];
+    uint8_t n = aio_backend_reap(aio, im, wait && im->busy > 0, idx, res);
+    
+    for (uint8_t i = 0; i < n; i++) {
+        aio_slot_t *slot = &im->slots[idx[i]];
+        im->busy--;
+        
+        if (res[i] <= 0) {
+            if (aio->error == 0) {
+                aio->error = (res[i] < 0) ? -res[i] : EIO;
+                RB_LOG_ERROR("Async write failed (fd=%d, errno=%d)", im->fd, aio->error);
+            }
+            slot->state = AIO_SLOT_DONE;
+            continue;
+        }
+        
+        slot->done += (ring_buffer_size_t)res[i];
+        
+        if (slot->done < slot->len && aio->error == 0) {
+            /* 短写：提交剩余部分 */
+            aio_backend_submit(aio, im, idx[i]);
+        } else {
+            slot->state = AIO_SLOT_DONE;
+        }
+    }
+    
+    /* 只回收从最早槽位起连续完成的部分，保证读指针按序前移 */
+    ring_buffer_size_t completed = 0;
+    
+    while (im->count > 0) {
+        aio_slot_t *slot = &im->slots[im->first];
+        if (slot->state != AIO_SLOT_DONE || slot->done != slot->len) {
+            break;
+        }
+        
+        completed += slot->len;
+        slot->state = AIO_SLOT_FREE;
+        im->first = (uint8_t)((im->first + 1) % AIO_DEPTH);
+        im->count--;
+    }
+    
+    if (completed > 0) {
+        ring_buffer_read_span(aio->rb, completed, aio_consume_cb, NULL, 0);
+        aio->inflight -= completed;
+    }
+    
+    return completed;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_aio_init(ring_buffer_aio_t *aio, ring_buffer_t *rb, int fd, int64_t offset,
+                          ring_buffer_aio_backend_t backend)
+{
+    if (!aio || !rb) {
+        RB_LOG_ERROR("aio or rb is NULL");
+        return false;
+    }
+    
+    if (fd < 0) {
+        RB_LOG_ERROR("Invalid fd=%d", fd);
+        return false;
+    }
+    
+    aio_impl_t *im = (aio_impl_t *)calloc(1, sizeof(aio_impl_t));
+    if (!im) {
+        RB_LOG_ERROR("Out of memory");
+        return false;
+    }
+    
+    im->fd = fd;
+    aio->rb = rb;
+    aio->fd = fd;
+    aio->offset = (offset < 0) ? -1 : offset;
+    aio->inflight = 0;
+    aio->error = 0;
+    aio->impl = im;
+    
+    bool ok = false;
+    
+#ifdef AIO_USE_URING
+    if (backend != RING_BUFFER_AIO_THREAD) {
+        ok = uring_setup(&im->uring);
+        aio->backend = RING_BUFFER_AIO_URING;
+    }
+#endif
+    
+    if (!ok && backend == RING_BUFFER_AIO_URING) {
+        RB_LOG_ERROR("io_uring backend not available");
+        free(im);
+        aio->impl = NULL;
+        return false;
+    }
+    
+    if (!ok) {
+        /* 流式目标一次只有一个请求，一个线程即可 */
+        ok = pool_setup(im, (aio->offset < 0) ? 1 : RING_BUFFER_AIO_THREADS);
+        aio->backend = RING_BUFFER_AIO_THREAD;
+    }
+    
+    if (!ok) {
+        RB_LOG_ERROR("Thread pool backend init failed");
+        free(im);
+        aio->impl = NULL;
+        return false;
+    }
+    
+    RB_LOG_INFO("Async engine ready (backend=%s, fd=%d)", ring_buffer_aio_backend_name(aio), fd);
+    return true;
+}
+
+int32_t ring_buffer_aio_poll(ring_buffer_aio_t *aio, bool wait)
+{
+    if (!aio || !aio->impl) {
+        RB_LOG_ERROR("aio is NULL or not initialized");
+        return -1;
+    }
+    
+    if (aio->error) {
+        return -1;
+    }
+    
+    aio_impl_t *im = (aio_impl_t *)aio->impl;
+    
+    aio_fill(aio, im);
+    ring_buffer_size_t completed = aio_complete(aio, im, wait);
+    
+    if (aio->error) {
+        return -1;
+    }
+    
+    /* 回收后腾出的槽位立即补上，保持请求在途 */
+    aio_fill(aio, im);
+    
+#ifdef AIO_USE_URING
+    if (aio->backend == RING_BUFFER_AIO_URING) {
+        uring_enter(&im->uring, false);
+    }
+#endif
+    
+    return (int32_t)completed;
+}
+
+bool ring_buffer_aio_drain(ring_buffer_aio_t *aio)
+{
+    if (!aio || !aio->impl) {
+        RB_LOG_ERROR("aio is NULL or not initialized");
+        return false;
+    }
+    
+    aio_impl_t *im = (aio_impl_t *)aio->impl;
+    
+    for (;;) {
+        if (ring_buffer_aio_poll(aio, true) < 0) {
+            return false;
+        }
+        
+        if (im->count == 0 && ring_buffer_is_empty(aio->rb)) {
+            return true;
+        }
+    }
+}
+
+void ring_buffer_aio_deinit(ring_buffer_aio_t *aio)
+{
+    if (!aio || !aio->impl) {
+        RB_LOG_ERROR("aio is NULL or not initialized");
+        return;
+    }
+    
+    aio_impl_t *im = (aio_impl_t *)aio->impl;
+    
+    /* 在途请求引用缓冲区内存，必须等其完成 */
+    while (im->busy > 0) {
+        aio_complete(aio, im, true);
+    }
+    
+#ifdef AIO_USE_URING
+    if (aio->backend == RING_BUFFER_AIO_URING) {
+        uring_teardown(&im->uring);
+    } else
+#endif
+    {
+        pool_teardown(&im->pool);
+    }
+    
+    free(im);
+    aio->impl = NULL;
+    
+    RB_LOG_INFO("Async engine stopped");
+}
+
+const char *ring_buffer_aio_backend_name(const ring_buffer_aio_t *aio)
+{
+    if (!aio || !aio->impl) {
+        return "none";
+    }
+    
+    return (aio->backend == RING_BUFFER_AIO_URING) ? "io_uring" : "thread";
+}
+
+#endif /* RING_BUFFER_ENABLE_AIO */
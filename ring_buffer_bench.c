@@ -0,0 +1,898 @@
+/**
+ * @file    ring_buffer_bench.c
+ * @brief   环形缓冲区主机端性能基准
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 用于在 Linux/x86-64 等主机上标定可调参数，不参与嵌入式构建。
+ *
+ * 编译运行：
+ * @code
+ * gcc -O2 -pthread -o bench ring_buffer_bench.c ring_buffer.c ring_buffer_lockfree.c \
+ *     ring_buffer_lockfree_batch.c ring_buffer_search.c ring_buffer_xform.c \
+ *     ring_buffer_copy.c ring_buffer_iov.c ring_buffer_aio.c ring_buffer_persist.c \
+ *     ring_buffer_segq.c ring_buffer_pool.c ring_buffer_prio.c ring_buffer_set.c \
+ *     ring_buffer_deque.c ring_buffer_mpsc.c ring_buffer_merge.c ring_buffer_lz.c \
+ *     ring_buffer_spinlock.c ring_buffer_snapshot.c ring_buffer_hugemem.c ring_buffer_trace.c \
+ *     ring_buffer_pipeline.c ring_buffer_notify.c -I.
+ * ./bench
+ * @endcode
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH || RING_BUFFER_ENABLE_MPSC || RING_BUFFER_ENABLE_SPINLOCK || \
+    RING_BUFFER_ENABLE_PIPELINE || RING_BUFFER_ENABLE_NOTIFY
+    #include <pthread.h>
+    #include <sched.h>
+    #include <unistd.h>
+#endif
+
+#if RING_BUFFER_ENABLE_NOTIFY
+    #include <semaphore.h>
+#endif
+
+/* Bench utilities -----------------------------------------------------------*/
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static double bench_mbps(uint64_t bytes, uint64_t ns)
+{
+    return (ns == 0) ? 0.0 : (double)bytes * 1000.0 / (double)ns;
+}
+
+/* Bench cases ---------------------------------------------------------------*/
+
+/**
+ * @brief 基线：无锁模式单线程小包读写
+ */
+static void bench_lockfree_baseline(void)
+{
+    static uint8_t storage[4096];
+    uint8_t msg[64];
+    ring_buffer_t rb;
+    const uint32_t iters = 1000000;
+    
+    ring_buffer_create(&rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE);
+    memset(msg, 0xA5, sizeof(msg));
+    
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t i = 0; i < iters; i++) {
+        ring_buffer_write_multi(&rb, msg, sizeof(msg));
+        ring_buffer_read_multi(&rb, msg, sizeof(msg));
+    }
+    uint64_t t1 = bench_now_ns();
+    
+    printf("  64B write+read: %.1f ns/op, %.0f MB/s\n",
+           (double)(t1 - t0) / iters, bench_mbps((uint64_t)iters * sizeof(msg), t1 - t0));
+    
+    ring_buffer_destroy(&rb);
+}
+
+RING_BUFFER_DEFINE(bench_static_rb, 4096, LOCKFREE);
+
+/**
+ * @brief 静态定义：省去的启动初始化开销，以及常量大小单字节内联读写与经操作表读写的对比
+ */
+static void bench_static_define(void)
+{
+    static uint8_t storage[64];
+    static ring_buffer_t rbs[1024];
+    const uint32_t iters = 10000000;
+    volatile uint8_t sink = 0;
+    uint8_t v = 0;
+    
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t i = 0; i < sizeof(rbs) / sizeof(rbs[0]); i++) {
+        ring_buffer_create(&rbs[i], storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE);
+    }
+    uint64_t t1 = bench_now_ns();
+    printf("  ring_buffer_create: %.1f ns/ring (static define: 0)\n",
+           (double)(t1 - t0) / (sizeof(rbs) / sizeof(rbs[0])));
+    
+    t0 = bench_now_ns();
+    for (uint32_t i = 0; i < iters; i++) {
+        ring_buffer_write(&bench_static_rb, (uint8_t)i);
+        ring_buffer_read(&bench_static_rb, &v);
+        sink = v;
+    }
+    t1 = bench_now_ns();
+    uint64_t t2 = bench_now_ns();
+    for (uint32_t i = 0; i < iters; i++) {
+        bench_static_rb_put((uint8_t)i);
+        bench_static_rb_get(&v);
+        sink = v;
+    }
+    uint64_t t3 = bench_now_ns();
+    (void)sink;
+    
+    printf("  1B write+read: ops table %.2f ns/op, inline %.2f ns/op\n",
+           (double)(t1 - t0) / iters, (double)(t3 - t2) / iters);
+}
+
+#define BENCH_XFER_SIZE   32768U
+#define BENCH_XFER_BYTES  (256UL * 1024UL * 1024UL)
+
+/**
+ * @brief 缓冲区间搬运：read_multi + write_multi（经中间缓冲）对比 ring_buffer_transfer
+ * @param chunk 每次搬运的字节数
+ */
+static void bench_transfer(ring_buffer_size_t chunk)
+{
+    static uint8_t src_buf[BENCH_XFER_SIZE], dst_buf[BENCH_XFER_SIZE], tmp[BENCH_XFER_SIZE];
+    ring_buffer_t src, dst;
+    uint64_t ns[2] = {0, 0};
+    
+    ring_buffer_create(&src, src_buf, BENCH_XFER_SIZE, RING_BUFFER_TYPE_LOCKFREE);
+    ring_buffer_create(&dst, dst_buf, BENCH_XFER_SIZE, RING_BUFFER_TYPE_LOCKFREE);
+    memset(tmp, 0x5A, sizeof(tmp));
+    
+    for (uint8_t mode = 0; mode < 2; mode++) {
+        for (uint64_t moved = 0; moved < BENCH_XFER_BYTES; moved += chunk) {
+            /* 只计搬运本身；读写指针逐次前移，环绕点不断变化 */
+            ring_buffer_write_multi(&src, tmp, chunk);
+            uint64_t t = bench_now_ns();
+            if (mode == 0) {
+                ring_buffer_size_t n = ring_buffer_read_multi(&src, tmp, chunk);
+                ring_buffer_write_multi(&dst, tmp, n);
+            } else {
+                ring_buffer_transfer(&dst, &src, chunk);
+            }
+            ns[mode] += bench_now_ns() - t;
+            ring_buffer_read_multi(&dst, tmp, chunk);
+        }
+    }
+    
+    printf("  chunk=%-5lu read+write %6.0f MB/s   transfer %6.0f MB/s\n", (unsigned long)chunk,
+           bench_mbps(BENCH_XFER_BYTES, ns[0]), bench_mbps(BENCH_XFER_BYTES, ns[1]));
+    
+    ring_buffer_destroy(&src);
+    ring_buffer_destroy(&dst);
+}
+
+#if RING_BUFFER_ENABLE_COPY_ENGINE
+
+/**
+ * @brief 填满再排空整个缓冲区，分别统计写入与读取耗时
+ */
+static void bench_fill_drain(ring_buffer_t *rb, uint8_t *chunk, ring_buffer_size_t chunk_len,
+                             uint32_t rounds, uint64_t *write_ns, uint64_t *read_ns, uint64_t *bytes)
+{
+    *write_ns = 0;
+    *read_ns = 0;
+    *bytes = 0;
+    
+    for (uint32_t r = 0; r < rounds; r++) {
+        uint64_t t0 = bench_now_ns();
+        ring_buffer_size_t n;
+        while ((n = ring_buffer_write_multi(rb, chunk, chunk_len)) == chunk_len) {
+            *bytes += n;
+        }
+        *bytes += n;
+        
+        uint64_t t1 = bench_now_ns();
+        while (ring_buffer_read_multi(rb, chunk, chunk_len) > 0) {
+        }
+        uint64_t t2 = bench_now_ns();
+        
+        *write_ns += t1 - t0;
+        *read_ns += t2 - t1;
+    }
+}
+
+/**
+ * @brief 拷贝引擎阈值标定：对比普通存储与流式存储、有无预取
+ */
+static void bench_copy_engine(void)
+{
+    /* 缓冲区需明显大于 LLC 才能体现流式存储的收益 */
+    ring_buffer_size_t size = (RING_BUFFER_SIZE_MAX > 64UL * 1024 * 1024) ?
+                              (ring_buffer_size_t)(64UL * 1024 * 1024) : RING_BUFFER_SIZE_MAX;
+    uint8_t *storage = (uint8_t *)malloc(size);
+    uint8_t *chunk = (uint8_t *)malloc(size / 2);
+    ring_buffer_t rb;
+    
+    if (!storage || !chunk || !ring_buffer_create(&rb, storage, size, RING_BUFFER_TYPE_LOCKFREE)) {
+        printf("  skipped: allocation failed\n");
+        free(storage);
+        free(chunk);
+        return;
+    }
+    
+    memset(storage, 0, size);
+    memset(chunk, 0x5A, size / 2);
+    
+    printf("  ring=%lu KB, nt kernel=%s\n", (unsigned long)(size / 1024), ring_buffer_copy_kernel_name());
+    printf("  %10s | %12s %12s | %12s %12s\n", "chunk", "write MB/s", "write+nt", "read MB/s", "read+pf");
+    
+    ring_buffer_size_t nt_pick = RING_BUFFER_SIZE_MAX;
+    ring_buffer_size_t pf_pick = RING_BUFFER_SIZE_MAX;
+    
+    for (ring_buffer_size_t len = 1024; len <= size / 2 && len != 0; len *= 2) {
+        uint64_t w0, r0, w1, r1, bytes;
+        uint32_t rounds = 4;
+        
+        ring_buffer_copy_set_threshold(RING_BUFFER_SIZE_MAX, RING_BUFFER_SIZE_MAX);
+        bench_fill_drain(&rb, chunk, len, rounds, &w0, &r0, &bytes);
+        
+        ring_buffer_copy_set_threshold(0, 0);
+        bench_fill_drain(&rb, chunk, len, rounds, &w1, &r1, &bytes);
+        
+        printf("  %10lu | %12.0f %12.0f | %12.0f %12.0f\n", (unsigned long)len,
+               bench_mbps(bytes, w0), bench_mbps(bytes, w1),
+               bench_mbps(bytes, r0), bench_mbps(bytes, r1));
+        
+        /* 取首个明显（>5%）获益的块大小作为阈值 */
+        if (nt_pick == RING_BUFFER_SIZE_MAX && w1 * 105 < w0 * 100) {
+            nt_pick = len;
+        }
+        if (pf_pick == RING_BUFFER_SIZE_MAX && r1 * 105 < r0 * 100) {
+            pf_pick = len;
+        }
+    }
+    
+    printf("  suggested: RING_BUFFER_COPY_NT_THRESHOLD=%lu, RING_BUFFER_COPY_PREFETCH_THRESHOLD=%lu%s\n",
+           (unsigned long)nt_pick, (unsigned long)pf_pick,
+           (nt_pick == RING_BUFFER_SIZE_MAX) ? " (max = keep disabled)" : "");
+    
+    ring_buffer_copy_set_threshold(
+        (ring_buffer_size_t)((RING_BUFFER_COPY_NT_THRESHOLD > RING_BUFFER_SIZE_MAX) ?
+                             RING_BUFFER_SIZE_MAX : RING_BUFFER_COPY_NT_THRESHOLD),
+        (ring_buffer_size_t)((RING_BUFFER_COPY_PREFETCH_THRESHOLD > RING_BUFFER_SIZE_MAX) ?
+                             RING_BUFFER_SIZE_MAX : RING_BUFFER_COPY_PREFETCH_THRESHOLD));
+    ring_buffer_destroy(&rb);
+    free(storage);
+    free(chunk);
+}
+
+#endif /* RING_BUFFER_ENABLE_COPY_ENGINE */
+
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+
+#define BENCH_SPSC_MSG    16
+#define BENCH_SPSC_BYTES  (64UL * 1024UL * 1024UL)
+
+static void *bench_spsc_producer(void *arg)
+{
+    ring_buffer_t *rb = (ring_buffer_t *)arg;
+    uint8_t msg[BENCH_SPSC_MSG];
+    
+    memset(msg, 0x3C, sizeof(msg));
+    for (uint64_t sent = 0; sent < BENCH_SPSC_BYTES; ) {
+        ring_buffer_size_t n = ring_buffer_write_multi(rb, msg, sizeof(msg));
+        if (n == 0) {
+            sched_yield();
+        }
+        sent += n;
+    }
+    ring_buffer_flush(rb, RING_BUFFER_FLUSH_WRITE);
+    
+    return NULL;
+}
+
+/**
+ * @brief 双线程 SPSC 小消息吞吐（batch = 0 表示普通无锁模式）
+ */
+static void bench_spsc(ring_buffer_size_t batch)
+{
+    static uint8_t storage[16384];
+    uint8_t msg[BENCH_SPSC_MSG];
+    ring_buffer_t rb;
+    pthread_t producer;
+    
+    if (batch == 0) {
+        ring_buffer_create(&rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE);
+    } else {
+        ring_buffer_create(&rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE_BATCH);
+        ring_buffer_set_batch(&rb, batch, 0);
+    }
+    
+    uint64_t t0 = bench_now_ns();
+    pthread_create(&producer, NULL, bench_spsc_producer, &rb);
+    for (uint64_t recv = 0; recv < BENCH_SPSC_BYTES; ) {
+        ring_buffer_size_t n = ring_buffer_read_multi(&rb, msg, sizeof(msg));
+        if (n == 0) {
+            sched_yield();
+        }
+        recv += n;
+    }
+    pthread_join(producer, NULL);
+    uint64_t t1 = bench_now_ns();
+    
+    printf("  %-10s batch=%-5lu %8.0f MB/s\n", (batch == 0) ? "lockfree" : "batch",
+           (unsigned long)batch, bench_mbps(BENCH_SPSC_BYTES, t1 - t0));
+    
+    ring_buffer_destroy(&rb);
+}
+
+#endif /* RING_BUFFER_ENABLE_LOCKFREE_BATCH */
+
+#if RING_BUFFER_ENABLE_MPSC
+
+#define BENCH_MPSC_MSG        16
+#define BENCH_MPSC_BYTES      (16UL * 1024UL * 1024UL)
+#define BENCH_MPSC_LANE_SIZE  4096
+
+typedef struct {
+    ring_buffer_mpsc_t *mpsc;           /**< 分片模式 */
+    ring_buffer_t *shared;              /**< 互斥锁模式（共享一个缓冲区）*/
+    uint64_t bytes;                     /**< 本线程写入量 */
+} bench_mpsc_arg_t;
+
+static void *bench_mpsc_producer(void *arg)
+{
+    bench_mpsc_arg_t *a = (bench_mpsc_arg_t *)arg;
+    uint8_t msg[BENCH_MPSC_MSG];
+    int32_t lane = a->mpsc ? ring_buffer_mpsc_register(a->mpsc) : 0;
+    
+    memset(msg, 0x5A, sizeof(msg));
+    for (uint64_t sent = 0; lane >= 0 && sent < a->bytes; ) {
+        ring_buffer_size_t n = a->mpsc ? ring_buffer_mpsc_write(a->mpsc, (uint8_t)lane, msg, sizeof(msg))
+                                       : ring_buffer_write_multi(a->shared, msg, sizeof(msg));
+        if (n == 0) {
+            sched_yield();
+        }
+        sent += n;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief 多生产者小消息吞吐：分片通道 vs 互斥锁共享缓冲区
+ */
+static void bench_mpsc(uint8_t producers, bool sharded)
+{
+    static uint8_t storage[BENCH_MPSC_LANE_SIZE * RING_BUFFER_MPSC_MAX_LANES];
+    static ring_buffer_mpsc_t mpsc;
+    ring_buffer_t shared;
+    pthread_t tids[RING_BUFFER_MPSC_MAX_LANES];
+    bench_mpsc_arg_t arg = {
+        .mpsc = NULL,
+        .shared = NULL,
+        .bytes = BENCH_MPSC_BYTES / producers,
+    };
+    uint8_t out[256];
+    
+    if (sharded) {
+        if (!ring_buffer_mpsc_init(&mpsc, storage, BENCH_MPSC_LANE_SIZE, producers)) {
+            return;
+        }
+        arg.mpsc = &mpsc;
+    } else {
+#if RING_BUFFER_ENABLE_MUTEX
+        /* 总容量与分片模式相同 */
+        if (!ring_buffer_create(&shared, storage, (ring_buffer_size_t)(BENCH_MPSC_LANE_SIZE * producers),
+                                RING_BUFFER_TYPE_MUTEX)) {
+            return;
+        }
+        arg.shared = &shared;
+#else
+        (void)shared;
+        return;
+#endif
+    }
+    
+    uint64_t total = arg.bytes * producers;
+    uint64_t t0 = bench_now_ns();
+    for (uint8_t i = 0; i < producers; i++) {
+        pthread_create(&tids[i], NULL, bench_mpsc_producer, &arg);
+    }
+    for (uint64_t recv = 0; recv < total; ) {
+        ring_buffer_size_t n = sharded ? ring_buffer_mpsc_read(&mpsc, out, sizeof(out), NULL)
+                                       : ring_buffer_read_multi(&shared, out, sizeof(out));
+        if (n == 0) {
+            sched_yield();
+        }
+        recv += n;
+    }
+    for (uint8_t i = 0; i < producers; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    uint64_t t1 = bench_now_ns();
+    
+    printf("  %-8s producers=%-3u %8.0f MB/s\n", sharded ? "sharded" : "mutex",
+           producers, bench_mbps(total, t1 - t0));
+    
+    if (sharded) {
+        ring_buffer_mpsc_deinit(&mpsc);
+    } else {
+        ring_buffer_destroy(&shared);
+    }
+}
+
+#endif /* RING_BUFFER_ENABLE_MPSC */
+
+#if RING_BUFFER_ENABLE_LZ
+
+/**
+ * @brief 压缩记录模式：典型日志行的往返吞吐与压缩率
+ */
+static void bench_lz(bool with_dict)
+{
+    static const char dict[] = "[INFO] net: rx packets= bytes= drops= [WARN] temp sensor reading=C ";
+    static uint8_t storage[16384];
+    static ring_buffer_lz_t lz;
+    ring_buffer_t rb;
+    char line[128];
+    uint8_t out[RING_BUFFER_LZ_MAX_RECORD];
+    const uint32_t lines = 200000;
+    uint64_t bytes = 0;
+    
+    ring_buffer_create(&rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE);
+    ring_buffer_lz_init(&lz, &rb, with_dict ? (const uint8_t *)dict : NULL,
+                        with_dict ? (uint16_t)(sizeof(dict) - 1) : 0);
+    
+    uint64_t t0 = bench_now_ns();
+    for (uint32_t i = 0; i < lines; i++) {
+        int n = snprintf(line, sizeof(line), "[INFO] net: eth%u rx packets=%lu bytes=%lu drops=0",
+                         (unsigned)(i & 3U), (unsigned long)(i * 3U), (unsigned long)(i * 1500U));
+        ring_buffer_lz_write(&lz, (const uint8_t *)line, (ring_buffer_size_t)n);
+        ring_buffer_lz_read(&lz, out, sizeof(out));
+        bytes += (uint64_t)n;
+    }
+    uint64_t t1 = bench_now_ns();
+    
+    printf("  dict=%-3s %8.0f MB/s  ratio=%lu.%02lux\n", with_dict ? "yes" : "no",
+           bench_mbps(bytes, t1 - t0), (unsigned long)(ring_buffer_lz_ratio(&lz) / 100U),
+           (unsigned long)(ring_buffer_lz_ratio(&lz) % 100U));
+    
+    ring_buffer_destroy(&rb);
+}
+
+#endif /* RING_BUFFER_ENABLE_LZ */
+
+#if RING_BUFFER_ENABLE_SPINLOCK
+
+#define BENCH_LOCK_MSG    16
+#define BENCH_LOCK_OPS    200000UL
+
+static void *bench_lock_worker(void *arg)
+{
+    ring_buffer_t *rb = (ring_buffer_t *)arg;
+    uint8_t msg[BENCH_LOCK_MSG];
+    
+    memset(msg, 0x77, sizeof(msg));
+    for (uint32_t i = 0; i < BENCH_LOCK_OPS; i++) {
+        ring_buffer_write_multi(rb, msg, sizeof(msg));
+        ring_buffer_read_multi(rb, msg, sizeof(msg));
+    }
+    return NULL;
+}
+
+/**
+ * @brief 多线程争用同一缓冲区：每个线程交替写入/读出小消息
+ */
+static void bench_lock(ring_buffer_type_t type, uint8_t threads)
+{
+    static uint8_t storage[4096];
+    ring_buffer_t rb;
+    pthread_t tids[8];
+    
+    if (!ring_buffer_create(&rb, storage, sizeof(storage), type)) {
+        return;
+    }
+    
+    uint64_t t0 = bench_now_ns();
+    for (uint8_t i = 0; i < threads; i++) {
+        pthread_create(&tids[i], NULL, bench_lock_worker, &rb);
+    }
+    for (uint8_t i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    uint64_t t1 = bench_now_ns();
+    
+    uint64_t ops = 2ULL * BENCH_LOCK_OPS * threads;
+    printf("  %-8s threads=%-3u %7.1f ns/op\n", (type == RING_BUFFER_TYPE_SPINLOCK) ? "spinlock" : "mutex",
+           threads, (double)(t1 - t0) / (double)ops);
+    
+    ring_buffer_destroy(&rb);
+}
+
+#endif /* RING_BUFFER_ENABLE_SPINLOCK */
+
+#if RING_BUFFER_ENABLE_HUGEMEM
+
+#define BENCH_MEM_CHUNK   4096U
+
+#if RING_BUFFER_SIZE_32BIT
+#define BENCH_MEM_SIZE    (256UL * 1024UL * 1024UL)
+#else
+#define BENCH_MEM_SIZE    (60UL * 1024UL)
+#endif
+
+static int bench_cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 首圈写入延迟分布：每次写入 4 KB 并读出，数据区每一页都是首次触碰
+ * @param flags 0 = malloc，否则为 ring_buffer_hugemem_alloc 的标志
+ */
+static void bench_hugemem(const char *label, uint8_t flags)
+{
+    static uint32_t lat[BENCH_MEM_SIZE / BENCH_MEM_CHUNK];
+    static uint8_t chunk[BENCH_MEM_CHUNK];
+    ring_buffer_hugemem_t mem;
+    ring_buffer_t rb;
+    uint8_t *buf;
+    
+    uint64_t t0 = bench_now_ns();
+    if (flags) {
+        buf = ring_buffer_hugemem_alloc(&mem, BENCH_MEM_SIZE, RING_BUFFER_HUGEMEM_NODE_LOCAL, flags);
+    } else {
+        buf = (uint8_t *)malloc(BENCH_MEM_SIZE);
+    }
+    uint64_t t_alloc = bench_now_ns() - t0;
+    
+    if (!buf || !ring_buffer_create(&rb, buf, (ring_buffer_size_t)BENCH_MEM_SIZE, RING_BUFFER_TYPE_LOCKFREE)) {
+        printf("  %-22s alloc failed\n", label);
+        return;
+    }
+    
+    uint32_t n = (uint32_t)(sizeof(lat) / sizeof(lat[0])) - 1U;
+    memset(chunk, 0x3C, sizeof(chunk));
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t t = bench_now_ns();
+        ring_buffer_write_multi(&rb, chunk, sizeof(chunk));
+        lat[i] = (uint32_t)(bench_now_ns() - t);
+        ring_buffer_read_multi(&rb, chunk, sizeof(chunk));
+    }
+    
+    qsort(lat, n, sizeof(lat[0]), bench_cmp_u32);
+    printf("  %-22s alloc=%7.1f ms  p50=%6lu  p99=%6lu  p99.9=%6lu  max=%7lu ns\n", label,
+           (double)t_alloc / 1e6, (unsigned long)lat[n / 2], (unsigned long)lat[n * 99U / 100U],
+           (unsigned long)lat[n * 999U / 1000U], (unsigned long)lat[n - 1U]);
+    
+    ring_buffer_destroy(&rb);
+    if (flags) {
+        ring_buffer_hugemem_free(&mem);
+    } else {
+        free(buf);
+    }
+}
+
+#endif /* RING_BUFFER_ENABLE_HUGEMEM */
+
+#if RING_BUFFER_ENABLE_TRACE
+
+#define BENCH_TRACE_BURSTS   200
+#define BENCH_TRACE_BURST    32                 /**< 每次突发的写入次数 */
+#define BENCH_TRACE_PERIOD   2000000ULL         /**< 突发周期（纳秒）*/
+#define BENCH_TRACE_POLL     100000ULL          /**< 消费者轮询周期（纳秒）*/
+#define BENCH_TRACE_READS    (BENCH_TRACE_BURSTS * BENCH_TRACE_PERIOD / BENCH_TRACE_POLL)
+#define BENCH_TRACE_RECS     (BENCH_TRACE_BURSTS * BENCH_TRACE_BURST + BENCH_TRACE_READS)
+
+static ring_buffer_trace_rec_t bench_trace_recs[BENCH_TRACE_RECS];
+static ring_buffer_trace_t bench_trace;
+
+/**
+ * @brief 合成一段突发流量轨迹（代替现场录制），经文件往返后载入
+ * @note 每 2 ms 突发 32 条 64~511 字节的消息，消费者每 100 us 读一次 1 KB
+ */
+static bool bench_trace_make(const char *path)
+{
+    uint32_t n = 0;
+    uint32_t seed = 12345;
+    
+    for (uint32_t b = 0; b < BENCH_TRACE_BURSTS; b++) {
+        for (uint32_t j = 0; j < BENCH_TRACE_BURST; j++) {
+            seed = seed * 1103515245U + 12345U;
+            bench_trace_recs[n].time = b * BENCH_TRACE_PERIOD + j * 1000U;
+            bench_trace_recs[n].len = 64U + (seed >> 16) % 448U;
+            bench_trace_recs[n].done = bench_trace_recs[n].len;
+            n++;
+        }
+    }
+    for (uint32_t k = 0; k < BENCH_TRACE_READS; k++) {
+        bench_trace_recs[n].time = k * BENCH_TRACE_POLL + BENCH_TRACE_POLL / 2U;
+        bench_trace_recs[n].len = 1024U | RING_BUFFER_TRACE_OP_READ;
+        bench_trace_recs[n].done = 1024U;
+        n++;
+    }
+    
+    ring_buffer_trace_init(&bench_trace, bench_trace_recs, BENCH_TRACE_RECS);
+    bench_trace.count = n;
+    bench_trace.ring_size = 4096;
+    
+    return ring_buffer_trace_save(&bench_trace, path) &&
+           ring_buffer_trace_load(&bench_trace, bench_trace_recs, BENCH_TRACE_RECS, path);
+}
+
+/**
+ * @brief 按轨迹重放到指定策略与容量的缓冲区
+ * @param batch 批量发布阈值（0 = 普通无锁模式）
+ */
+static void bench_trace_replay(ring_buffer_size_t size, ring_buffer_size_t batch, uint32_t speed)
+{
+    static uint8_t storage[16384];
+    ring_buffer_trace_result_t res;
+    ring_buffer_t rb;
+    
+    if (batch == 0) {
+        ring_buffer_create(&rb, storage, size, RING_BUFFER_TYPE_LOCKFREE);
+    } else {
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+        ring_buffer_create(&rb, storage, size, RING_BUFFER_TYPE_LOCKFREE_BATCH);
+        ring_buffer_set_batch(&rb, batch, 0);
+#endif
+    }
+    
+    if (!ring_buffer_trace_replay(&bench_trace, &rb, speed, &res)) {
+        printf("  replay failed\n");
+        return;
+    }
+    
+    printf("  %-10s batch=%-4lu size=%-5lu x%-3lu written=%7lu KB  short=%5lu  peak=%5lu  lag=%6lu us\n",
+           (batch == 0) ? "lockfree" : "batch", (unsigned long)batch, (unsigned long)size,
+           (unsigned long)speed, (unsigned long)(res.written / 1024U), (unsigned long)res.short_writes,
+           (unsigned long)res.peak_used, (unsigned long)(res.max_lag_ns / 1000U));
+    
+    ring_buffer_destroy(&rb);
+}
+
+#endif /* RING_BUFFER_ENABLE_TRACE */
+
+#if RING_BUFFER_ENABLE_PIPELINE
+
+#define BENCH_PIPE_CHUNK  4096U
+#define BENCH_PIPE_BYTES  (64UL * 1024UL * 1024UL)
+
+/**
+ * @brief 原样转发到下一级（最后一级直接丢弃）
+ */
+static ring_buffer_size_t bench_pipe_fwd(void *ctx, const ring_buffer_span_t *spans, uint8_t count,
+                                         ring_buffer_t *out)
+{
+    ring_buffer_size_t done = 0;
+    
+    (void)ctx;
+    for (uint8_t i = 0; i < count; i++) {
+        ring_buffer_size_t n = out ? ring_buffer_write_multi(out, spans[i].data, spans[i].len) : spans[i].len;
+        done += n;
+        if (n < spans[i].len) {
+            break;
+        }
+    }
+    return done;
+}
+
+/**
+ * @brief 多级转发流水线吞吐与各级统计
+ */
+static void bench_pipeline(uint8_t stages)
+{
+    static uint8_t chunk[BENCH_PIPE_CHUNK];
+    ring_buffer_pipeline_t pl;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    
+    ring_buffer_pipeline_init(&pl);
+    for (uint8_t i = 0; i < stages; i++) {
+        ring_buffer_pipeline_add_stage(&pl, bench_pipe_fwd, NULL, 16384, (int)(i % cpus));
+    }
+    ring_buffer_pipeline_start(&pl);
+    
+    memset(chunk, 0x7E, sizeof(chunk));
+    uint64_t t0 = bench_now_ns();
+    for (uint64_t sent = 0; sent < BENCH_PIPE_BYTES; ) {
+        ring_buffer_size_t n = ring_buffer_write_multi(&pl.stages[0].in, chunk, sizeof(chunk));
+        if (n == 0) {
+            sched_yield();
+        }
+        sent += n;
+    }
+    ring_buffer_pipeline_stop(&pl, true);
+    uint64_t t1 = bench_now_ns();
+    
+    printf("  stages=%u  %6.0f MB/s\n", stages, bench_mbps(BENCH_PIPE_BYTES, t1 - t0));
+    for (uint8_t i = 0; i < stages; i++) {
+        ring_buffer_stage_stats_t st;
+        ring_buffer_pipeline_stats(&pl, i, &st);
+        printf("    stage %u: avg batch=%5lu B  stalls=%7lu  peak depth=%5lu\n", i,
+               (unsigned long)(st.batches ? st.bytes / st.batches : 0), (unsigned long)st.stalls,
+               (unsigned long)st.peak_depth);
+    }
+    
+    ring_buffer_pipeline_deinit(&pl);
+}
+
+#endif /* RING_BUFFER_ENABLE_PIPELINE */
+
+#if RING_BUFFER_ENABLE_NOTIFY
+
+#define BENCH_NOTIFY_MSG    64
+#define BENCH_NOTIFY_SIZE   16384U
+#define BENCH_NOTIFY_BYTES  (16UL * 1024UL * 1024UL)
+
+typedef struct {
+    ring_buffer_notify_t nt;
+    sem_t data;
+    sem_t space;
+    uint32_t flush_every;                   /**< 每多少条消息刷新一次（0 = 只在末尾刷新）*/
+} bench_notify_t;
+
+static void bench_notify_cb(void *ctx, uint8_t event)
+{
+    bench_notify_t *b = (bench_notify_t *)ctx;
+    sem_post((event == RING_BUFFER_NOTIFY_DATA) ? &b->data : &b->space);
+}
+
+static void *bench_notify_producer(void *arg)
+{
+    bench_notify_t *b = (bench_notify_t *)arg;
+    uint8_t msg[BENCH_NOTIFY_MSG];
+    uint32_t msgs = 0;
+    
+    memset(msg, 0x5A, sizeof(msg));
+    for (uint64_t sent = 0; sent < BENCH_NOTIFY_BYTES; sent += sizeof(msg)) {
+        for (ring_buffer_size_t off = 0; off < sizeof(msg); ) {
+            ring_buffer_size_t n = ring_buffer_notify_write(&b->nt, &msg[off], (ring_buffer_size_t)(sizeof(msg) - off));
+            off += n;
+            if (off < sizeof(msg)) {
+                sem_wait(&b->space);
+            }
+        }
+        if (b->flush_every && ++msgs % b->flush_every == 0) {
+            ring_buffer_notify_flush(&b->nt);
+        }
+    }
+    ring_buffer_notify_flush(&b->nt);
+    return NULL;
+}
+
+/**
+ * @brief 生产者线程逐条写入，消费者被信号量唤醒后读空：比较每次写入都唤醒与水位合并唤醒
+ */
+static void bench_notify(ring_buffer_size_t high, ring_buffer_size_t low, uint32_t flush_every)
+{
+    static uint8_t storage[BENCH_NOTIFY_SIZE];
+    static uint8_t buf[4096];
+    static bench_notify_t b;
+    ring_buffer_t rb;
+    pthread_t producer;
+    uint32_t wakeups = 0;
+    
+    ring_buffer_create(&rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE);
+    sem_init(&b.data, 0, 0);
+    sem_init(&b.space, 0, 0);
+    b.flush_every = flush_every;
+    ring_buffer_notify_init(&b.nt, &rb, high, low, 0, bench_notify_cb, &b);
+    
+    uint64_t t0 = bench_now_ns();
+    pthread_create(&producer, NULL, bench_notify_producer, &b);
+    for (uint64_t got = 0; got < BENCH_NOTIFY_BYTES; ) {
+        sem_wait(&b.data);
+        wakeups++;
+        for (ring_buffer_size_t n; (n = ring_buffer_notify_read(&b.nt, buf, sizeof(buf))) > 0; ) {
+            got += n;
+        }
+    }
+    pthread_join(producer, NULL);
+    uint64_t t1 = bench_now_ns();
+    
+    printf("  high=%-5u flush=%-4lu wakeups=%8lu  space waits=%6lu  %7.1f MB/s\n", high,
+           (unsigned long)flush_every, (unsigned long)wakeups, (unsigned long)b.nt.space_events,
+           bench_mbps(BENCH_NOTIFY_BYTES, t1 - t0));
+    
+    sem_destroy(&b.data);
+    sem_destroy(&b.space);
+    ring_buffer_destroy(&rb);
+}
+
+#endif /* RING_BUFFER_ENABLE_NOTIFY */
+
+/* Main ----------------------------------------------------------------------*/
+
+int main(void)
+{
+    printf("\n========== Ring Buffer Benchmarks ==========\n\n");
+    
+    printf("[lockfree baseline]\n");
+    bench_lockfree_baseline();
+    
+    printf("[static define, 4096-byte ring]\n");
+    bench_static_define();
+    
+    printf("[ring-to-ring transfer, %u-byte rings]\n", BENCH_XFER_SIZE);
+    bench_transfer(64);
+    bench_transfer(1024);
+    bench_transfer(8191);
+    
+#if RING_BUFFER_ENABLE_COPY_ENGINE
+    printf("[copy engine]\n");
+    bench_copy_engine();
+#endif
+    
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+    printf("[spsc %d-byte messages, 2 threads]\n", BENCH_SPSC_MSG);
+    bench_spsc(0);
+    bench_spsc(1);
+    bench_spsc(64);
+    bench_spsc(256);
+    bench_spsc(1024);
+#endif
+    
+#if RING_BUFFER_ENABLE_MPSC
+    printf("[mpsc %d-byte messages, sharded vs mutex]\n", BENCH_MPSC_MSG);
+    for (uint8_t producers = 1; producers <= 8 && producers <= RING_BUFFER_MPSC_MAX_LANES; producers *= 2) {
+        bench_mpsc(producers, true);
+#if RING_BUFFER_ENABLE_MUTEX
+        bench_mpsc(producers, false);
+#endif
+    }
+#endif
+    
+#if RING_BUFFER_ENABLE_LZ
+    printf("[lz log records, write+read round trip]\n");
+    bench_lz(false);
+    bench_lz(true);
+#endif
+    
+#if RING_BUFFER_ENABLE_SPINLOCK
+    printf("[lock strategies, %d-byte write+read per thread]\n", BENCH_LOCK_MSG);
+    /* 票号锁要求线程数不超过核数，超出时持锁者被调度走会造成交接护航 */
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    for (uint8_t threads = 1; threads <= 8 && threads <= cpus; threads *= 2) {
+        bench_lock(RING_BUFFER_TYPE_SPINLOCK, threads);
+#if RING_BUFFER_ENABLE_MUTEX
+        bench_lock(RING_BUFFER_TYPE_MUTEX, threads);
+#endif
+    }
+#endif
+    
+#if RING_BUFFER_ENABLE_HUGEMEM
+    printf("[first-lap %u-byte write latency, %lu KB ring]\n", BENCH_MEM_CHUNK, BENCH_MEM_SIZE / 1024UL);
+    bench_hugemem("malloc", 0);
+    bench_hugemem("thp", RING_BUFFER_HUGEMEM_THP);
+    bench_hugemem("thp+prefault+mlock", RING_BUFFER_HUGEMEM_THP | RING_BUFFER_HUGEMEM_PREFAULT |
+                  RING_BUFFER_HUGEMEM_MLOCK);
+#endif
+    
+#if RING_BUFFER_ENABLE_TRACE
+    printf("[trace replay, %d bursts x %d writes every %llu ms, 1 KB read every %llu us]\n", BENCH_TRACE_BURSTS,
+           BENCH_TRACE_BURST, BENCH_TRACE_PERIOD / 1000000ULL, BENCH_TRACE_POLL / 1000ULL);
+    if (bench_trace_make("/tmp/rb_bench_trace.bin")) {
+        bench_trace_replay(4096, 0, 1);
+        bench_trace_replay(8192, 0, 1);
+        bench_trace_replay(16384, 0, 1);
+        bench_trace_replay(16384, 0, 10);
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+        bench_trace_replay(16384, 256, 1);
+#endif
+        remove("/tmp/rb_bench_trace.bin");
+    }
+#endif
+    
+#if RING_BUFFER_ENABLE_PIPELINE
+    printf("[pipeline, forward %u-byte pushes through N stages]\n", BENCH_PIPE_CHUNK);
+    bench_pipeline(1);
+    bench_pipeline(2);
+    bench_pipeline(4);
+#endif
+    
+#if RING_BUFFER_ENABLE_NOTIFY
+    printf("[notify, %d-byte writes, consumer woken by semaphore]\n", BENCH_NOTIFY_MSG);
+    bench_notify(1, 0, 0);
+    bench_notify(4096, 1024, 64);
+    bench_notify(4096, 1024, 0);
+#endif
+    
+    printf("\n========== Done ==========\n\n");
+    
+    return 0;
+}
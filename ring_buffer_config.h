@@ -21,6 +21,8 @@ extern "C" {
 #define RING_BUFFER_ENABLE_LOCKFREE    1  /**< 无锁模式 */
 #define RING_BUFFER_ENABLE_DISABLE_IRQ 0  /**< 关中断模式 */
 #define RING_BUFFER_ENABLE_MUTEX       0  /**< 互斥锁模式 */
+#define RING_BUFFER_ENABLE_LOCKFREE_BATCH 0  /**< 无锁批量发布模式 */
+#define RING_BUFFER_ENABLE_SPINLOCK    0  /**< 自旋锁模式（多核主机，依赖无锁模式）*/
 
 /**
  * @brief 启用统计功能
@@ -28,6 +30,94 @@ extern "C" {
  */
 #define RING_BUFFER_ENABLE_STATISTICS  0
 
+/**
+ * @brief 启用大块拷贝引擎（流式存储、软件预取、运行时指令集选择）
+ * 面向 x86-64 主机上的大容量流式缓冲区，其他平台退化为 memcpy
+ */
+#define RING_BUFFER_ENABLE_COPY_ENGINE 0
+
+/**
+ * @brief 启用文件描述符直接读写（需要 POSIX readv/writev）
+ */
+#define RING_BUFFER_ENABLE_FD_IO       0
+
+/**
+ * @brief 启用异步写出引擎（Linux io_uring，不可用时退化为线程池 pwrite）
+ * 需要 pthread，建议同时启用 RING_BUFFER_SIZE_32BIT
+ */
+#define RING_BUFFER_ENABLE_AIO         0
+
+/**
+ * @brief 启用文件映射持久化缓冲区（需要 POSIX mmap，依赖无锁模式）
+ */
+#define RING_BUFFER_ENABLE_PERSIST     0
+
+/**
+ * @brief 启用分段队列（段由 malloc 分配并循环复用，依赖无锁模式）
+ */
+#define RING_BUFFER_ENABLE_SEGQ        0
+
+/**
+ * @brief 启用缓冲区池（控制块与存储区从同一 arena 按缓存行对齐分配）
+ */
+#define RING_BUFFER_ENABLE_POOL        0
+
+/**
+ * @brief 启用多优先级通道缓冲区（2~8 个通道共用一个句柄）
+ */
+#define RING_BUFFER_ENABLE_PRIO        0
+
+/**
+ * @brief 启用缓冲区集合（就绪位图，Linux 上支持 futex 阻塞等待）
+ */
+#define RING_BUFFER_ENABLE_SET         0
+
+/**
+ * @brief 启用 Chase-Lev 工作窃取双端队列（需要 GCC/Clang 原子内建函数）
+ */
+#define RING_BUFFER_ENABLE_DEQUE       0
+
+/**
+ * @brief 启用分片多生产者通道（每个生产者独占一条无锁 SPSC 通道，依赖无锁模式）
+ */
+#define RING_BUFFER_ENABLE_MPSC        0
+
+/**
+ * @brief 启用按时间戳归并读取（多个缓冲区中的带时间戳记录按时间顺序输出）
+ */
+#define RING_BUFFER_ENABLE_MERGE       0
+
+/**
+ * @brief 启用压缩记录模式（LZ4 类快速压缩 + 共享字典，提高日志类数据的有效容量）
+ */
+#define RING_BUFFER_ENABLE_LZ          0
+
+/**
+ * @brief 启用快照读取（不移除数据、不加锁，读后校验读指针，被覆盖时重试）
+ */
+#define RING_BUFFER_ENABLE_SNAPSHOT    0
+
+/**
+ * @brief 启用大页/NUMA 存储分配（大容量缓冲区的数据区：大页、绑定节点、锁定并预先缺页，需要 POSIX mmap）
+ */
+#define RING_BUFFER_ENABLE_HUGEMEM     0
+
+/**
+ * @brief 启用读写轨迹录制与回放（记录每次 write_multi/read_multi 的时间与长度，离线重放到任意策略，需要 POSIX）
+ * RAM 开销：每个缓冲区 +4/8 字节（录制器指针），每条记录 16 字节（用户提供）
+ */
+#define RING_BUFFER_ENABLE_TRACE       0
+
+/**
+ * @brief 启用多级流水线运行时（每级一个线程，级间以无锁 SPSC 缓冲区相连，需要 pthread，依赖无锁模式）
+ */
+#define RING_BUFFER_ENABLE_PIPELINE    0
+
+/**
+ * @brief 启用水位通知（高水位/超时/刷新时通知消费者，降到低水位时通知等待空间的生产者，合并唤醒）
+ */
+#define RING_BUFFER_ENABLE_NOTIFY      0
+
 
 /* ============================== 性能调优参数 =============================== */
 
@@ -36,16 +126,153 @@ extern "C" {
  */
 #define RING_BUFFER_MIN_SIZE  2
 
+/**
+ * @brief 缓存行大小（字节），缓冲区池按此对齐
+ */
+#define RING_BUFFER_CACHE_LINE  64
+
+/**
+ * @brief 缓冲区集合：最大成员数（32 的倍数）
+ */
+#define RING_BUFFER_SET_MAX_RINGS  256
+
+/**
+ * @brief 分片多生产者通道：最大生产者数（1~32）
+ */
+#define RING_BUFFER_MPSC_MAX_LANES  16
+
+/**
+ * @brief 时间戳归并：最大缓冲区数（1~255）
+ */
+#define RING_BUFFER_MERGE_MAX_RINGS  16
+
 /**
  * @brief 最大自定义策略数量
  */
 #define RING_BUFFER_MAX_CUSTOM_OPS  4
 
+/**
+ * @brief 使用 32 位长度与索引（缓冲区可超过 64KB）
+ * RAM 开销：每个缓冲区 +6 字节
+ */
+#define RING_BUFFER_SIZE_32BIT  0
+
+/**
+ * @brief 拷贝引擎：单段写入 >= 该字节数时使用非临时（流式）存储
+ * @note 默认值约为常见 L2 容量，应使用 ring_buffer_bench 在目标机器上标定
+ */
+#define RING_BUFFER_COPY_NT_THRESHOLD        (256UL * 1024UL)
+
+/**
+ * @brief 拷贝引擎：单段读取 >= 该字节数时启用软件预取
+ */
+#define RING_BUFFER_COPY_PREFETCH_THRESHOLD  (4UL * 1024UL)
+
+/**
+ * @brief 拷贝引擎：预取距离（字节，建议为缓存行的整数倍）
+ */
+#define RING_BUFFER_COPY_PREFETCH_DISTANCE   512
+
+/**
+ * @brief 异步写出引擎：最多同时在途的写请求数
+ */
+#define RING_BUFFER_AIO_DEPTH        8
+
+/**
+ * @brief 异步写出引擎：单个写请求的最大字节数（在途总量上限 = DEPTH * CHUNK）
+ */
+#define RING_BUFFER_AIO_CHUNK        (64UL * 1024UL)
+
+/**
+ * @brief 异步写出引擎：线程池后端的工作线程数
+ */
+#define RING_BUFFER_AIO_THREADS      4
+
+/**
+ * @brief 批量发布模式：累积多少字节后发布一次读/写指针（创建时的默认值）
+ * 越大吞吐越高、延迟越大；1 = 每次操作都发布（等同无锁模式）
+ * 创建时截断到容量的 1/4（RING_BUFFER_BATCH_LIMIT）
+ */
+#define RING_BUFFER_BATCH_BYTES      64
+
+/**
+ * @brief 批量发布模式：未发布数据的最长滞留时间（时基单位），0 = 不限
+ */
+#define RING_BUFFER_BATCH_MAX_DELAY  0
+
+/**
+ * @brief 批量发布模式：时基，须返回单调递增（可回绕）的 uint32_t
+ * 例如 xTaskGetTickCount()、rt_tick_get()、DWT->CYCCNT
+ */
+#define RING_BUFFER_BATCH_TICKS()    0U
+
+/**
+ * @brief 压缩记录模式：单条记录最大原始长度（字节，<= 32767）
+ * RAM 开销：生产者、消费者各一块同样大小的暂存区
+ */
+#define RING_BUFFER_LZ_MAX_RECORD    1024
+
+/**
+ * @brief 压缩记录模式：哈希表位数（8~16），表项数 = 2^HASH_LOG
+ * RAM 开销：每项 6 字节；越大压缩率越高
+ */
+#define RING_BUFFER_LZ_HASH_LOG      10
+
+/**
+ * @brief 压缩记录模式：统计压缩/解压耗时的时基，须返回单调递增（可回绕）的 uint32_t
+ * 例如 DWT->CYCCNT；0U 表示不统计耗时
+ */
+#define RING_BUFFER_LZ_TICKS()       0U
+
+/**
+ * @brief 自旋锁模式：每个排在前面的等待者对应的 pause 次数（比例退避）
+ */
+#define RING_BUFFER_SPIN_BACKOFF     32
+
+/**
+ * @brief 自旋锁模式：自旋多少轮后让出 CPU（0 = 从不让出）
+ * 线程数可能超过核数时应保留，避免持锁线程被抢占后其他线程空转整个时间片
+ */
+#define RING_BUFFER_SPIN_YIELD_AFTER 64
+
+/**
+ * @brief 快照读取：复制期间数据被消费者释放时的最大重试次数（1~255）
+ */
+#define RING_BUFFER_SNAPSHOT_RETRIES 8
+
+/**
+ * @brief 大页存储：大页大小（字节），透明大页按此对齐，显式大页按此取整
+ */
+#define RING_BUFFER_HUGEMEM_PAGE     (2UL * 1024UL * 1024UL)
+
+/**
+ * @brief 流水线：最大级数（1~32）
+ */
+#define RING_BUFFER_PIPE_MAX_STAGES  8
+
+/**
+ * @brief 流水线：每次交给处理函数的最大字节数（批量取出，1~32767）
+ */
+#define RING_BUFFER_PIPE_DRAIN       4096
+
+/**
+ * @brief 流水线：连续多少轮无进展（输入为空或下游已满）后改为睡眠等待
+ */
+#define RING_BUFFER_PIPE_IDLE_SPINS  64
+
+/**
+ * @brief 水位通知：时基，须返回单调递增（可回绕）的 uint32_t
+ * 例如 xTaskGetTickCount()、rt_tick_get()、DWT->CYCCNT；0U 表示不启用超时通知
+ */
+#define RING_BUFFER_NOTIFY_TICKS()   0U
+
 /* =============================== 编译时检查 =============================== */
 
 #if !RING_BUFFER_ENABLE_LOCKFREE && \
     !RING_BUFFER_ENABLE_DISABLE_IRQ && \
-    !RING_BUFFER_ENABLE_MUTEX
+    !RING_BUFFER_ENABLE_MUTEX && \
+    !RING_BUFFER_ENABLE_LOCKFREE_BATCH && \
+    !RING_BUFFER_ENABLE_SPINLOCK
     #error "至少启用一种线程安全策略"
 #endif
 
@@ -53,6 +280,102 @@ extern "C" {
     #error "RING_BUFFER_MIN_SIZE 必须 >= 2"
 #endif
 
+#if RING_BUFFER_BATCH_BYTES < 1
+    #error "RING_BUFFER_BATCH_BYTES 必须 >= 1"
+#endif
+
+#if RING_BUFFER_AIO_DEPTH < 1 || RING_BUFFER_AIO_DEPTH > 64
+    #error "RING_BUFFER_AIO_DEPTH 必须在 1~64 之间"
+#endif
+
+#if RING_BUFFER_ENABLE_PERSIST && !RING_BUFFER_ENABLE_LOCKFREE
+    #error "持久化缓冲区依赖无锁模式，请启用 RING_BUFFER_ENABLE_LOCKFREE"
+#endif
+
+#if RING_BUFFER_SET_MAX_RINGS < 32 || RING_BUFFER_SET_MAX_RINGS > 65504 || (RING_BUFFER_SET_MAX_RINGS % 32) != 0
+    #error "RING_BUFFER_SET_MAX_RINGS 必须是 32 的倍数且不超过 65504"
+#endif
+
+#if RING_BUFFER_ENABLE_SPINLOCK && !RING_BUFFER_ENABLE_LOCKFREE
+    #error "自旋锁模式复用无锁实现，请启用 RING_BUFFER_ENABLE_LOCKFREE"
+#endif
+
+#if RING_BUFFER_ENABLE_SPINLOCK && !(defined(__GNUC__) || defined(__clang__))
+    #error "自旋锁模式需要 GCC/Clang __atomic 内建函数"
+#endif
+
+#if RING_BUFFER_ENABLE_DEQUE && !(defined(__GNUC__) || defined(__clang__))
+    #error "工作窃取双端队列需要 GCC/Clang __atomic 内建函数"
+#endif
+
+#if RING_BUFFER_MPSC_MAX_LANES < 1 || RING_BUFFER_MPSC_MAX_LANES > 32
+    #error "RING_BUFFER_MPSC_MAX_LANES 必须在 1~32 之间"
+#endif
+
+#if RING_BUFFER_MERGE_MAX_RINGS < 1 || RING_BUFFER_MERGE_MAX_RINGS > 255
+    #error "RING_BUFFER_MERGE_MAX_RINGS 必须在 1~255 之间"
+#endif
+
+#if RING_BUFFER_LZ_MAX_RECORD < 16 || RING_BUFFER_LZ_MAX_RECORD > 32767
+    #error "RING_BUFFER_LZ_MAX_RECORD 必须在 16~32767 之间"
+#endif
+
+#if RING_BUFFER_LZ_HASH_LOG < 8 || RING_BUFFER_LZ_HASH_LOG > 16
+    #error "RING_BUFFER_LZ_HASH_LOG 必须在 8~16 之间"
+#endif
+
+#if RING_BUFFER_SNAPSHOT_RETRIES < 1 || RING_BUFFER_SNAPSHOT_RETRIES > 255
+    #error "RING_BUFFER_SNAPSHOT_RETRIES 必须在 1~255 之间"
+#endif
+
+#if RING_BUFFER_PIPE_MAX_STAGES < 1 || RING_BUFFER_PIPE_MAX_STAGES > 32
+    #error "RING_BUFFER_PIPE_MAX_STAGES 必须在 1~32 之间"
+#endif
+
+#if RING_BUFFER_PIPE_DRAIN < 1 || RING_BUFFER_PIPE_DRAIN > 32767
+    #error "RING_BUFFER_PIPE_DRAIN 必须在 1~32767 之间"
+#endif
+
+#if RING_BUFFER_ENABLE_PIPELINE && !RING_BUFFER_ENABLE_LOCKFREE
+    #error "流水线运行时的级间缓冲区使用无锁模式，请启用 RING_BUFFER_ENABLE_LOCKFREE"
+#endif
+
+#if RING_BUFFER_ENABLE_MPSC && !RING_BUFFER_ENABLE_LOCKFREE
+    #error "分片多生产者通道依赖无锁模式，请启用 RING_BUFFER_ENABLE_LOCKFREE"
+#endif
+
+#if RING_BUFFER_ENABLE_SEGQ && !RING_BUFFER_ENABLE_LOCKFREE
+    #error "分段队列依赖无锁模式，请启用 RING_BUFFER_ENABLE_LOCKFREE"
+#endif
+
+/* =========================== 平台适配：内存序 ============================= */
+
+/**
+ * @brief 读写指针的获取/释放语义访问（批量发布模式使用）
+ * 单核 MCU 上退化为普通 volatile 访问
+ *
+ * RB_FETCH_OR/RB_FETCH_AND 用于多生产者共享的位图（优先级通道），
+ * RB_FETCH_ADD 用于多线程共享的计数器（轨迹录制），返回加之前的值；
+ * 非 GCC 编译器上退化为普通读改写，ISR 与任务同时写入时需自行关中断
+ *
+ * RB_CACHE_ALIGNED 使结构体独占缓存行，避免不同线程的数据伪共享
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define RB_LOAD_ACQUIRE(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define RB_STORE_RELEASE(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define RB_FETCH_OR(p, v)       __atomic_fetch_or((p), (v), __ATOMIC_ACQ_REL)
+    #define RB_FETCH_AND(p, v)      __atomic_fetch_and((p), (v), __ATOMIC_ACQ_REL)
+    #define RB_FETCH_ADD(p, v)      __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+    #define RB_CACHE_ALIGNED        __attribute__((aligned(RING_BUFFER_CACHE_LINE)))
+#else
+    #define RB_LOAD_ACQUIRE(p)      (*(p))
+    #define RB_STORE_RELEASE(p, v)  (*(p) = (v))
+    #define RB_FETCH_OR(p, v)       (*(p) |= (v))
+    #define RB_FETCH_AND(p, v)      (*(p) &= (v))
+    #define RB_FETCH_ADD(p, v)      ((*(p) += (v)) - (v))
+    #define RB_CACHE_ALIGNED
+#endif
+
 /* =========================== 平台适配：中断控制 =========================== */
 
 #if RING_BUFFER_ENABLE_DISABLE_IRQ
@@ -95,6 +418,7 @@ extern "C" {
 /* 选择 RTOS 类型 */
 // #define RTOS_FREERTOS
 // #define RTOS_RTTHREAD
+// #define RTOS_POSIX       /* 主机端 pthread（测试/基准）*/
 
 #ifdef RTOS_FREERTOS
     #include "FreeRTOS.h"
@@ -119,8 +443,30 @@ extern "C" {
     #define MUTEX_DELETE(m)         rt_mutex_delete(m)
     #define MUTEX_IS_VALID(m)       ((m) != RT_NULL)
 
+#elif defined(RTOS_POSIX)
+    #include <pthread.h>
+    #include <stdlib.h>
+    
+    typedef pthread_mutex_t *mutex_t;
+    
+    static inline mutex_t rb_posix_mutex_create(void)
+    {
+        mutex_t m = (mutex_t)malloc(sizeof(*m));
+        if (m && pthread_mutex_init(m, NULL) != 0) {
+            free(m);
+            m = NULL;
+        }
+        return m;
+    }
+    
+    #define MUTEX_CREATE()          rb_posix_mutex_create()
+    #define MUTEX_LOCK(m)           pthread_mutex_lock(m)
+    #define MUTEX_UNLOCK(m)         pthread_mutex_unlock(m)
+    #define MUTEX_DELETE(m)         do { pthread_mutex_destroy(m); free(m); } while (0)
+    #define MUTEX_IS_VALID(m)       ((m) != NULL)
+
 #else
-    #error "未选择 RTOS，请定义 RTOS_FREERTOS 或 RTOS_RTTHREAD 宏"
+    #error "未选择 RTOS，请定义 RTOS_FREERTOS、RTOS_RTTHREAD 或 RTOS_POSIX 宏"
 #endif
 
 #endif /* RING_BUFFER_ENABLE_MUTEX */
@@ -0,0 +1,241 @@
+/**
+ * @file    ring_buffer_copy.c
+ * @brief   环形缓冲区大块拷贝引擎
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - x86-64 主机上的多 MB 流式缓冲区（需启用 RING_BUFFER_SIZE_32BIT）
+ * - 生产者写入后很久才被消费、不希望挤占生产者缓存的数据
+ *
+ * 实现要点：
+ * - 写入超过阈值时使用非临时存储（绕过缓存直写内存），结束时 sfence
+ * - 读取超过阈值时按预取距离提前预取源数据
+ * - 流式内核（SSE2/AVX2/AVX-512）在首次调用时通过 CPUID 选择
+ * - 阈值可在运行时调整，由 ring_buffer_bench 标定
+ *
+ * @note 非 x86-64 平台只保留预取路径，写入退化为 memcpy
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_COPY_ENGINE
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    #include <immintrin.h>
+    #define COPY_USE_X86
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+
+/**
+ * @brief 预取粒度（字节），每拷贝一块预取其后 PREFETCH_DISTANCE 处的同样大小
+ */
+#define COPY_PREFETCH_CHUNK  256
+
+#define COPY_CACHE_LINE      64
+
+/* Private types -------------------------------------------------------------*/
+
+typedef void (*copy_fn_t)(uint8_t *dst, const uint8_t *src, ring_buffer_size_t len);
+
+/* Private variables ---------------------------------------------------------*/
+
+static ring_buffer_size_t copy_nt_threshold = (ring_buffer_size_t)
+    ((RING_BUFFER_COPY_NT_THRESHOLD > RING_BUFFER_SIZE_MAX) ?
+     RING_BUFFER_SIZE_MAX : RING_BUFFER_COPY_NT_THRESHOLD);
+
+static ring_buffer_size_t copy_prefetch_threshold = (ring_buffer_size_t)
+    ((RING_BUFFER_COPY_PREFETCH_THRESHOLD > RING_BUFFER_SIZE_MAX) ?
+     RING_BUFFER_SIZE_MAX : RING_BUFFER_COPY_PREFETCH_THRESHOLD);
+
+/* Private functions ---------------------------------------------------------*/
+
+#ifdef COPY_USE_X86
+
+/**
+ * @brief 拷贝到目标对齐边界，返回已拷贝的字节数
+ */
+static inline ring_buffer_size_t copy_align_head(uint8_t *dst, const uint8_t *src,
+                                                 ring_buffer_size_t len, uintptr_t align)
+{
+    ring_buffer_size_t head = (ring_buffer_size_t)((align - ((uintptr_t)dst & (align - 1))) & (align - 1));
+    if (head > len) {
+        head = len;
+    }
+    memcpy(dst, src, head);
+    return head;
+}
+
+static void copy_nt_sse2(uint8_t *dst, const uint8_t *src, ring_buffer_size_t len)
+{
+    ring_buffer_size_t n = copy_align_head(dst, src, len, 16);
+    dst += n;
+    src += n;
+    len -= n;
+    
+    for (; len >= 64; len -= 64, dst += 64, src += 64) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(const void *)(src + 0));
+        __m128i b = _mm_loadu_si128((const __m128i *)(const void *)(src + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(const void *)(src + 32));
+        __m128i d = _mm_loadu_si128((const __m128i *)(const void *)(src + 48));
+        _mm_stream_si128((__m128i *)(void *)(dst + 0), a);
+        _mm_stream_si128((__m128i *)(void *)(dst + 16), b);
+        _mm_stream_si128((__m128i *)(void *)(dst + 32), c);
+        _mm_stream_si128((__m128i *)(void *)(dst + 48), d);
+    }
+    
+    memcpy(dst, src, len);
+    _mm_sfence();
+}
+
+__attribute__((target("avx2")))
+static void copy_nt_avx2(uint8_t *dst, const uint8_t *src, ring_buffer_size_t len)
+{
+    ring_buffer_size_t n = copy_align_head(dst, src, len, 32);
+    dst += n;
+    src += n;
+    len -= n;
+    
+    for (; len >= 128; len -= 128, dst += 128, src += 128) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(const void *)(src + 0));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(const void *)(src + 32));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(const void *)(src + 64));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(const void *)(src + 96));
+        _mm256_stream_si256((__m256i *)(void *)(dst + 0), a);
+        _mm256_stream_si256((__m256i *)(void *)(dst + 32), b);
+        _mm256_stream_si256((__m256i *)(void *)(dst + 64), c);
+        _mm256_stream_si256((__m256i *)(void *)(dst + 96), d);
+    }
+    
+    memcpy(dst, src, len);
+    _mm_sfence();
+}
+
+__attribute__((target("avx512f")))
+static void copy_nt_avx512(uint8_t *dst, const uint8_t *src, ring_buffer_size_t len)
+{
+    ring_buffer_size_t n = copy_align_head(dst, src, len, 64);
+    dst += n;
+    src += n;
+    len -= n;
+    
+    for (; len >= 128; len -= 128, dst += 128, src += 128) {
+        __m512i a = _mm512_loadu_si512((const void *)(src + 0));
+        __m512i b = _mm512_loadu_si512((const void *)(src + 64));
+        _mm512_stream_si512((void *)(dst + 0), a);
+        _mm512_stream_si512((void *)(dst + 64), b);
+    }
+    
+    memcpy(dst, src, len);
+    _mm_sfence();
+}
+
+static void copy_nt_resolve(uint8_t *dst, const uint8_t *src, ring_buffer_size_t len);
+
+/**
+ * @brief 当前流式内核，首次调用时解析
+ * @note 并发的首次调用可能各自解析一次，结果相同；指针以 release/acquire 原子读写，
+ *       看到已解析的 copy_nt_impl 时 copy_nt_name 也已就绪
+ */
+static copy_fn_t copy_nt_impl = copy_nt_resolve;
+static const char *copy_nt_name = "sse2";
+
+static copy_fn_t copy_nt_select(void)
+{
+    const char *name;
+    copy_fn_t impl;
+    
+    __builtin_cpu_init();
+    
+    if (__builtin_cpu_supports("avx512f")) {
+        name = "avx512";
+        impl = copy_nt_avx512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        name = "avx2";
+        impl = copy_nt_avx2;
+    } else {
+        name = "sse2";
+        impl = copy_nt_sse2;
+    }
+    
+    RB_STORE_RELEASE(&copy_nt_name, name);
+    RB_STORE_RELEASE(&copy_nt_impl, impl);
+    
+    RB_LOG_INFO("Copy engine selected %s kernel", name);
+    return impl;
+}
+
+static void copy_nt_resolve(uint8_t *dst, const uint8_t *src, ring_buffer_size_t len)
+{
+    copy_nt_select()(dst, src, len);
+}
+
+#endif /* COPY_USE_X86 */
+
+/* Exported functions --------------------------------------------------------*/
+
+void ring_buffer_copy_in(void *dst, const void *src, ring_buffer_size_t len)
+{
+#ifdef COPY_USE_X86
+    if (len >= copy_nt_threshold) {
+        copy_fn_t impl = RB_LOAD_ACQUIRE(&copy_nt_impl);
+        impl((uint8_t *)dst, (const uint8_t *)src, len);
+        return;
+    }
+#endif
+    
+    memcpy(dst, src, len);
+}
+
+void ring_buffer_copy_out(void *dst, const void *src, ring_buffer_size_t len)
+{
+#if defined(__GNUC__)
+    if (len >= copy_prefetch_threshold) {
+        uint8_t *d = (uint8_t *)dst;
+        const uint8_t *s = (const uint8_t *)src;
+        
+        /* 最后 PREFETCH_DISTANCE 字节之后不再预取，避免越界访问 */
+        while (len >= COPY_PREFETCH_CHUNK + RING_BUFFER_COPY_PREFETCH_DISTANCE) {
+            for (uint16_t off = 0; off < COPY_PREFETCH_CHUNK; off += COPY_CACHE_LINE) {
+                __builtin_prefetch(s + RING_BUFFER_COPY_PREFETCH_DISTANCE + off, 0, 0);
+            }
+            memcpy(d, s, COPY_PREFETCH_CHUNK);
+            d += COPY_PREFETCH_CHUNK;
+            s += COPY_PREFETCH_CHUNK;
+            len -= COPY_PREFETCH_CHUNK;
+        }
+        
+        memcpy(d, s, len);
+        return;
+    }
+#endif
+    
+    memcpy(dst, src, len);
+}
+
+void ring_buffer_copy_set_threshold(ring_buffer_size_t nt_threshold,
+                                    ring_buffer_size_t prefetch_threshold)
+{
+    copy_nt_threshold = nt_threshold;
+    copy_prefetch_threshold = prefetch_threshold;
+    
+    RB_LOG_INFO("Copy thresholds: nt=%lu, prefetch=%lu",
+                (unsigned long)nt_threshold, (unsigned long)prefetch_threshold);
+}
+
+const char *ring_buffer_copy_kernel_name(void)
+{
+#ifdef COPY_USE_X86
+    if (RB_LOAD_ACQUIRE(&copy_nt_impl) == copy_nt_resolve) {
+        copy_nt_select();
+    }
+    return RB_LOAD_ACQUIRE(&copy_nt_name);
+#else
+    return "memcpy";
+#endif
+}
+
+#endif /* RING_BUFFER_ENABLE_COPY_ENGINE */
@@ -0,0 +1,165 @@
+/**
+ * @file    ring_buffer_deque.c
+ * @brief   Chase-Lev 工作窃取双端队列（定长指针元素）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 任务调度器：所有者线程 LIFO 压入/弹出，空闲线程从另一端 FIFO 窃取
+ * - 替代互斥锁保护的任务队列
+ *
+ * 实现要点：
+ * - 算法与内存序取自 Lê 等人的 C11 版 Chase-Lev（PPoPP 2013）
+ * - 所有者只修改 bottom，窃取者通过 CAS 竞争 top；
+ *   仅剩最后一个元素时所有者也通过 CAS 与窃取者竞争
+ * - 使用调用者提供的存储区（与 ring_buffer_create 相同），容量固定为 2 的幂，不扩容
+ * - 下标为无符号回绕计数，通过有符号差值比较，长期运行不溢出
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_DEQUE
+
+/* Private defines -----------------------------------------------------------*/
+
+#define DQ_LOAD(p, mo)         __atomic_load_n((p), (mo))
+#define DQ_STORE(p, v, mo)     __atomic_store_n((p), (v), (mo))
+#define DQ_FENCE(mo)           __atomic_thread_fence(mo)
+#define DQ_CAS(p, e, v)        __atomic_compare_exchange_n((p), (e), (v), false, \
+                                                           __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline void **dq_slot(const ring_buffer_deque_t *dq, uintptr_t idx)
+{
+    return &dq->slots[idx & dq->mask];
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_deque_create(ring_buffer_deque_t *dq, uint8_t *buffer, uint32_t size)
+{
+    if (!dq || !buffer) {
+        RB_LOG_ERROR("dq or buffer is NULL");
+        return false;
+    }
+    
+    if ((uintptr_t)buffer % sizeof(void *) != 0) {
+        RB_LOG_ERROR("buffer %p not pointer-aligned", (void *)buffer);
+        return false;
+    }
+    
+    uint32_t cap = size / (uint32_t)sizeof(void *);
+    if (cap < 2 || (cap & (cap - 1U)) != 0) {
+        RB_LOG_ERROR("Capacity %lu must be a power of 2 (>= 2)", (unsigned long)cap);
+        return false;
+    }
+    
+    dq->slots = (void **)(void *)buffer;
+    dq->mask = cap - 1U;
+    dq->top = 0;
+    dq->bottom = 0;
+    
+    RB_LOG_INFO("Created deque (capacity=%lu)", (unsigned long)cap);
+    return true;
+}
+
+bool ring_buffer_deque_push(ring_buffer_deque_t *dq, void *task)
+{
+    if (!dq) {
+        RB_LOG_ERROR("dq is NULL");
+        return false;
+    }
+    
+    uintptr_t b = DQ_LOAD(&dq->bottom, __ATOMIC_RELAXED);
+    uintptr_t t = DQ_LOAD(&dq->top, __ATOMIC_ACQUIRE);
+    
+    /* 满时不扩容，由调用者决定就地执行或稍后重试 */
+    if ((intptr_t)(b - t) > (intptr_t)dq->mask) {
+        return false;
+    }
+    
+    DQ_STORE(dq_slot(dq, b), task, __ATOMIC_RELAXED);
+    DQ_FENCE(__ATOMIC_RELEASE);
+    DQ_STORE(&dq->bottom, b + 1U, __ATOMIC_RELAXED);
+    return true;
+}
+
+bool ring_buffer_deque_pop(ring_buffer_deque_t *dq, void **task)
+{
+    if (!dq || !task) {
+        RB_LOG_ERROR("dq or task is NULL");
+        return false;
+    }
+    
+    uintptr_t b = DQ_LOAD(&dq->bottom, __ATOMIC_RELAXED) - 1U;
+    
+    /* 先预留 bottom，再读取 top，与窃取者的 seq_cst 屏障配对 */
+    DQ_STORE(&dq->bottom, b, __ATOMIC_RELAXED);
+    DQ_FENCE(__ATOMIC_SEQ_CST);
+    uintptr_t t = DQ_LOAD(&dq->top, __ATOMIC_RELAXED);
+    
+    if ((intptr_t)(b - t) < 0) {
+        /* 空队列，恢复 bottom */
+        DQ_STORE(&dq->bottom, b + 1U, __ATOMIC_RELAXED);
+        return false;
+    }
+    
+    void *x = DQ_LOAD(dq_slot(dq, b), __ATOMIC_RELAXED);
+    
+    if (b == t) {
+        /* 最后一个元素：与窃取者竞争 top */
+        bool won = DQ_CAS(&dq->top, &t, t + 1U);
+        DQ_STORE(&dq->bottom, b + 1U, __ATOMIC_RELAXED);
+        if (!won) {
+            return false;
+        }
+    }
+    
+    *task = x;
+    return true;
+}
+
+ring_buffer_steal_t ring_buffer_deque_steal(ring_buffer_deque_t *dq, void **task)
+{
+    if (!dq || !task) {
+        RB_LOG_ERROR("dq or task is NULL");
+        return RING_BUFFER_STEAL_EMPTY;
+    }
+    
+    uintptr_t t = DQ_LOAD(&dq->top, __ATOMIC_ACQUIRE);
+    DQ_FENCE(__ATOMIC_SEQ_CST);
+    uintptr_t b = DQ_LOAD(&dq->bottom, __ATOMIC_ACQUIRE);
+    
+    if ((intptr_t)(b - t) <= 0) {
+        return RING_BUFFER_STEAL_EMPTY;
+    }
+    
+    void *x = DQ_LOAD(dq_slot(dq, t), __ATOMIC_RELAXED);
+    
+    if (!DQ_CAS(&dq->top, &t, t + 1U)) {
+        /* 与其他窃取者或所有者竞争失败 */
+        return RING_BUFFER_STEAL_RETRY;
+    }
+    
+    *task = x;
+    return RING_BUFFER_STEAL_OK;
+}
+
+uint32_t ring_buffer_deque_size(const ring_buffer_deque_t *dq)
+{
+    if (!dq) {
+        RB_LOG_ERROR("dq is NULL");
+        return 0;
+    }
+    
+    uintptr_t b = DQ_LOAD(&dq->bottom, __ATOMIC_RELAXED);
+    uintptr_t t = DQ_LOAD(&dq->top, __ATOMIC_RELAXED);
+    intptr_t n = (intptr_t)(b - t);
+    
+    return (n > 0) ? (uint32_t)n : 0U;
+}
+
+#endif /* RING_BUFFER_ENABLE_DEQUE */
@@ -84,7 +84,7 @@ static bool disable_irq_read(ring_buffer_t *rb, uint8_t *data)
     return ret;
 }
 
-static uint16_t disable_irq_write_multi(ring_buffer_t *rb, const uint8_t *data, uint16_t len)
+static ring_buffer_size_t disable_irq_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len)
 {
     /* 关键修复: 必须在关中断前进行参数校验! */
     if (!rb) {
@@ -110,13 +110,13 @@ static uint16_t disable_irq_write_multi(ring_buffer_t *rb, const uint8_t *data,
     irq_state_t state;
     IRQ_SAVE(state);
     
-    uint16_t ret = ring_buffer_lockfree_ops.write_multi(rb, data, len);
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.write_multi(rb, data, len);
     
     IRQ_RESTORE(state);
     return ret;
 }
 
-static uint16_t disable_irq_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t len)
+static ring_buffer_size_t disable_irq_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len)
 {
     /* 关键修复: 必须在关中断前进行参数校验! */
     if (!rb) {
@@ -142,13 +142,71 @@ static uint16_t disable_irq_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_
     irq_state_t state;
     IRQ_SAVE(state);
     
-    uint16_t ret = ring_buffer_lockfree_ops.read_multi(rb, data, len);
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.read_multi(rb, data, len);
     
     IRQ_RESTORE(state);
     return ret;
 }
 
-static uint16_t disable_irq_available(const ring_buffer_t *rb)
+static ring_buffer_size_t disable_irq_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                                ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    /* 关键修复: 必须在关中断前进行参数校验! */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 注意: 回调在关中断状态下执行 */
+    irq_state_t state;
+    IRQ_SAVE(state);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.read_span(rb, len, fn, ctx, flags);
+    
+    IRQ_RESTORE(state);
+    return ret;
+}
+
+static ring_buffer_size_t disable_irq_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                                 ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    /* 关键修复: 必须在关中断前进行参数校验! */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 注意: 回调在关中断状态下执行 */
+    irq_state_t state;
+    IRQ_SAVE(state);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.write_span(rb, len, fn, ctx, flags);
+    
+    IRQ_RESTORE(state);
+    return ret;
+}
+
+static ring_buffer_size_t disable_irq_available(const ring_buffer_t *rb)
 {
     /* 关键修复: 必须在关中断前进行参数校验! */
     if (!rb) {
@@ -159,13 +217,13 @@ static uint16_t disable_irq_available(const ring_buffer_t *rb)
     irq_state_t state;
     IRQ_SAVE(state);
     
-    uint16_t ret = ring_buffer_lockfree_ops.available(rb);
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.available(rb);
     
     IRQ_RESTORE(state);
     return ret;
 }
 
-static uint16_t disable_irq_free_space(const ring_buffer_t *rb)
+static ring_buffer_size_t disable_irq_free_space(const ring_buffer_t *rb)
 {
     /* 关键修复: 必须在关中断前进行参数校验! */
     if (!rb) {
@@ -176,7 +234,7 @@ static uint16_t disable_irq_free_space(const ring_buffer_t *rb)
     irq_state_t state;
     IRQ_SAVE(state);
     
-    uint16_t ret = ring_buffer_lockfree_ops.free_space(rb);
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.free_space(rb);
     
     IRQ_RESTORE(state);
     return ret;
@@ -246,6 +304,8 @@ const ring_buffer_ops_t ring_buffer_disable_irq_ops = {
     .is_empty    = disable_irq_is_empty,
     .is_full     = disable_irq_is_full,
     .clear       = disable_irq_clear,
+    .read_span   = disable_irq_read_span,
+    .write_span  = disable_irq_write_span,
 };
 
 #endif /* RING_BUFFER_ENABLE_DISABLE_IRQ */
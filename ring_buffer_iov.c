@@ -0,0 +1,325 @@
+/**
+ * @file    ring_buffer_iov.c
+ * @brief   环形缓冲区分散/聚集读写与文件描述符直接读写
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 帧头、负载、帧尾分别存放，需要作为一条完整消息写入
+ * - 网络/串口桥接线程在 fd 与缓冲区之间搬运数据
+ * - 路由线程把数据从入口缓冲区搬到某个出口缓冲区
+ *
+ * 实现要点：
+ * - 基于策略的 read_span/write_span 接口，线程安全由所选策略保证
+ * - writev 在一次 write_span 内完成，空间不足整条放弃，写指针只前移一次
+ * - fd 读写对一或两个数据段发起一次 readv()/writev()，内核直接拷贝到/出缓冲区
+ * - 缓冲区间搬运嵌套两层数据段访问：外层的一或两个数据段作为内层的数据块，
+ *   两处环绕点都由 iov_transfer 处理，只拷贝一次
+ *
+ * @note
+ * - splice/vmsplice 不适用：缓冲区是普通用户内存，页面被管道引用期间不能复用，
+ *   readv/writev 已是每个方向一次拷贝
+ * - 互斥锁模式下阻塞 fd 的系统调用在持锁期间执行，建议使用非阻塞 fd
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_FD_IO
+    #include <errno.h>
+    #include <sys/uio.h>
+#endif
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    const ring_buffer_iovec_t *iov;     /**< 调用者数据块 */
+    uint8_t cnt;                        /**< 数据块个数 */
+    ring_buffer_size_t total;           /**< 各块长度之和 */
+} iov_ctx_t;
+
+typedef struct {
+    ring_buffer_t *inner;               /**< 内层缓冲区 */
+    bool inner_is_dst;                  /**< true = 内层为目标缓冲区 */
+} xfer_ctx_t;
+
+#if RING_BUFFER_ENABLE_FD_IO
+typedef struct {
+    int fd;                             /**< 文件描述符 */
+    int32_t ret;                        /**< 系统调用结果 */
+    int err;                            /**< 出错时的 errno */
+} fd_ctx_t;
+#endif
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 计算数据块总长度
+ * @return false=参数错误或总长度超过 RING_BUFFER_SIZE_MAX
+ */
+static bool iov_total(const ring_buffer_iovec_t *iov, uint8_t cnt, ring_buffer_size_t *total)
+{
+    ring_buffer_size_t sum = 0;
+    
+    for (uint8_t i = 0; i < cnt; i++) {
+        if (!iov[i].base && iov[i].len > 0) {
+            RB_LOG_ERROR("iov[%u].base is NULL", i);
+            return false;
+        }
+        
+        if (iov[i].len > RING_BUFFER_SIZE_MAX - sum) {
+            RB_LOG_ERROR("iov total too large");
+            return false;
+        }
+        
+        sum += iov[i].len;
+    }
+    
+    *total = sum;
+    return true;
+}
+
+/**
+ * @brief 在缓冲区数据段与调用者数据块之间顺序拷贝
+ * @param to_ring true=数据块 -> 数据段（写入），false=数据段 -> 数据块（读取）
+ * @return 拷贝的字节数
+ */
+static ring_buffer_size_t iov_transfer(const ring_buffer_span_t *spans, uint8_t count,
+                                       const ring_buffer_iovec_t *iov, uint8_t cnt, bool to_ring)
+{
+    uint8_t si = 0;
+    ring_buffer_size_t soff = 0;
+    ring_buffer_size_t done = 0;
+    
+    for (uint8_t i = 0; i < cnt && si < count; i++) {
+        uint8_t *p = (uint8_t *)iov[i].base;
+        ring_buffer_size_t left = iov[i].len;
+        
+        while (left > 0 && si < count) {
+            ring_buffer_size_t n = spans[si].len - soff;
+            if (n > left) {
+                n = left;
+            }
+            
+            if (to_ring) {
+                RB_COPY_IN(&spans[si].data[soff], p, n);
+            } else {
+                RB_COPY_OUT(p, &spans[si].data[soff], n);
+            }
+            
+            p += n;
+            left -= n;
+            soff += n;
+            done += n;
+            
+            if (soff == spans[si].len) {
+                si++;
+                soff = 0;
+            }
+        }
+    }
+    
+    return done;
+}
+
+static ring_buffer_size_t writev_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    iov_ctx_t *ic = (iov_ctx_t *)ctx;
+    ring_buffer_size_t room = spans[0].len + ((count > 1) ? spans[1].len : 0);
+    
+    /* 整条消息放不下时不写入任何数据 */
+    if (room < ic->total) {
+        return 0;
+    }
+    
+    return iov_transfer(spans, count, ic->iov, ic->cnt, true);
+}
+
+static ring_buffer_size_t readv_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    iov_ctx_t *ic = (iov_ctx_t *)ctx;
+    
+    return iov_transfer(spans, count, ic->iov, ic->cnt, false);
+}
+
+static ring_buffer_size_t xfer_fill_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    iov_ctx_t *ic = (iov_ctx_t *)ctx;
+    
+    /* 与 writev 不同，空间不足时写入能放下的部分 */
+    return iov_transfer(spans, count, ic->iov, ic->cnt, true);
+}
+
+/**
+ * @brief 外层回调：外层数据段作为数据块，在内层缓冲区的临界区内完成拷贝
+ * @return 实际搬运的字节数（外层指针按此前移）
+ */
+static ring_buffer_size_t xfer_outer_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    xfer_ctx_t *xc = (xfer_ctx_t *)ctx;
+    ring_buffer_iovec_t iov[2];
+    iov_ctx_t ic = {
+        .iov = iov,
+        .cnt = count,
+        .total = 0,
+    };
+    
+    for (uint8_t i = 0; i < count; i++) {
+        iov[i].base = spans[i].data;
+        iov[i].len = spans[i].len;
+        ic.total += spans[i].len;
+    }
+    
+    if (xc->inner_is_dst) {
+        return ring_buffer_write_span(xc->inner, ic.total, xfer_fill_cb, &ic, 0);
+    }
+    return ring_buffer_read_span(xc->inner, ic.total, readv_span_cb, &ic, 0);
+}
+
+#if RING_BUFFER_ENABLE_FD_IO
+
+static ring_buffer_size_t fd_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count, bool fill)
+{
+    fd_ctx_t *fc = (fd_ctx_t *)ctx;
+    struct iovec v[2];
+    ssize_t n;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        v[i].iov_base = spans[i].data;
+        v[i].iov_len = spans[i].len;
+    }
+    
+    do {
+        n = fill ? readv(fc->fd, v, count) : writev(fc->fd, v, count);
+    } while (n < 0 && errno == EINTR);
+    
+    if (n < 0) {
+        fc->err = errno;
+        fc->ret = -1;
+        return 0;
+    }
+    
+    fc->ret = (int32_t)n;
+    return (ring_buffer_size_t)n;
+}
+
+static ring_buffer_size_t fill_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    return fd_span_cb(ctx, spans, count, true);
+}
+
+static ring_buffer_size_t drain_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    return fd_span_cb(ctx, spans, count, false);
+}
+
+#endif /* RING_BUFFER_ENABLE_FD_IO */
+
+/* Exported functions --------------------------------------------------------*/
+
+ring_buffer_size_t ring_buffer_writev(ring_buffer_t *rb, const ring_buffer_iovec_t *iov, uint8_t cnt)
+{
+    if (!iov || cnt == 0) {
+        RB_LOG_ERROR("iov is NULL or empty");
+        return 0;
+    }
+    
+    iov_ctx_t ic = {
+        .iov = iov,
+        .cnt = cnt,
+        .total = 0,
+    };
+    
+    if (!iov_total(iov, cnt, &ic.total)) {
+        return 0;
+    }
+    
+    return ring_buffer_write_span(rb, ic.total, writev_span_cb, &ic, 0);
+}
+
+ring_buffer_size_t ring_buffer_readv(ring_buffer_t *rb, const ring_buffer_iovec_t *iov, uint8_t cnt)
+{
+    if (!iov || cnt == 0) {
+        RB_LOG_ERROR("iov is NULL or empty");
+        return 0;
+    }
+    
+    iov_ctx_t ic = {
+        .iov = iov,
+        .cnt = cnt,
+        .total = 0,
+    };
+    
+    if (!iov_total(iov, cnt, &ic.total)) {
+        return 0;
+    }
+    
+    return ring_buffer_read_span(rb, ic.total, readv_span_cb, &ic, 0);
+}
+
+ring_buffer_size_t ring_buffer_transfer(ring_buffer_t *dst, ring_buffer_t *src, ring_buffer_size_t max)
+{
+    if (!dst || !src) {
+        RB_LOG_ERROR("dst or src is NULL");
+        return 0;
+    }
+    
+    if (dst == src) {
+        RB_LOG_ERROR("dst and src are the same buffer (rb=%p)", (void *)dst);
+        return 0;
+    }
+    
+    /* 按地址顺序嵌套临界区，两个线程反向搬运时加锁顺序一致，不会死锁 */
+    if ((uintptr_t)src < (uintptr_t)dst) {
+        xfer_ctx_t xc = { .inner = dst, .inner_is_dst = true };
+        return ring_buffer_read_span(src, max, xfer_outer_cb, &xc, 0);
+    }
+    
+    xfer_ctx_t xc = { .inner = src, .inner_is_dst = false };
+    return ring_buffer_write_span(dst, max, xfer_outer_cb, &xc, 0);
+}
+
+#if RING_BUFFER_ENABLE_FD_IO
+
+int32_t ring_buffer_fill_from_fd(ring_buffer_t *rb, int fd, ring_buffer_size_t max)
+{
+    fd_ctx_t fc = {
+        .fd = fd,
+        .ret = 0,
+        .err = 0,
+    };
+    
+    ring_buffer_write_span(rb, max, fill_span_cb, &fc, 0);
+    
+    if (fc.ret < 0) {
+        /* 非阻塞 fd 暂无数据/空间是正常情况 */
+        if (fc.err != EAGAIN && fc.err != EWOULDBLOCK) {
+            RB_LOG_WARN("readv failed (fd=%d, errno=%d)", fd, fc.err);
+        }
+        errno = fc.err;
+    }
+    return fc.ret;
+}
+
+int32_t ring_buffer_drain_to_fd(ring_buffer_t *rb, int fd, ring_buffer_size_t max)
+{
+    fd_ctx_t fc = {
+        .fd = fd,
+        .ret = 0,
+        .err = 0,
+    };
+    
+    ring_buffer_read_span(rb, max, drain_span_cb, &fc, 0);
+    
+    if (fc.ret < 0) {
+        /* 非阻塞 fd 暂无数据/空间是正常情况 */
+        if (fc.err != EAGAIN && fc.err != EWOULDBLOCK) {
+            RB_LOG_WARN("writev failed (fd=%d, errno=%d)", fd, fc.err);
+        }
+        errno = fc.err;
+    }
+    return fc.ret;
+}
+
+#endif /* RING_BUFFER_ENABLE_FD_IO */
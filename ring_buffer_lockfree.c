@@ -32,10 +32,10 @@
 /**
  * @brief 计算可读数据量（内部函数，无参数校验）
  */
-static inline uint16_t lockfree_available_internal(const ring_buffer_t *rb)
+static inline ring_buffer_size_t lockfree_available_internal(const ring_buffer_t *rb)
 {
-    uint16_t head = rb->head;
-    uint16_t tail = rb->tail;
+    ring_buffer_size_t head = rb->head;
+    ring_buffer_size_t tail = rb->tail;
     
     if (head >= tail) {
         return head - tail;
@@ -47,7 +47,7 @@ static inline uint16_t lockfree_available_internal(const ring_buffer_t *rb)
 /**
  * @brief 计算剩余空间（内部函数，无参数校验）
  */
-static inline uint16_t lockfree_free_space_internal(const ring_buffer_t *rb)
+static inline ring_buffer_size_t lockfree_free_space_internal(const ring_buffer_t *rb)
 {
     return rb->size - 1 - lockfree_available_internal(rb);
 }
@@ -67,7 +67,7 @@ static bool lockfree_write(ring_buffer_t *rb, uint8_t data)
         return false;
     }
     
-    uint16_t next_head = (rb->head + 1) % rb->size;
+    ring_buffer_size_t next_head = (rb->head + 1) % rb->size;
     
     /* 检查是否已满 */
     if (next_head == rb->tail) {
@@ -124,7 +124,7 @@ static bool lockfree_read(ring_buffer_t *rb, uint8_t *data)
     return true;
 }
 
-static uint16_t lockfree_write_multi(ring_buffer_t *rb, const uint8_t *data, uint16_t len)
+static ring_buffer_size_t lockfree_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len)
 {
     /* 防御性检查 */
     if (!rb) {
@@ -148,8 +148,8 @@ static uint16_t lockfree_write_multi(ring_buffer_t *rb, const uint8_t *data, uin
     }
     
     /* 计算可写入数量 */
-    uint16_t free = lockfree_free_space_internal(rb);
-    uint16_t to_write = (len > free) ? free : len;
+    ring_buffer_size_t free = lockfree_free_space_internal(rb);
+    ring_buffer_size_t to_write = (len > free) ? free : len;
     
     if (to_write == 0) {
 #if RING_BUFFER_ENABLE_STATISTICS
@@ -160,21 +160,21 @@ static uint16_t lockfree_write_multi(ring_buffer_t *rb, const uint8_t *data, uin
     }
     
     /* 快照当前状态，避免在操作过程中被修改 */
-    uint16_t head = rb->head;
-    uint16_t size = rb->size;
+    ring_buffer_size_t head = rb->head;
+    ring_buffer_size_t size = rb->size;
     
     /* 分段写入 */
     if (head + to_write <= size) {
         /* 单段写入 */
-        memcpy(&rb->buffer[head], data, to_write);
+        RB_COPY_IN(&rb->buffer[head], data, to_write);
         rb->head = (head + to_write) % size;
     } else {
         /* 双段写入（环绕） */
-        uint16_t first_chunk = size - head;
-        uint16_t second_chunk = to_write - first_chunk;
+        ring_buffer_size_t first_chunk = size - head;
+        ring_buffer_size_t second_chunk = to_write - first_chunk;
         
-        memcpy(&rb->buffer[head], data, first_chunk);
-        memcpy(&rb->buffer[0], &data[first_chunk], second_chunk);
+        RB_COPY_IN(&rb->buffer[head], data, first_chunk);
+        RB_COPY_IN(&rb->buffer[0], &data[first_chunk], second_chunk);
         
         rb->head = second_chunk;
     }
@@ -195,7 +195,7 @@ static uint16_t lockfree_write_multi(ring_buffer_t *rb, const uint8_t *data, uin
     return to_write;
 }
 
-static uint16_t lockfree_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t len)
+static ring_buffer_size_t lockfree_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len)
 {
     /* 防御性检查 */
     if (!rb) {
@@ -219,8 +219,8 @@ static uint16_t lockfree_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t l
     }
     
     /* 计算可读取数量 */
-    uint16_t available = lockfree_available_internal(rb);
-    uint16_t to_read = (len > available) ? available : len;
+    ring_buffer_size_t available = lockfree_available_internal(rb);
+    ring_buffer_size_t to_read = (len > available) ? available : len;
     
     if (to_read == 0) {
         /* 空缓冲区是正常情况 */
@@ -228,21 +228,21 @@ static uint16_t lockfree_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t l
     }
     
     /* 快照当前状态，避免在操作过程中被修改 */
-    uint16_t tail = rb->tail;
-    uint16_t size = rb->size;
+    ring_buffer_size_t tail = rb->tail;
+    ring_buffer_size_t size = rb->size;
     
     /* 分段读取 */
     if (tail + to_read <= size) {
         /* 单段读取 */
-        memcpy(data, &rb->buffer[tail], to_read);
+        RB_COPY_OUT(data, &rb->buffer[tail], to_read);
         rb->tail = (tail + to_read) % size;
     } else {
         /* 双段读取（环绕） */
-        uint16_t first_chunk = size - tail;
-        uint16_t second_chunk = to_read - first_chunk;
+        ring_buffer_size_t first_chunk = size - tail;
+        ring_buffer_size_t second_chunk = to_read - first_chunk;
         
-        memcpy(data, &rb->buffer[tail], first_chunk);
-        memcpy(&data[first_chunk], &rb->buffer[0], second_chunk);
+        RB_COPY_OUT(data, &rb->buffer[tail], first_chunk);
+        RB_COPY_OUT(&data[first_chunk], &rb->buffer[0], second_chunk);
         
         rb->tail = second_chunk;
     }
@@ -260,7 +260,149 @@ static uint16_t lockfree_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t l
     return to_read;
 }
 
-static uint16_t lockfree_available(const ring_buffer_t *rb)
+static ring_buffer_size_t lockfree_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                             ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 计算可访问数量 */
+    ring_buffer_size_t available = lockfree_available_internal(rb);
+    ring_buffer_size_t to_read = (len > available) ? available : len;
+    
+    if (to_read == 0) {
+        /* 空缓冲区是正常情况 */
+        return 0;
+    }
+    
+    /* 快照当前状态，避免在操作过程中被修改 */
+    ring_buffer_size_t tail = rb->tail;
+    ring_buffer_size_t size = rb->size;
+    
+    /* 拆分数据段 */
+    ring_buffer_span_t spans[2];
+    uint8_t count;
+    
+    if (tail + to_read <= size) {
+        spans[0].data = &rb->buffer[tail];
+        spans[0].len = to_read;
+        count = 1;
+    } else {
+        spans[0].data = &rb->buffer[tail];
+        spans[0].len = size - tail;
+        spans[1].data = &rb->buffer[0];
+        spans[1].len = to_read - spans[0].len;
+        count = 2;
+    }
+    
+    ring_buffer_size_t done = fn(ctx, spans, count);
+    
+    if (done > to_read) {
+        RB_LOG_WARN("Span callback overrun: returned=%u, max=%u", done, to_read);
+        done = to_read;
+    }
+    
+    /* 查看模式不移动读指针 */
+    if (!(flags & RING_BUFFER_SPAN_PEEK) && done > 0) {
+        rb->tail = (tail + done) % size;
+        
+#if RING_BUFFER_ENABLE_STATISTICS
+        rb->read_count += done;
+#endif
+    }
+    
+    return done;
+}
+
+static ring_buffer_size_t lockfree_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                              ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    (void)flags;
+    
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 计算可写入数量 */
+    ring_buffer_size_t free = lockfree_free_space_internal(rb);
+    ring_buffer_size_t to_write = (len > free) ? free : len;
+    
+    if (to_write == 0) {
+#if RING_BUFFER_ENABLE_STATISTICS
+        rb->overflow_count++;
+#endif
+        /* 缓冲区满是正常情况 */
+        return 0;
+    }
+    
+    /* 快照当前状态，避免在操作过程中被修改 */
+    ring_buffer_size_t head = rb->head;
+    ring_buffer_size_t size = rb->size;
+    
+    /* 拆分空闲段 */
+    ring_buffer_span_t spans[2];
+    uint8_t count;
+    
+    if (head + to_write <= size) {
+        spans[0].data = &rb->buffer[head];
+        spans[0].len = to_write;
+        count = 1;
+    } else {
+        spans[0].data = &rb->buffer[head];
+        spans[0].len = size - head;
+        spans[1].data = &rb->buffer[0];
+        spans[1].len = to_write - spans[0].len;
+        count = 2;
+    }
+    
+    ring_buffer_size_t done = fn(ctx, spans, count);
+    
+    if (done > to_write) {
+        RB_LOG_WARN("Span callback overrun: returned=%u, max=%u", done, to_write);
+        done = to_write;
+    }
+    
+    /* 数据写完后再发布写指针 */
+    if (done > 0) {
+        rb->head = (head + done) % size;
+    }
+    
+#if RING_BUFFER_ENABLE_STATISTICS
+    rb->write_count += done;
+    if (to_write < len) {
+        rb->overflow_count++;
+    }
+#endif
+    
+    return done;
+}
+
+static ring_buffer_size_t lockfree_available(const ring_buffer_t *rb)
 {
     /* 防御性检查 */
     if (!rb) {
@@ -271,7 +413,7 @@ static uint16_t lockfree_available(const ring_buffer_t *rb)
     return lockfree_available_internal(rb);
 }
 
-static uint16_t lockfree_free_space(const ring_buffer_t *rb)
+static ring_buffer_size_t lockfree_free_space(const ring_buffer_t *rb)
 {
     /* 防御性检查 */
     if (!rb) {
@@ -335,6 +477,8 @@ const ring_buffer_ops_t ring_buffer_lockfree_ops = {
     .is_empty    = lockfree_is_empty,
     .is_full     = lockfree_is_full,
     .clear       = lockfree_clear,
+    .read_span   = lockfree_read_span,
+    .write_span  = lockfree_write_span,
 };
 
 #endif /* RING_BUFFER_ENABLE_LOCKFREE */
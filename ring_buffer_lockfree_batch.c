@@ -0,0 +1,604 @@
+/**
+ * @file    ring_buffer_lockfree_batch.c
+ * @brief   环形缓冲区无锁批量发布实现
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 多核主机或双核 MCU 上的单生产者单消费者（SPSC）
+ * - 每秒数百万条小消息，读写指针的缓存行在两核间来回迁移成为瓶颈
+ *
+ * 实现要点：
+ * - 生产者在私有的 shadow_head 上累积，满 batch_bytes 字节、超过最长滞留时间、
+ *   写满（含恰好写满）或调用 ring_buffer_flush() 时才发布 head
+ * - 消费者同理累积 shadow_tail，读空（含恰好读空）时立即发布 tail
+ * - batch_bytes 不超过容量的 1/4（RING_BUFFER_BATCH_LIMIT），未发布部分不会占满缓冲区
+ * - 双方私有字段各占一条缓存行（见 ring_buffer_t），只有发布时才写共享的 head/tail
+ * - 双方缓存对方的指针（tail_cache/head_cache），仅在看似满/空时才重新读取
+ * - 发布使用 release 语义，读取对方指针使用 acquire 语义
+ *
+ * 接口语义（按调用方视角）：
+ * - available / is_empty：消费者视角，只统计已发布的数据
+ * - free_space / is_full：生产者视角，只统计已发布的空间
+ *
+ * @warning 禁止多个生产者或多个消费者同时访问
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 从 from 前进到 to 的字节数
+ */
+static inline ring_buffer_size_t batch_distance(const ring_buffer_t *rb,
+                                                ring_buffer_size_t from, ring_buffer_size_t to)
+{
+    if (to >= from) {
+        return to - from;
+    } else {
+        return rb->size - from + to;
+    }
+}
+
+/**
+ * @brief 判断最早未发布的操作是否已超过最长滞留时间
+ */
+static inline bool batch_expired(uint32_t stamp, uint32_t delay)
+{
+    return (delay != 0) && ((uint32_t)(RING_BUFFER_BATCH_TICKS() - stamp) >= delay);
+}
+
+/**
+ * @brief 生产者可写空间，缓存不足 need 时重新读取 tail
+ */
+static inline ring_buffer_size_t batch_producer_free(ring_buffer_t *rb, ring_buffer_size_t need)
+{
+    ring_buffer_size_t free = rb->size - 1 - batch_distance(rb, rb->tail_cache, rb->shadow_head);
+    
+    if (free < need) {
+        rb->tail_cache = RB_LOAD_ACQUIRE(&rb->tail);
+        free = rb->size - 1 - batch_distance(rb, rb->tail_cache, rb->shadow_head);
+    }
+    
+    return free;
+}
+
+/**
+ * @brief 消费者可读数据量，缓存不足 need 时重新读取 head
+ */
+static inline ring_buffer_size_t batch_consumer_available(ring_buffer_t *rb, ring_buffer_size_t need)
+{
+    ring_buffer_size_t available = batch_distance(rb, rb->shadow_tail, rb->head_cache);
+    
+    if (available < need) {
+        rb->head_cache = RB_LOAD_ACQUIRE(&rb->head);
+        available = batch_distance(rb, rb->shadow_tail, rb->head_cache);
+    }
+    
+    return available;
+}
+
+/**
+ * @brief 生产者推进 shadow_head（仅生产者调用）
+ */
+static inline void batch_advance_head(ring_buffer_t *rb, ring_buffer_size_t n)
+{
+    /* 本批第一笔写入，记录时间戳 */
+    if (rb->shadow_head == rb->head) {
+        rb->head_stamp = RING_BUFFER_BATCH_TICKS();
+    }
+    
+    rb->shadow_head = (rb->shadow_head + n) % rb->size;
+}
+
+/**
+ * @brief 消费者推进 shadow_tail（仅消费者调用）
+ */
+static inline void batch_advance_tail(ring_buffer_t *rb, ring_buffer_size_t n)
+{
+    if (rb->shadow_tail == rb->tail) {
+        rb->tail_stamp = RING_BUFFER_BATCH_TICKS();
+    }
+    
+    rb->shadow_tail = (rb->shadow_tail + n) % rb->size;
+}
+
+/**
+ * @brief 按批量策略发布 head（head 只由生产者写，可直接读取）
+ * @note 按缓存判断已写满时强制发布：消费者此时只能看到已发布的数据，
+ *       不发布则双方分别看到“满”与“空”，轮询 is_full/is_empty 的循环会互相等死
+ */
+static inline void batch_commit_head(ring_buffer_t *rb, bool force)
+{
+    ring_buffer_size_t pending = batch_distance(rb, rb->head, rb->shadow_head);
+    
+    if (pending == 0) {
+        return;
+    }
+    
+    if (batch_distance(rb, rb->tail_cache, rb->shadow_head) == rb->size - 1) {
+        force = true;
+    }
+    
+    if (force || pending >= rb->batch_bytes || batch_expired(rb->head_stamp, rb->batch_delay)) {
+        RB_STORE_RELEASE(&rb->head, rb->shadow_head);
+    }
+}
+
+/**
+ * @brief 按批量策略发布 tail（tail 只由消费者写，可直接读取）
+ * @note 按缓存判断已读空时强制发布，理由同 batch_commit_head
+ */
+static inline void batch_commit_tail(ring_buffer_t *rb, bool force)
+{
+    ring_buffer_size_t pending = batch_distance(rb, rb->tail, rb->shadow_tail);
+    
+    if (pending == 0) {
+        return;
+    }
+    
+    if (rb->shadow_tail == rb->head_cache) {
+        force = true;
+    }
+    
+    if (force || pending >= rb->batch_bytes || batch_expired(rb->tail_stamp, rb->batch_delay)) {
+        RB_STORE_RELEASE(&rb->tail, rb->shadow_tail);
+    }
+}
+
+/**
+ * @brief 按起点与长度拆分为一或两个数据段
+ */
+static inline uint8_t batch_split(const ring_buffer_t *rb, ring_buffer_size_t start,
+                                  ring_buffer_size_t len, ring_buffer_span_t spans[2])
+{
+    spans[0].data = &rb->buffer[start];
+    
+    if (start + len <= rb->size) {
+        spans[0].len = len;
+        return 1;
+    }
+    
+    spans[0].len = rb->size - start;
+    spans[1].data = &rb->buffer[0];
+    spans[1].len = len - spans[0].len;
+    return 2;
+}
+
+/* Exported functions (Implementation) ---------------------------------------*/
+
+static bool batch_write(ring_buffer_t *rb, uint8_t data)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return false;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return false;
+    }
+    
+    if (batch_producer_free(rb, 1) == 0) {
+#if RING_BUFFER_ENABLE_STATISTICS
+        rb->overflow_count++;
+#endif
+        /* 写满时发布已累积的数据，让消费者尽快腾出空间 */
+        batch_commit_head(rb, true);
+        return false;
+    }
+    
+    rb->buffer[rb->shadow_head] = data;
+    batch_advance_head(rb, 1);
+    batch_commit_head(rb, false);
+    
+#if RING_BUFFER_ENABLE_STATISTICS
+    rb->write_count++;
+#endif
+    
+    return true;
+}
+
+static bool batch_read(ring_buffer_t *rb, uint8_t *data)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return false;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return false;
+    }
+    
+    if (!data) {
+        RB_LOG_ERROR("data is NULL (rb=%p)", rb);
+        return false;
+    }
+    
+    if (batch_consumer_available(rb, 1) == 0) {
+        /* 读空时发布已累积的空间，让生产者尽快继续写入 */
+        batch_commit_tail(rb, true);
+        return false;
+    }
+    
+    *data = rb->buffer[rb->shadow_tail];
+    batch_advance_tail(rb, 1);
+    batch_commit_tail(rb, false);
+    
+#if RING_BUFFER_ENABLE_STATISTICS
+    rb->read_count++;
+#endif
+    
+    return true;
+}
+
+static ring_buffer_size_t batch_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!data) {
+        RB_LOG_ERROR("data is NULL (rb=%p, len=%u)", rb, len);
+        return 0;
+    }
+    
+    if (len == 0) {
+        RB_LOG_WARN("len is 0");
+        return 0;
+    }
+    
+    /* 计算可写入数量 */
+    ring_buffer_size_t free = batch_producer_free(rb, len);
+    ring_buffer_size_t to_write = (len > free) ? free : len;
+    
+    if (to_write == 0) {
+#if RING_BUFFER_ENABLE_STATISTICS
+        rb->overflow_count++;
+#endif
+        batch_commit_head(rb, true);
+        return 0;
+    }
+    
+    /* 分段写入 */
+    ring_buffer_span_t spans[2];
+    uint8_t count = batch_split(rb, rb->shadow_head, to_write, spans);
+    
+    RB_COPY_IN(spans[0].data, data, spans[0].len);
+    if (count == 2) {
+        RB_COPY_IN(spans[1].data, &data[spans[0].len], spans[1].len);
+    }
+    
+    batch_advance_head(rb, to_write);
+    batch_commit_head(rb, to_write < len);
+    
+#if RING_BUFFER_ENABLE_STATISTICS
+    rb->write_count += to_write;
+    if (to_write < len) {
+        rb->overflow_count++;
+    }
+#endif
+    
+    /* 部分写入时打印警告 */
+    if (to_write < len) {
+        RB_LOG_WARN("Partial write: requested=%u, written=%u, free=%u",
+                    len, to_write, free);
+    }
+    
+    return to_write;
+}
+
+static ring_buffer_size_t batch_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!data) {
+        RB_LOG_ERROR("data is NULL (rb=%p, len=%u)", rb, len);
+        return 0;
+    }
+    
+    if (len == 0) {
+        RB_LOG_WARN("len is 0");
+        return 0;
+    }
+    
+    /* 计算可读取数量 */
+    ring_buffer_size_t available = batch_consumer_available(rb, len);
+    ring_buffer_size_t to_read = (len > available) ? available : len;
+    
+    if (to_read == 0) {
+        batch_commit_tail(rb, true);
+        return 0;
+    }
+    
+    /* 分段读取 */
+    ring_buffer_span_t spans[2];
+    uint8_t count = batch_split(rb, rb->shadow_tail, to_read, spans);
+    
+    RB_COPY_OUT(data, spans[0].data, spans[0].len);
+    if (count == 2) {
+        RB_COPY_OUT(&data[spans[0].len], spans[1].data, spans[1].len);
+    }
+    
+    batch_advance_tail(rb, to_read);
+    batch_commit_tail(rb, to_read < len);
+    
+#if RING_BUFFER_ENABLE_STATISTICS
+    rb->read_count += to_read;
+#endif
+    
+    /* 部分读取时打印警告 */
+    if (to_read < len) {
+        RB_LOG_WARN("Partial read: requested=%u, read=%u, available=%u",
+                    len, to_read, available);
+    }
+    
+    return to_read;
+}
+
+static ring_buffer_size_t batch_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                          ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 计算可访问数量 */
+    ring_buffer_size_t available = batch_consumer_available(rb, len);
+    ring_buffer_size_t to_read = (len > available) ? available : len;
+    
+    if (to_read == 0) {
+        batch_commit_tail(rb, true);
+        return 0;
+    }
+    
+    ring_buffer_span_t spans[2];
+    uint8_t count = batch_split(rb, rb->shadow_tail, to_read, spans);
+    
+    ring_buffer_size_t done = fn(ctx, spans, count);
+    
+    if (done > to_read) {
+        RB_LOG_WARN("Span callback overrun: returned=%u, max=%u", done, to_read);
+        done = to_read;
+    }
+    
+    /* 查看模式不移动读指针 */
+    if (!(flags & RING_BUFFER_SPAN_PEEK) && done > 0) {
+        batch_advance_tail(rb, done);
+        batch_commit_tail(rb, false);
+        
+#if RING_BUFFER_ENABLE_STATISTICS
+        rb->read_count += done;
+#endif
+    }
+    
+    return done;
+}
+
+static ring_buffer_size_t batch_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                           ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    (void)flags;
+    
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 计算可写入数量 */
+    ring_buffer_size_t free = batch_producer_free(rb, len);
+    ring_buffer_size_t to_write = (len > free) ? free : len;
+    
+    if (to_write == 0) {
+#if RING_BUFFER_ENABLE_STATISTICS
+        rb->overflow_count++;
+#endif
+        batch_commit_head(rb, true);
+        return 0;
+    }
+    
+    ring_buffer_span_t spans[2];
+    uint8_t count = batch_split(rb, rb->shadow_head, to_write, spans);
+    
+    ring_buffer_size_t done = fn(ctx, spans, count);
+    
+    if (done > to_write) {
+        RB_LOG_WARN("Span callback overrun: returned=%u, max=%u", done, to_write);
+        done = to_write;
+    }
+    
+    if (done > 0) {
+        batch_advance_head(rb, done);
+        batch_commit_head(rb, to_write < len);
+    }
+    
+#if RING_BUFFER_ENABLE_STATISTICS
+    rb->write_count += done;
+    if (to_write < len) {
+        rb->overflow_count++;
+    }
+#endif
+    
+    return done;
+}
+
+static ring_buffer_size_t batch_available(const ring_buffer_t *rb)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    return batch_distance(rb, rb->shadow_tail, RB_LOAD_ACQUIRE(&rb->head));
+}
+
+static ring_buffer_size_t batch_free_space(const ring_buffer_t *rb)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    return rb->size - 1 - batch_distance(rb, RB_LOAD_ACQUIRE(&rb->tail), rb->shadow_head);
+}
+
+static bool batch_is_empty(const ring_buffer_t *rb)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return true;  /* 返回 true 防止误操作 */
+    }
+    
+    return (rb->shadow_tail == RB_LOAD_ACQUIRE(&rb->head));
+}
+
+static bool batch_is_full(const ring_buffer_t *rb)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return false;  /* 返回 false 防止误判 */
+    }
+    
+    return ((rb->shadow_head + 1) % rb->size == RB_LOAD_ACQUIRE(&rb->tail));
+}
+
+static void batch_clear(ring_buffer_t *rb)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return;
+    }
+    
+    /* 与无锁模式一致，由消费者丢弃所有已发布数据 */
+    rb->head_cache = RB_LOAD_ACQUIRE(&rb->head);
+    rb->shadow_tail = rb->head_cache;
+    RB_STORE_RELEASE(&rb->tail, rb->shadow_tail);
+    
+#if RING_BUFFER_ENABLE_STATISTICS
+    rb->write_count = 0;
+    rb->read_count = 0;
+    rb->overflow_count = 0;
+#endif
+    
+    RB_LOG_INFO("Lockfree_batch buffer cleared");
+}
+
+static void batch_flush(ring_buffer_t *rb, uint8_t flags)
+{
+    /* 防御性检查 */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return;
+    }
+    
+    if (flags & RING_BUFFER_FLUSH_WRITE) {
+        batch_commit_head(rb, true);
+    }
+    
+    if (flags & RING_BUFFER_FLUSH_READ) {
+        batch_commit_tail(rb, true);
+    }
+}
+
+/* Exported constant ---------------------------------------------------------*/
+
+const ring_buffer_ops_t ring_buffer_lockfree_batch_ops = {
+    .write       = batch_write,
+    .read        = batch_read,
+    .write_multi = batch_write_multi,
+    .read_multi  = batch_read_multi,
+    .available   = batch_available,
+    .free_space  = batch_free_space,
+    .is_empty    = batch_is_empty,
+    .is_full     = batch_is_full,
+    .clear       = batch_clear,
+    .read_span   = batch_read_span,
+    .write_span  = batch_write_span,
+    .flush       = batch_flush,
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_set_batch(ring_buffer_t *rb, ring_buffer_size_t bytes, uint32_t max_delay)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return false;
+    }
+    
+    if (rb->ops != &ring_buffer_lockfree_batch_ops) {
+        RB_LOG_ERROR("Not a lockfree_batch buffer (rb=%p)", rb);
+        return false;
+    }
+    
+    if (bytes == 0) {
+        RB_LOG_ERROR("batch bytes is 0");
+        return false;
+    }
+    
+    if (bytes > RING_BUFFER_BATCH_LIMIT(rb->size)) {
+        RB_LOG_WARN("batch bytes %u too large for size %u, clamped to %u",
+                    bytes, rb->size, (unsigned)RING_BUFFER_BATCH_LIMIT(rb->size));
+        bytes = RING_BUFFER_BATCH_LIMIT(rb->size);
+    }
+    
+    rb->batch_bytes = bytes;
+    rb->batch_delay = max_delay;
+    
+    RB_LOG_INFO("Batch set: bytes=%u, max_delay=%lu", bytes, (unsigned long)max_delay);
+    return true;
+}
+
+#endif /* RING_BUFFER_ENABLE_LOCKFREE_BATCH */
@@ -0,0 +1,489 @@
+/**
+ * @file    ring_buffer_lz.c
+ * @brief   压缩记录模式（LZ4 类快速压缩 + 共享字典）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 日志、遥测等高度重复的文本数据，突发时缓冲区溢出
+ * - 不增加 RAM 的前提下提高有效容量
+ *
+ * 记录格式：
+ * - [uint16_t 存储长度][uint16_t 原始长度][负载]，一次发布
+ * - 压缩后不短于原始数据时原样存储（存储长度 == 原始长度）
+ *
+ * 压缩格式（与 LZ4 块格式相同的序列编码，不兼容 LZ4 帧格式）：
+ * - 序列 = [token: 字面量长度 4 位 | 匹配长度-4 4 位][扩展长度][字面量][偏移 2 字节][扩展长度]
+ * - 最后一个序列只有字面量
+ * - 偏移可越过记录起点指向共享字典末尾，短记录也能匹配到常见片段
+ *
+ * 实现要点：
+ * - 每条记录独立解压，丢弃或跳过任意记录不影响后续记录
+ * - 记录内哈希表按压缩流位置记录，不在本记录内的表项自动失效，无需每条记录清表
+ * - 字典哈希表初始化时建立，记录内未命中时回退查字典
+ * - 解压对偏移、长度做边界检查，损坏数据不会越界
+ *
+ * @note 生产者、消费者各自只能有一个（与底层策略的线程安全要求相同）
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_LZ
+
+/* Private defines -----------------------------------------------------------*/
+
+#define LZ_MINMATCH     4U
+#define LZ_MAX_OFFSET   0xFFFFU
+#define LZ_HASH_SIZE    (1U << RING_BUFFER_LZ_HASH_LOG)
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    uint8_t hdr[RING_BUFFER_LZ_HDR_SIZE]; /**< 记录头 */
+    const uint8_t *data;                /**< 负载 */
+    uint32_t total;                     /**< 记录头 + 负载长度 */
+} lz_put_ctx_t;
+
+typedef struct {
+    ring_buffer_span_t spans[2];        /**< 可读数据段 */
+    uint8_t count;                      /**< 数据段数量 */
+    uint32_t total;                     /**< 可读字节数 */
+} lz_peek_ctx_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline uint32_t lz_read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t lz_hash(uint32_t v)
+{
+    return (uint32_t)(v * 2654435761U) >> (32U - RING_BUFFER_LZ_HASH_LOG);
+}
+
+static inline uint32_t lz_ticks(void)
+{
+    return (uint32_t)(RING_BUFFER_LZ_TICKS());
+}
+
+/**
+ * @brief 写入扩展长度（LZ4 编码：连续 255 直到小于 255 的字节）
+ */
+static inline uint8_t *lz_put_len(uint8_t *op, uint32_t n)
+{
+    while (n >= 255U) {
+        *op++ = 255U;
+        n -= 255U;
+    }
+    *op++ = (uint8_t)n;
+    return op;
+}
+
+/**
+ * @brief 输出一个序列
+ * @param off  匹配偏移，0 表示最后一个只含字面量的序列
+ * @return 新的输出位置，空间不足返回 NULL
+ */
+static uint8_t *lz_emit(uint8_t *op, const uint8_t *oend, const uint8_t *lit, uint32_t lit_len,
+                        uint32_t off, uint32_t match_len)
+{
+    uint32_t ml = (off != 0) ? (match_len - LZ_MINMATCH) : 0;
+    uint32_t need = 1U + lit_len + lit_len / 255U + 1U + ((off != 0) ? (2U + ml / 255U + 1U) : 0U);
+    
+    if (need > (uint32_t)(oend - op)) {
+        return NULL;
+    }
+    
+    uint8_t *token = op++;
+    *token = (uint8_t)(((lit_len >= 15U) ? 15U : lit_len) << 4);
+    if (lit_len >= 15U) {
+        op = lz_put_len(op, lit_len - 15U);
+    }
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+    
+    if (off == 0) {
+        return op;
+    }
+    
+    *op++ = (uint8_t)(off & 0xFFU);
+    *op++ = (uint8_t)(off >> 8);
+    *token |= (uint8_t)((ml >= 15U) ? 15U : ml);
+    if (ml >= 15U) {
+        op = lz_put_len(op, ml - 15U);
+    }
+    return op;
+}
+
+/**
+ * @brief 压缩一条记录
+ * @param cap 输出上限，结果达到上限即放弃（不如原样存储）
+ * @return 压缩后长度，0 表示放弃压缩
+ */
+static uint32_t lz_compress(ring_buffer_lz_t *lz, const uint8_t *src, uint32_t len, uint8_t *dst, uint32_t cap)
+{
+    uint8_t *op = dst;
+    const uint8_t *oend = dst + cap;
+    uint32_t anchor = 0;
+    uint32_t i = 0;
+    
+    /* 流位置即将回绕时清表，避免旧表项被误认为本记录 */
+    if (lz->base > UINT32_MAX - len - 1U) {
+        memset(lz->table, 0, sizeof(lz->table));
+        lz->base = 1;
+    }
+    uint32_t base = lz->base;
+    lz->base += len;
+    
+    while (len >= LZ_MINMATCH && i <= len - LZ_MINMATCH) {
+        uint32_t seq = lz_read32(src + i);
+        uint32_t h = lz_hash(seq);
+        uint32_t cand = lz->table[h];
+        const uint8_t *mp = NULL;
+        const uint8_t *mend = NULL;
+        uint32_t off = 0;
+        
+        lz->table[h] = base + i;
+        
+        if (cand >= base && i - (cand - base) <= LZ_MAX_OFFSET &&
+            lz_read32(src + (cand - base)) == seq) {
+            /* 记录内匹配 */
+            mp = src + (cand - base);
+            mend = src + len;
+            off = i - (cand - base);
+        } else if (lz->dict_table[h] != 0) {
+            /* 回退查字典：偏移越过记录起点 */
+            uint32_t d = lz->dict_table[h] - 1U;
+            off = lz->dict_len - d + i;
+            if (off <= LZ_MAX_OFFSET && lz_read32(lz->dict + d) == seq) {
+                mp = lz->dict + d;
+                mend = lz->dict + lz->dict_len;
+            }
+        }
+        
+        if (!mp) {
+            i++;
+            continue;
+        }
+        
+        uint32_t ml = LZ_MINMATCH;
+        while (i + ml < len && mp + ml < mend && src[i + ml] == mp[ml]) {
+            ml++;
+        }
+        
+        op = lz_emit(op, oend, src + anchor, i - anchor, off, ml);
+        if (!op) {
+            return 0;
+        }
+        i += ml;
+        anchor = i;
+    }
+    
+    op = lz_emit(op, oend, src + anchor, len - anchor, 0, 0);
+    if (!op || op >= oend) {
+        return 0;
+    }
+    return (uint32_t)(op - dst);
+}
+
+/**
+ * @brief 读取扩展长度
+ * @return false=输入越界
+ */
+static inline bool lz_get_len(const uint8_t *src, uint32_t slen, uint32_t *ip, uint32_t *n)
+{
+    uint8_t b;
+    
+    do {
+        if (*ip >= slen) {
+            return false;
+        }
+        b = src[(*ip)++];
+        *n += b;
+    } while (b == 255U);
+    return true;
+}
+
+/**
+ * @brief 解压一条记录
+ * @return 解压后长度，数据损坏返回 -1
+ */
+static int32_t lz_decompress(const ring_buffer_lz_t *lz, const uint8_t *src, uint32_t slen,
+                             uint8_t *dst, uint32_t cap)
+{
+    uint32_t ip = 0;
+    uint32_t op = 0;
+    
+    while (ip < slen) {
+        uint8_t token = src[ip++];
+        uint32_t lit = token >> 4;
+        
+        if (lit == 15U && !lz_get_len(src, slen, &ip, &lit)) {
+            return -1;
+        }
+        if (lit > slen - ip || lit > cap - op) {
+            return -1;
+        }
+        memcpy(dst + op, src + ip, lit);
+        ip += lit;
+        op += lit;
+        
+        if (ip == slen) {
+            break;
+        }
+        
+        if (slen - ip < 2U) {
+            return -1;
+        }
+        uint32_t off = (uint32_t)src[ip] | ((uint32_t)src[ip + 1U] << 8);
+        uint32_t ml = token & 0x0FU;
+        ip += 2U;
+        
+        if (ml == 15U && !lz_get_len(src, slen, &ip, &ml)) {
+            return -1;
+        }
+        ml += LZ_MINMATCH;
+        
+        if (off == 0 || off > op + lz->dict_len || ml > cap - op) {
+            return -1;
+        }
+        
+        if (off <= op && off >= ml) {
+            memcpy(dst + op, dst + op - off, ml);
+            op += ml;
+            continue;
+        }
+        
+        /* 重叠匹配或引用字典：逐字节复制 */
+        for (uint32_t k = 0; k < ml; k++, op++) {
+            dst[op] = (off <= op) ? dst[op - off] : lz->dict[lz->dict_len - (off - op)];
+        }
+    }
+    
+    return (int32_t)op;
+}
+
+static ring_buffer_size_t lz_put_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    lz_put_ctx_t *pc = (lz_put_ctx_t *)ctx;
+    uint32_t pos = 0;
+    
+    for (uint8_t i = 0; i < count && pos < pc->total; i++) {
+        uint8_t *dst = spans[i].data;
+        uint32_t room = spans[i].len;
+        
+        /* 按逻辑位置依次从记录头、负载取数据 */
+        if (pos < RING_BUFFER_LZ_HDR_SIZE) {
+            uint32_t n = RING_BUFFER_LZ_HDR_SIZE - pos;
+            n = (n < room) ? n : room;
+            memcpy(dst, pc->hdr + pos, n);
+            dst += n;
+            room -= n;
+            pos += n;
+        }
+        
+        if (pos >= RING_BUFFER_LZ_HDR_SIZE && room > 0) {
+            uint32_t n = pc->total - pos;
+            n = (n < room) ? n : room;
+            RB_COPY_IN(dst, pc->data + (pos - RING_BUFFER_LZ_HDR_SIZE), n);
+            pos += n;
+        }
+    }
+    return (ring_buffer_size_t)pos;
+}
+
+static ring_buffer_size_t lz_peek_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    lz_peek_ctx_t *pc = (lz_peek_ctx_t *)ctx;
+    
+    pc->count = count;
+    pc->total = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        pc->spans[i] = spans[i];
+        pc->total += spans[i].len;
+    }
+    return (ring_buffer_size_t)pc->total;
+}
+
+static ring_buffer_size_t lz_consume_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    ring_buffer_size_t done = 0;
+    
+    (void)ctx;
+    for (uint8_t i = 0; i < count; i++) {
+        done += spans[i].len;
+    }
+    return done;
+}
+
+/**
+ * @brief 取出记录负载的连续地址（负载环绕时拼接到 rbuf）
+ */
+static const uint8_t *lz_payload(ring_buffer_lz_t *lz, const lz_peek_ctx_t *pc, uint32_t len)
+{
+    uint32_t off = RING_BUFFER_LZ_HDR_SIZE;
+    uint8_t i = 0;
+    
+    if (off >= pc->spans[0].len) {
+        off -= pc->spans[0].len;
+        i = 1;
+    }
+    
+    if (pc->spans[i].len - off >= len) {
+        return pc->spans[i].data + off;
+    }
+    
+    uint32_t first = pc->spans[i].len - off;
+    RB_COPY_OUT(lz->rbuf, pc->spans[i].data + off, first);
+    RB_COPY_OUT(lz->rbuf + first, pc->spans[i + 1].data, len - first);
+    return lz->rbuf;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_lz_init(ring_buffer_lz_t *lz, ring_buffer_t *rb, const uint8_t *dict, uint16_t dict_len)
+{
+    if (!lz || !rb || (!dict && dict_len > 0)) {
+        RB_LOG_ERROR("lz or rb is NULL, or dict is NULL with dict_len=%u", dict_len);
+        return false;
+    }
+    
+    if (dict_len == UINT16_MAX) {
+        RB_LOG_ERROR("dict_len must be < 65535");
+        return false;
+    }
+    
+    memset(lz->table, 0, sizeof(lz->table));
+    memset(lz->dict_table, 0, sizeof(lz->dict_table));
+    memset(&lz->stats, 0, sizeof(lz->stats));
+    lz->rb = rb;
+    lz->dict = dict;
+    lz->dict_len = dict_len;
+    lz->base = 1;
+    
+    /* 同一哈希保留最靠后的位置，偏移更小 */
+    for (uint32_t d = 0; d + LZ_MINMATCH <= dict_len; d++) {
+        lz->dict_table[lz_hash(lz_read32(dict + d))] = (uint16_t)(d + 1U);
+    }
+    
+    RB_LOG_INFO("LZ ring ready (dict=%u bytes, hash=%u entries)", dict_len, LZ_HASH_SIZE);
+    return true;
+}
+
+bool ring_buffer_lz_write(ring_buffer_lz_t *lz, const uint8_t *data, ring_buffer_size_t len)
+{
+    if (!lz || !data) {
+        RB_LOG_ERROR("lz or data is NULL");
+        return false;
+    }
+    
+    if (len == 0 || len > RING_BUFFER_LZ_MAX_RECORD) {
+        RB_LOG_ERROR("len=%u out of range [1, %u]", len, RING_BUFFER_LZ_MAX_RECORD);
+        return false;
+    }
+    
+    uint32_t t0 = lz_ticks();
+    uint32_t clen = lz_compress(lz, data, len, lz->wbuf, len);
+    lz->stats.compress_ticks += (uint32_t)(lz_ticks() - t0);
+    
+    uint16_t stored = (uint16_t)((clen > 0) ? clen : len);
+    uint16_t raw = (uint16_t)len;
+    lz_put_ctx_t pc = {
+        .data = (clen > 0) ? lz->wbuf : data,
+        .total = RING_BUFFER_LZ_HDR_SIZE + stored,
+    };
+    
+    /* 整条记录放得下才写入 */
+    if (ring_buffer_free_space(lz->rb) < pc.total) {
+        lz->stats.dropped++;
+        return false;
+    }
+    
+    memcpy(pc.hdr, &stored, sizeof(stored));
+    memcpy(pc.hdr + sizeof(stored), &raw, sizeof(raw));
+    
+    if (ring_buffer_write_span(lz->rb, (ring_buffer_size_t)pc.total, lz_put_cb, &pc, 0) != pc.total) {
+        lz->stats.dropped++;
+        return false;
+    }
+    
+    lz->stats.records++;
+    lz->stats.raw_bytes += len;
+    lz->stats.stored_bytes += pc.total;
+    return true;
+}
+
+ring_buffer_size_t ring_buffer_lz_read(ring_buffer_lz_t *lz, uint8_t *out, ring_buffer_size_t cap)
+{
+    if (!lz || !out) {
+        RB_LOG_ERROR("lz or out is NULL");
+        return 0;
+    }
+    
+    lz_peek_ctx_t pc = {
+        .count = 0,
+        .total = 0,
+    };
+    uint8_t hdr[RING_BUFFER_LZ_HDR_SIZE];
+    uint16_t stored;
+    uint16_t raw;
+    
+    if (ring_buffer_peek_at(lz->rb, 0, hdr, sizeof(hdr)) < sizeof(hdr)) {
+        return 0;
+    }
+    memcpy(&stored, hdr, sizeof(stored));
+    memcpy(&raw, hdr + sizeof(stored), sizeof(raw));
+    
+    if (raw > cap) {
+        RB_LOG_ERROR("Output too small: record=%u, cap=%u", raw, cap);
+        return 0;
+    }
+    
+    uint32_t total = RING_BUFFER_LZ_HDR_SIZE + stored;
+    ring_buffer_read_span(lz->rb, (ring_buffer_size_t)total, lz_peek_cb, &pc, RING_BUFFER_SPAN_PEEK);
+    if (pc.total < total || stored > RING_BUFFER_LZ_MAX_RECORD) {
+        RB_LOG_ERROR("Invalid record (stored=%u, avail=%lu)", stored, (unsigned long)pc.total);
+        return 0;
+    }
+    
+    const uint8_t *payload = lz_payload(lz, &pc, stored);
+    int32_t n = raw;
+    
+    if (stored == raw) {
+        memcpy(out, payload, raw);
+    } else {
+        uint32_t t0 = lz_ticks();
+        n = lz_decompress(lz, payload, stored, out, raw);
+        lz->stats.decompress_ticks += (uint32_t)(lz_ticks() - t0);
+    }
+    
+    ring_buffer_read_span(lz->rb, (ring_buffer_size_t)total, lz_consume_cb, NULL, 0);
+    
+    /* 损坏记录整条丢弃，后续记录不受影响 */
+    if (n != (int32_t)raw) {
+        RB_LOG_ERROR("Corrupt record dropped (stored=%u, raw=%u)", stored, raw);
+        lz->stats.corrupt++;
+        return 0;
+    }
+    return raw;
+}
+
+uint32_t ring_buffer_lz_ratio(const ring_buffer_lz_t *lz)
+{
+    if (!lz) {
+        RB_LOG_ERROR("lz is NULL");
+        return 0;
+    }
+    
+    if (lz->stats.stored_bytes == 0) {
+        return 100;
+    }
+    return (uint32_t)(lz->stats.raw_bytes * 100U / lz->stats.stored_bytes);
+}
+
+#endif /* RING_BUFFER_ENABLE_LZ */
@@ -0,0 +1,340 @@
+/**
+ * @file    ring_buffer_merge.c
+ * @brief   多缓冲区按时间戳归并读取（k 路归并，零拷贝）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 每个线程/通道一个缓冲区，处理时需要全局时间顺序（日志聚合、回放）
+ * - 替代"全部读出到数组再排序"，不做额外拷贝
+ *
+ * 记录格式：
+ * - [uint32_t 负载长度][uint64_t 时间戳][负载]，由 ring_buffer_merge_put 一次发布
+ *
+ * 实现要点：
+ * - 每个缓冲区的队首记录头载入后放入按时间戳排列的小顶堆，取最早者输出
+ * - 记录负载以数据段形式直接指向缓冲区内部，处理完释放时才移动读指针
+ * - 乱序窗口：所有缓冲区都有队首记录时堆顶一定是最早的；
+ *   有缓冲区暂无数据时，只输出比已见最大时间戳早 window 以上的记录，
+ *   超出窗口晚到的记录仍会输出并计入 late
+ *
+ * @note 每个缓冲区内的记录需按时间戳递增写入；归并读取器只允许一个消费者
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_MERGE
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    uint8_t hdr[RING_BUFFER_MERGE_HDR_SIZE]; /**< 记录头 */
+    const uint8_t *data;                /**< 负载 */
+    uint32_t total;                     /**< 记录头 + 负载长度 */
+} merge_put_ctx_t;
+
+typedef struct {
+    ring_buffer_span_t spans[2];        /**< 可读数据段 */
+    uint8_t count;                      /**< 数据段数量 */
+    uint32_t total;                     /**< 可读字节数 */
+} merge_peek_ctx_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+static ring_buffer_size_t merge_put_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    merge_put_ctx_t *pc = (merge_put_ctx_t *)ctx;
+    uint32_t pos = 0;
+    
+    for (uint8_t i = 0; i < count && pos < pc->total; i++) {
+        uint8_t *dst = spans[i].data;
+        uint32_t room = spans[i].len;
+        
+        /* 按逻辑位置依次从记录头、负载取数据 */
+        if (pos < RING_BUFFER_MERGE_HDR_SIZE) {
+            uint32_t n = RING_BUFFER_MERGE_HDR_SIZE - pos;
+            n = (n < room) ? n : room;
+            memcpy(dst, pc->hdr + pos, n);
+            dst += n;
+            room -= n;
+            pos += n;
+        }
+        
+        if (pos >= RING_BUFFER_MERGE_HDR_SIZE && room > 0) {
+            uint32_t n = pc->total - pos;
+            n = (n < room) ? n : room;
+            RB_COPY_IN(dst, pc->data + (pos - RING_BUFFER_MERGE_HDR_SIZE), n);
+            pos += n;
+        }
+    }
+    return (ring_buffer_size_t)pos;
+}
+
+static ring_buffer_size_t merge_peek_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    merge_peek_ctx_t *pc = (merge_peek_ctx_t *)ctx;
+    
+    pc->count = count;
+    pc->total = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        pc->spans[i] = spans[i];
+        pc->total += spans[i].len;
+    }
+    return (ring_buffer_size_t)pc->total;
+}
+
+static ring_buffer_size_t merge_consume_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    ring_buffer_size_t done = 0;
+    
+    (void)ctx;
+    for (uint8_t i = 0; i < count; i++) {
+        done += spans[i].len;
+    }
+    return done;
+}
+
+/**
+ * @brief 截取逻辑区间 [off, off + len) 对应的数据段
+ * @return 截取后的数据段数量
+ */
+static uint8_t merge_slice(const merge_peek_ctx_t *pc, uint32_t off, uint32_t len, ring_buffer_span_t *out)
+{
+    uint8_t n = 0;
+    
+    for (uint8_t i = 0; i < pc->count && len > 0; i++) {
+        uint32_t seg = pc->spans[i].len;
+        
+        if (off >= seg) {
+            off -= seg;
+            continue;
+        }
+        
+        uint32_t take = seg - off;
+        take = (take < len) ? take : len;
+        out[n].data = pc->spans[i].data + off;
+        out[n].len = (ring_buffer_size_t)take;
+        n++;
+        len -= take;
+        off = 0;
+    }
+    return n;
+}
+
+/**
+ * @brief 堆中两个缓冲区队首的先后（时间戳相同时按缓冲区编号，保证输出稳定）
+ */
+static inline bool merge_before(const ring_buffer_merge_t *m, uint8_t a, uint8_t b)
+{
+    if (m->heads[a].ts != m->heads[b].ts) {
+        return m->heads[a].ts < m->heads[b].ts;
+    }
+    return a < b;
+}
+
+static void merge_heap_push(ring_buffer_merge_t *m, uint8_t ring)
+{
+    uint8_t i = m->heap_len++;
+    
+    while (i > 0) {
+        uint8_t parent = (uint8_t)((i - 1U) / 2U);
+        if (!merge_before(m, ring, m->heap[parent])) {
+            break;
+        }
+        m->heap[i] = m->heap[parent];
+        i = parent;
+    }
+    m->heap[i] = ring;
+}
+
+static void merge_heap_pop(ring_buffer_merge_t *m)
+{
+    uint8_t last = m->heap[--m->heap_len];
+    uint8_t i = 0;
+    
+    for (;;) {
+        uint8_t child = (uint8_t)(2U * i + 1U);
+        if (child >= m->heap_len) {
+            break;
+        }
+        if (child + 1U < m->heap_len && merge_before(m, m->heap[child + 1U], m->heap[child])) {
+            child++;
+        }
+        if (!merge_before(m, m->heap[child], last)) {
+            break;
+        }
+        m->heap[i] = m->heap[child];
+        i = child;
+    }
+    m->heap[i] = last;
+}
+
+/**
+ * @brief 尝试载入缓冲区的队首记录
+ * @return true=完整记录已载入
+ */
+static bool merge_load(ring_buffer_merge_t *m, uint8_t ring)
+{
+    merge_peek_ctx_t pc = {
+        .count = 0,
+        .total = 0,
+    };
+    uint8_t hdr[RING_BUFFER_MERGE_HDR_SIZE];
+    ring_buffer_span_t hs[2];
+    
+    ring_buffer_read_span(m->rings[ring], RING_BUFFER_SIZE_MAX, merge_peek_cb, &pc, RING_BUFFER_SPAN_PEEK);
+    if (pc.total < RING_BUFFER_MERGE_HDR_SIZE) {
+        return false;
+    }
+    
+    /* 记录头可能跨越缓冲区末尾 */
+    uint8_t hn = merge_slice(&pc, 0, RING_BUFFER_MERGE_HDR_SIZE, hs);
+    memcpy(hdr, hs[0].data, hs[0].len);
+    if (hn > 1) {
+        memcpy(hdr + hs[0].len, hs[1].data, hs[1].len);
+    }
+    
+    ring_buffer_merge_rec_t *head = &m->heads[ring];
+    memcpy(&head->len, hdr, sizeof(head->len));
+    memcpy(&head->ts, hdr + sizeof(head->len), sizeof(head->ts));
+    
+    /* 记录头与负载一次发布，头可见时负载必然完整 */
+    if (pc.total - RING_BUFFER_MERGE_HDR_SIZE < head->len) {
+        RB_LOG_ERROR("Ring %u: truncated record (len=%lu, avail=%lu)", ring,
+                     (unsigned long)head->len, (unsigned long)(pc.total - RING_BUFFER_MERGE_HDR_SIZE));
+        return false;
+    }
+    
+    head->count = merge_slice(&pc, RING_BUFFER_MERGE_HDR_SIZE, head->len, head->spans);
+    head->ring = ring;
+    
+    if (head->ts > m->max_seen) {
+        m->max_seen = head->ts;
+    }
+    return true;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_merge_put(ring_buffer_t *rb, uint64_t ts, const uint8_t *data, uint32_t len)
+{
+    if (!rb || (!data && len > 0)) {
+        RB_LOG_ERROR("rb or data is NULL");
+        return false;
+    }
+    
+    if (len > RING_BUFFER_SIZE_MAX - RING_BUFFER_MERGE_HDR_SIZE) {
+        RB_LOG_ERROR("Record too large (len=%lu)", (unsigned long)len);
+        return false;
+    }
+    
+    merge_put_ctx_t pc = {
+        .data = data,
+        .total = len + RING_BUFFER_MERGE_HDR_SIZE,
+    };
+    
+    /* 整条记录放得下才写入，消费者不会看到半条记录 */
+    if (ring_buffer_free_space(rb) < pc.total) {
+        return false;
+    }
+    
+    memcpy(pc.hdr, &len, sizeof(len));
+    memcpy(pc.hdr + sizeof(len), &ts, sizeof(ts));
+    
+    return ring_buffer_write_span(rb, (ring_buffer_size_t)pc.total, merge_put_cb, &pc, 0) == pc.total;
+}
+
+bool ring_buffer_merge_init(ring_buffer_merge_t *m, uint64_t window)
+{
+    if (!m) {
+        RB_LOG_ERROR("m is NULL");
+        return false;
+    }
+    
+    memset(m, 0, sizeof(*m));
+    m->window = window;
+    return true;
+}
+
+int32_t ring_buffer_merge_add(ring_buffer_merge_t *m, ring_buffer_t *rb)
+{
+    if (!m || !rb) {
+        RB_LOG_ERROR("m or rb is NULL");
+        return -1;
+    }
+    
+    if (m->count >= RING_BUFFER_MERGE_MAX_RINGS) {
+        RB_LOG_ERROR("Merge reader full (%u rings)", RING_BUFFER_MERGE_MAX_RINGS);
+        return -1;
+    }
+    
+    m->rings[m->count] = rb;
+    m->loaded[m->count] = false;
+    return m->count++;
+}
+
+bool ring_buffer_merge_next(ring_buffer_merge_t *m, ring_buffer_merge_rec_t *rec, uint8_t flags)
+{
+    if (!m || !rec) {
+        RB_LOG_ERROR("m or rec is NULL");
+        return false;
+    }
+    
+    if (m->pending) {
+        RB_LOG_ERROR("Previous record not released");
+        return false;
+    }
+    
+    /* 补齐尚无队首记录的缓冲区 */
+    if (m->heap_len < m->count) {
+        for (uint8_t i = 0; i < m->count; i++) {
+            if (!m->loaded[i] && merge_load(m, i)) {
+                m->loaded[i] = true;
+                merge_heap_push(m, i);
+            }
+        }
+    }
+    
+    if (m->heap_len == 0) {
+        return false;
+    }
+    
+    const ring_buffer_merge_rec_t *top = &m->heads[m->heap[0]];
+    
+    /* 有缓冲区暂无数据时，其后续记录可能更早，等待到超出乱序窗口 */
+    if (m->heap_len < m->count && !(flags & RING_BUFFER_MERGE_FLUSH) &&
+        m->max_seen - top->ts < m->window) {
+        return false;
+    }
+    
+    if (top->ts < m->last_ts) {
+        m->late++;
+    } else {
+        m->last_ts = top->ts;
+    }
+    
+    *rec = *top;
+    m->pending = true;
+    return true;
+}
+
+void ring_buffer_merge_release(ring_buffer_merge_t *m)
+{
+    if (!m || !m->pending) {
+        RB_LOG_ERROR("m is NULL or no pending record");
+        return;
+    }
+    
+    uint8_t ring = m->heap[0];
+    ring_buffer_size_t total = (ring_buffer_size_t)(m->heads[ring].len + RING_BUFFER_MERGE_HDR_SIZE);
+    
+    ring_buffer_read_span(m->rings[ring], total, merge_consume_cb, NULL, 0);
+    
+    merge_heap_pop(m);
+    m->loaded[ring] = false;
+    m->pending = false;
+}
+
+#endif /* RING_BUFFER_ENABLE_MERGE */
@@ -0,0 +1,277 @@
+/**
+ * @file    ring_buffer_mpsc.c
+ * @brief   分片多生产者单消费者缓冲区（每个生产者独占一条无锁通道）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 多个线程/任务向同一个消费者汇报数据（日志、遥测、事件）
+ * - 互斥锁策略下生产者争用同一把锁和同一组读写指针，线程越多吞吐越低
+ *
+ * 实现要点：
+ * - 每个生产者注册一次，获得一条独立的无锁 SPSC 通道，
+ *   通道控制块按缓存行对齐，生产者之间不共享任何缓存行
+ * - 生产者只在通道由空变非空时置位提示位图，且位已置位时不重复写，
+ *   持续写入时快速路径只访问自己的通道
+ * - 消费者从上次位置之后按轮询顺序服务提示位图中的通道，
+ *   每次从一条通道批量读取，读空后清位并复查
+ * - 提示位图只是"提示"：生产者判断空/非空与消费者清位之间存在竞争，
+ *   因此消费者每轮询一圈（或提示为空时）完整扫描一次通道，补回丢失的位
+ *
+ * @note 每个通道只允许一个生产者；消费者只能有一个
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_MPSC
+
+/* Private defines -----------------------------------------------------------*/
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define MPSC_FETCH_ADD(p, v)    __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#else
+    /* 非 GCC 编译器上注册不是原子的，需在注册时自行互斥 */
+    #define MPSC_FETCH_ADD(p, v)    ((*(p) += (v)) - (v))
+#endif
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    const uint8_t *src;                 /**< 写入：源数据 */
+    uint8_t *dst;                       /**< 读取：目标地址 */
+} mpsc_copy_ctx_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+static ring_buffer_size_t mpsc_copy_in_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    mpsc_copy_ctx_t *cc = (mpsc_copy_ctx_t *)ctx;
+    ring_buffer_size_t done = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        RB_COPY_IN(spans[i].data, cc->src + done, spans[i].len);
+        done += spans[i].len;
+    }
+    return done;
+}
+
+static ring_buffer_size_t mpsc_copy_out_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    mpsc_copy_ctx_t *cc = (mpsc_copy_ctx_t *)ctx;
+    ring_buffer_size_t done = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        RB_COPY_OUT(cc->dst + done, spans[i].data, spans[i].len);
+        done += spans[i].len;
+    }
+    return done;
+}
+
+/**
+ * @brief 已注册的通道数（超出部分的注册已失败）
+ */
+static inline uint8_t mpsc_lane_count(const ring_buffer_mpsc_t *m)
+{
+    uint32_t n = RB_LOAD_ACQUIRE(&m->registered);
+    return (n < m->max_lanes) ? (uint8_t)n : m->max_lanes;
+}
+
+/**
+ * @brief 完整扫描全部通道，补回丢失的提示位
+ * @return 扫描后的提示位图
+ */
+static uint32_t mpsc_rescan(ring_buffer_mpsc_t *m, uint8_t count)
+{
+    uint32_t found = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        if (!ring_buffer_is_empty(&m->lanes[i].rb)) {
+            found |= 1UL << i;
+        }
+    }
+    
+    uint32_t hint = RB_LOAD_ACQUIRE(&m->hint);
+    if (found & ~hint) {
+        hint = RB_FETCH_OR(&m->hint, found) | found;
+    }
+    return hint;
+}
+
+/**
+ * @brief 从 from 开始循环查找第一个置位的通道
+ * @return 通道编号，未找到返回 count
+ */
+static uint8_t mpsc_next_lane(uint32_t mask, uint8_t from, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t lane = (uint8_t)((from + i) % count);
+        if (mask & (1UL << lane)) {
+            return lane;
+        }
+    }
+    return count;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_mpsc_init(ring_buffer_mpsc_t *m, uint8_t *storage,
+                           ring_buffer_size_t lane_size, uint8_t max_lanes)
+{
+    if (!m || !storage) {
+        RB_LOG_ERROR("m or storage is NULL");
+        return false;
+    }
+    
+    if (max_lanes < 1 || max_lanes > RING_BUFFER_MPSC_MAX_LANES) {
+        RB_LOG_ERROR("max_lanes=%u out of range [1, %u]", max_lanes, RING_BUFFER_MPSC_MAX_LANES);
+        return false;
+    }
+    
+    for (uint8_t i = 0; i < max_lanes; i++) {
+        if (!ring_buffer_create(&m->lanes[i].rb, storage + (size_t)i * lane_size,
+                                lane_size, RING_BUFFER_TYPE_LOCKFREE)) {
+            RB_LOG_ERROR("Lane %u create failed", i);
+            while (i > 0) {
+                ring_buffer_destroy(&m->lanes[--i].rb);
+            }
+            return false;
+        }
+    }
+    
+    m->registered = 0;
+    m->max_lanes = max_lanes;
+    m->hint = 0;
+    m->cursor = 0;
+    
+    RB_LOG_INFO("Created MPSC buffer (lanes=%u, lane_size=%u)", max_lanes, lane_size);
+    return true;
+}
+
+void ring_buffer_mpsc_deinit(ring_buffer_mpsc_t *m)
+{
+    if (!m) {
+        RB_LOG_ERROR("Deinit failed: m is NULL");
+        return;
+    }
+    
+    for (uint8_t i = 0; i < m->max_lanes; i++) {
+        ring_buffer_destroy(&m->lanes[i].rb);
+    }
+    m->max_lanes = 0;
+    m->registered = 0;
+    m->hint = 0;
+}
+
+int32_t ring_buffer_mpsc_register(ring_buffer_mpsc_t *m)
+{
+    if (!m) {
+        RB_LOG_ERROR("m is NULL");
+        return -1;
+    }
+    
+    uint32_t idx = MPSC_FETCH_ADD(&m->registered, 1U);
+    
+    if (idx >= m->max_lanes) {
+        RB_LOG_ERROR("No free lane (%u lanes)", m->max_lanes);
+        return -1;
+    }
+    
+    return (int32_t)idx;
+}
+
+ring_buffer_size_t ring_buffer_mpsc_write(ring_buffer_mpsc_t *m, uint8_t lane,
+                                          const uint8_t *data, ring_buffer_size_t len)
+{
+    if (!m || !data || lane >= m->max_lanes) {
+        RB_LOG_ERROR("m or data is NULL, or lane out of range");
+        return 0;
+    }
+    
+    ring_buffer_t *rb = &m->lanes[lane].rb;
+    mpsc_copy_ctx_t cc = {
+        .src = data,
+        .dst = NULL,
+    };
+    bool was_empty = ring_buffer_is_empty(rb);
+    
+    ring_buffer_size_t n = ring_buffer_write_span(rb, len, mpsc_copy_in_cb, &cc, 0);
+    
+    /* 仅在由空变非空时触碰共享位图，已置位时只读不写 */
+    if (n > 0 && was_empty) {
+        uint32_t bit = 1UL << lane;
+        if (!(RB_LOAD_ACQUIRE(&m->hint) & bit)) {
+            RB_FETCH_OR(&m->hint, bit);
+        }
+    }
+    return n;
+}
+
+ring_buffer_size_t ring_buffer_mpsc_read(ring_buffer_mpsc_t *m, uint8_t *data,
+                                         ring_buffer_size_t len, uint8_t *lane)
+{
+    if (!m || !data) {
+        RB_LOG_ERROR("m or data is NULL");
+        return 0;
+    }
+    
+    uint8_t count = mpsc_lane_count(m);
+    if (count == 0 || len == 0) {
+        return 0;
+    }
+    
+    uint32_t hint = RB_LOAD_ACQUIRE(&m->hint);
+    uint8_t sel = mpsc_next_lane(hint, m->cursor, count);
+    
+    /* 提示为空或本次查找回绕到起点之前：完整扫描一次 */
+    if (sel == count || sel < m->cursor) {
+        hint = mpsc_rescan(m, count);
+        sel = mpsc_next_lane(hint, m->cursor, count);
+        if (sel == count) {
+            return 0;
+        }
+    }
+    
+    ring_buffer_t *rb = &m->lanes[sel].rb;
+    mpsc_copy_ctx_t cc = {
+        .src = NULL,
+        .dst = data,
+    };
+    
+    ring_buffer_size_t n = ring_buffer_read_span(rb, len, mpsc_copy_out_cb, &cc, 0);
+    
+    if (ring_buffer_is_empty(rb)) {
+        RB_FETCH_AND(&m->hint, ~(1UL << sel));
+        
+        /* 清位与生产者置位交错时恢复 */
+        if (!ring_buffer_is_empty(rb)) {
+            RB_FETCH_OR(&m->hint, 1UL << sel);
+        }
+    }
+    
+    m->cursor = (uint8_t)((sel + 1U >= count) ? 0U : (sel + 1U));
+    
+    if (lane) {
+        *lane = sel;
+    }
+    return n;
+}
+
+uint32_t ring_buffer_mpsc_available(ring_buffer_mpsc_t *m)
+{
+    if (!m) {
+        RB_LOG_ERROR("m is NULL");
+        return 0;
+    }
+    
+    uint8_t count = mpsc_lane_count(m);
+    uint32_t total = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        total += ring_buffer_available(&m->lanes[i].rb);
+    }
+    return total;
+}
+
+#endif /* RING_BUFFER_ENABLE_MPSC */
@@ -131,7 +131,7 @@ static bool mutex_read(ring_buffer_t *rb, uint8_t *data)
     return ret;
 }
 
-static uint16_t mutex_write_multi(ring_buffer_t *rb, const uint8_t *data, uint16_t len)
+static ring_buffer_size_t mutex_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len)
 {
     /* 关键修复: 必须在加锁前进行参数校验! */
     if (!rb) {
@@ -162,13 +162,13 @@ static uint16_t mutex_write_multi(ring_buffer_t *rb, const uint8_t *data, uint16
     mutex_t mutex = (mutex_t)rb->lock;
     MUTEX_LOCK(mutex);
     
-    uint16_t ret = ring_buffer_lockfree_ops.write_multi(rb, data, len);
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.write_multi(rb, data, len);
     
     MUTEX_UNLOCK(mutex);
     return ret;
 }
 
-static uint16_t mutex_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t len)
+static ring_buffer_size_t mutex_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len)
 {
     /* 关键修复: 必须在加锁前进行参数校验! */
     if (!rb) {
@@ -199,13 +199,81 @@ static uint16_t mutex_read_multi(ring_buffer_t *rb, uint8_t *data, uint16_t len)
     mutex_t mutex = (mutex_t)rb->lock;
     MUTEX_LOCK(mutex);
     
-    uint16_t ret = ring_buffer_lockfree_ops.read_multi(rb, data, len);
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.read_multi(rb, data, len);
     
     MUTEX_UNLOCK(mutex);
     return ret;
 }
 
-static uint16_t mutex_available(const ring_buffer_t *rb)
+static ring_buffer_size_t mutex_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                          ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    /* 关键修复: 必须在加锁前进行参数校验! */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!rb->lock) {
+        RB_LOG_ERROR("lock is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 注意: 回调在持锁状态下执行，不可再访问同一缓冲区 */
+    mutex_t mutex = (mutex_t)rb->lock;
+    MUTEX_LOCK(mutex);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.read_span(rb, len, fn, ctx, flags);
+    
+    MUTEX_UNLOCK(mutex);
+    return ret;
+}
+
+static ring_buffer_size_t mutex_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                           ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    /* 关键修复: 必须在加锁前进行参数校验! */
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!rb->lock) {
+        RB_LOG_ERROR("lock is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 注意: 回调在持锁状态下执行，不可再访问同一缓冲区 */
+    mutex_t mutex = (mutex_t)rb->lock;
+    MUTEX_LOCK(mutex);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.write_span(rb, len, fn, ctx, flags);
+    
+    MUTEX_UNLOCK(mutex);
+    return ret;
+}
+
+static ring_buffer_size_t mutex_available(const ring_buffer_t *rb)
 {
     /* 关键修复: 必须在加锁前进行参数校验! */
     if (!rb) {
@@ -221,13 +289,13 @@ static uint16_t mutex_available(const ring_buffer_t *rb)
     mutex_t mutex = (mutex_t)rb->lock;
     MUTEX_LOCK(mutex);
     
-    uint16_t ret = ring_buffer_lockfree_ops.available(rb);
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.available(rb);
     
     MUTEX_UNLOCK(mutex);
     return ret;
 }
 
-static uint16_t mutex_free_space(const ring_buffer_t *rb)
+static ring_buffer_size_t mutex_free_space(const ring_buffer_t *rb)
 {
     /* 关键修复: 必须在加锁前进行参数校验! */
     if (!rb) {
@@ -243,7 +311,7 @@ static uint16_t mutex_free_space(const ring_buffer_t *rb)
     mutex_t mutex = (mutex_t)rb->lock;
     MUTEX_LOCK(mutex);
     
-    uint16_t ret = ring_buffer_lockfree_ops.free_space(rb);
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.free_space(rb);
     
     MUTEX_UNLOCK(mutex);
     return ret;
@@ -328,6 +396,8 @@ const ring_buffer_ops_t ring_buffer_mutex_ops = {
     .is_empty    = mutex_is_empty,
     .is_full     = mutex_is_full,
     .clear       = mutex_clear,
+    .read_span   = mutex_read_span,
+    .write_span  = mutex_write_span,
 };
 
 #endif /* RING_BUFFER_ENABLE_MUTEX */
@@ -0,0 +1,195 @@
+/**
+ * @file    ring_buffer_notify.c
+ * @brief   水位通知（高/低水位、超时、显式刷新触发，合并唤醒）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 每次写入都唤醒消费者：小包高频时上下文切换开销远大于数据本身
+ * - 只在满时唤醒：低速数据长时间滞留，延迟不可控
+ * - 生产者写满后需要知道何时有足够空间再继续，而不是轮询
+ *
+ * 实现要点：
+ * - 类似网卡中断合并：可读数据达到高水位、首个未读字节等待超过 max_delay、或生产者显式刷新时，
+ *   通知消费者一次；此后直到消费者读取之前不再重复通知
+ * - 对称的 SPACE 事件：写入不足时布防，可读数据降到低水位时通知生产者
+ * - 每个事件一个布防位，以原子“清位并取旧值”认领，同一次布防只会通知一次
+ * - 消费者被通知后须读到缓冲区为空，读空时才重新布防 DATA
+ * - 防止丢失唤醒：消费者读空后先重新布防，再检查触发条件；
+ *   生产者写入不足时先布防，再检查低水位；刷新请求记为标志位，直到下一次 DATA 通知才清除
+ * - 触发条件只依赖 available()，对缓冲区的任何策略都适用
+ *
+ * @note 计时起点是缓冲区由空变为非空的时刻；消费者只读走一部分时不重新计时，
+ *       剩余数据会更早触发超时，延迟上限仍然成立
+ * @note 刷新时数据恰好已被读空，标志位会保留到下一次写入，使其提前通知一次（无害）
+ * @note 生产者停止写入后只有 ring_buffer_notify_poll 能发现超时，须由定时器周期调用
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_NOTIFY
+
+/* Private defines -----------------------------------------------------------*/
+
+#define NOTIFY_FLUSH  0x80U             /**< 刷新请求（与 armed 同字，随 DATA 通知一并清除）*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 认领并触发事件：只有清除布防位的一方调用回调
+ */
+static void notify_fire(ring_buffer_notify_t *nt, uint8_t event)
+{
+    uint8_t clear = (event == RING_BUFFER_NOTIFY_DATA) ? (uint8_t)(event | NOTIFY_FLUSH) : event;
+    
+    if (RB_FETCH_AND(&nt->armed, (uint8_t)~clear) & event) {
+        if (event == RING_BUFFER_NOTIFY_DATA) {
+            nt->data_events++;
+        } else {
+            nt->space_events++;
+        }
+        nt->fn(nt->ctx, event);
+    }
+}
+
+static inline bool notify_expired(const ring_buffer_notify_t *nt)
+{
+    return (nt->max_delay != 0) &&
+           ((uint32_t)(RING_BUFFER_NOTIFY_TICKS() - nt->stamp) >= nt->max_delay);
+}
+
+/**
+ * @brief 检查 DATA 条件：有数据且达到高水位、已超时或有未处理的刷新请求
+ */
+static void notify_check_data(ring_buffer_notify_t *nt)
+{
+    uint8_t armed = RB_LOAD_ACQUIRE(&nt->armed);
+    
+    if (!(armed & RING_BUFFER_NOTIFY_DATA)) {
+        return;
+    }
+    
+    ring_buffer_size_t avail = ring_buffer_available(nt->rb);
+    if (avail > 0 && (avail >= nt->high || (armed & NOTIFY_FLUSH) || notify_expired(nt))) {
+        notify_fire(nt, RING_BUFFER_NOTIFY_DATA);
+    }
+}
+
+static void notify_check_space(ring_buffer_notify_t *nt)
+{
+    if ((RB_LOAD_ACQUIRE(&nt->armed) & RING_BUFFER_NOTIFY_SPACE) &&
+        ring_buffer_available(nt->rb) <= nt->low) {
+        notify_fire(nt, RING_BUFFER_NOTIFY_SPACE);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_notify_init(ring_buffer_notify_t *nt, ring_buffer_t *rb, ring_buffer_size_t high,
+                             ring_buffer_size_t low, uint32_t max_delay,
+                             ring_buffer_notify_fn_t fn, void *ctx)
+{
+    if (!nt || !rb || !fn) {
+        RB_LOG_ERROR("nt, rb or fn is NULL");
+        return false;
+    }
+    
+    if (high == 0 || low >= high) {
+        RB_LOG_ERROR("Invalid watermarks (high=%u, low=%u)", high, low);
+        return false;
+    }
+    
+    if (high > (ring_buffer_size_t)(ring_buffer_available(rb) + ring_buffer_free_space(rb))) {
+        RB_LOG_WARN("high=%u exceeds capacity, only timeout/flush will notify", high);
+    }
+    
+    nt->rb = rb;
+    nt->fn = fn;
+    nt->ctx = ctx;
+    nt->high = high;
+    nt->low = low;
+    nt->max_delay = max_delay;
+    nt->stamp = RING_BUFFER_NOTIFY_TICKS();
+    nt->data_events = 0;
+    nt->space_events = 0;
+    RB_STORE_RELEASE(&nt->armed, (uint8_t)RING_BUFFER_NOTIFY_DATA);
+    
+    return true;
+}
+
+ring_buffer_size_t ring_buffer_notify_write(ring_buffer_notify_t *nt, const uint8_t *data, ring_buffer_size_t len)
+{
+    if (!nt || !nt->rb) {
+        RB_LOG_ERROR("nt is NULL or not initialized");
+        return 0;
+    }
+    
+    if (ring_buffer_available(nt->rb) == 0) {
+        nt->stamp = RING_BUFFER_NOTIFY_TICKS();
+    }
+    
+    ring_buffer_size_t n = ring_buffer_write_multi(nt->rb, data, len);
+    
+    if (n < len) {
+        /* 先布防再检查：消费者在两步之间读走数据也不会错过 */
+        RB_FETCH_OR(&nt->armed, (uint8_t)RING_BUFFER_NOTIFY_SPACE);
+        notify_check_space(nt);
+    }
+    
+    notify_check_data(nt);
+    return n;
+}
+
+ring_buffer_size_t ring_buffer_notify_read(ring_buffer_notify_t *nt, uint8_t *data, ring_buffer_size_t len)
+{
+    if (!nt || !nt->rb) {
+        RB_LOG_ERROR("nt is NULL or not initialized");
+        return 0;
+    }
+    
+    ring_buffer_size_t n = ring_buffer_read_multi(nt->rb, data, len);
+    
+    if (n > 0) {
+        notify_check_space(nt);
+    }
+    
+    /*
+     * 读空后才重新布防（类似 NAPI 轮询结束后才重新开中断），消费者读取期间不会被重复唤醒；
+     * 布防后再检查：读空与布防之间生产者写入的数据不会错过
+     */
+    if (ring_buffer_available(nt->rb) == 0) {
+        RB_FETCH_OR(&nt->armed, (uint8_t)RING_BUFFER_NOTIFY_DATA);
+        notify_check_data(nt);
+    }
+    
+    return n;
+}
+
+void ring_buffer_notify_poll(ring_buffer_notify_t *nt)
+{
+    if (!nt || !nt->rb) {
+        RB_LOG_ERROR("nt is NULL or not initialized");
+        return;
+    }
+    
+    notify_check_data(nt);
+}
+
+void ring_buffer_notify_flush(ring_buffer_notify_t *nt)
+{
+    if (!nt || !nt->rb) {
+        RB_LOG_ERROR("nt is NULL or not initialized");
+        return;
+    }
+    
+    /*
+     * 刷新请求先记下再检查：DATA 未布防说明消费者正在处理，
+     * 其读取后重新布防时会看到该请求，不会丢失
+     */
+    RB_FETCH_OR(&nt->armed, (uint8_t)NOTIFY_FLUSH);
+    notify_check_data(nt);
+}
+
+#endif /* RING_BUFFER_ENABLE_NOTIFY */
@@ -0,0 +1,377 @@
+/**
+ * @file    ring_buffer_persist.c
+ * @brief   环形缓冲区文件映射持久化（崩溃后可恢复）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 跟踪日志、审计记录等进程崩溃后仍需保留的数据
+ * - 重启后继续消费上次未处理完的数据
+ *
+ * 文件布局：
+ * - [0, 4096)          控制块（魔数、版本、容量、写指针、读指针）
+ * - [4096, 4096+size)  数据区
+ *
+ * 实现要点：
+ * - 数据区与控制块均为 MAP_SHARED 映射，底层使用无锁策略（SPSC）
+ * - 写入：数据先写入映射区，再以释放语义更新控制块写指针；
+ *   进程崩溃时页缓存中的内容不会丢失，重新打开即可恢复全部已提交数据
+ * - msync 批量执行：累计写入 sync_bytes 字节后先同步数据区、再同步控制块，
+ *   掉电时最多丢失最近一批未同步的数据
+ * - 重新打开只校验控制块并恢复读写指针，不扫描数据区
+ *
+ * @note
+ * - 读指针随下一次同步落盘，掉电恢复后可能重复投递少量已读数据（至少一次语义）
+ * - 两次同步之间内核可能先回写控制块，掉电后最近一批数据内容不保证有效
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_PERSIST
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Private defines -----------------------------------------------------------*/
+
+#define PERSIST_MAGIC    0x46504252UL    /**< "RBPF" */
+#define PERSIST_VERSION  1U
+#define PERSIST_HDR_SIZE 4096U           /**< 控制块区大小（数据区按页对齐）*/
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 文件内控制块
+ */
+typedef struct {
+    uint32_t magic;                     /**< 魔数，初始化完成后最后写入 */
+    uint32_t version;                   /**< 布局版本 */
+    uint32_t size;                      /**< 数据区大小 */
+    uint32_t head;                      /**< 已提交的写指针 */
+    uint32_t tail;                      /**< 已提交的读指针 */
+} persist_ctl_t;
+
+/* External declarations -----------------------------------------------------*/
+extern const ring_buffer_ops_t ring_buffer_lockfree_ops;
+
+/* Private functions ---------------------------------------------------------*/
+
+#define BASE_OPS  (&ring_buffer_lockfree_ops)
+
+static inline ring_buffer_persist_t *to_persist(ring_buffer_t *rb)
+{
+    return (ring_buffer_persist_t *)rb;
+}
+
+static inline persist_ctl_t *to_ctl(ring_buffer_t *rb)
+{
+    return (persist_ctl_t *)to_persist(rb)->map;
+}
+
+/**
+ * @brief 将 [addr, addr+len) 同步到磁盘（起始地址向下按页对齐）
+ */
+static bool persist_msync(void *addr, size_t len)
+{
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)addr & ~(page - 1U);
+    
+    if (msync((void *)start, len + ((uintptr_t)addr - start), MS_SYNC) != 0) {
+        RB_LOG_WARN("msync failed (errno=%d)", errno);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 先同步数据区，再同步控制块
+ */
+static void persist_sync(ring_buffer_t *rb)
+{
+    ring_buffer_persist_t *pr = to_persist(rb);
+    
+    if (persist_msync(rb->buffer, rb->size)) {
+        persist_msync(pr->map, sizeof(persist_ctl_t));
+    }
+    pr->dirty = 0;
+}
+
+/**
+ * @brief 提交写指针（生产者调用）
+ */
+static void persist_commit_head(ring_buffer_t *rb, ring_buffer_size_t n)
+{
+    ring_buffer_persist_t *pr = to_persist(rb);
+    
+    /* 策略已在数据写入后发布 rb->head，这里按同样顺序更新文件 */
+    RB_STORE_RELEASE(&to_ctl(rb)->head, (uint32_t)rb->head);
+    
+    pr->dirty += n;
+    if (pr->sync_bytes > 0 && pr->dirty >= pr->sync_bytes) {
+        persist_sync(rb);
+    }
+}
+
+/**
+ * @brief 提交读指针（消费者调用）
+ */
+static inline void persist_commit_tail(ring_buffer_t *rb)
+{
+    RB_STORE_RELEASE(&to_ctl(rb)->tail, (uint32_t)rb->tail);
+}
+
+static bool persist_write(ring_buffer_t *rb, uint8_t data)
+{
+    if (!BASE_OPS->write(rb, data)) {
+        return false;
+    }
+    
+    persist_commit_head(rb, 1);
+    return true;
+}
+
+static bool persist_read(ring_buffer_t *rb, uint8_t *data)
+{
+    if (!BASE_OPS->read(rb, data)) {
+        return false;
+    }
+    
+    persist_commit_tail(rb);
+    return true;
+}
+
+static ring_buffer_size_t persist_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len)
+{
+    ring_buffer_size_t n = BASE_OPS->write_multi(rb, data, len);
+    
+    if (n > 0) {
+        persist_commit_head(rb, n);
+    }
+    return n;
+}
+
+static ring_buffer_size_t persist_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len)
+{
+    ring_buffer_size_t n = BASE_OPS->read_multi(rb, data, len);
+    
+    if (n > 0) {
+        persist_commit_tail(rb);
+    }
+    return n;
+}
+
+static ring_buffer_size_t persist_available(const ring_buffer_t *rb)
+{
+    return BASE_OPS->available(rb);
+}
+
+static ring_buffer_size_t persist_free_space(const ring_buffer_t *rb)
+{
+    return BASE_OPS->free_space(rb);
+}
+
+static bool persist_is_empty(const ring_buffer_t *rb)
+{
+    return BASE_OPS->is_empty(rb);
+}
+
+static bool persist_is_full(const ring_buffer_t *rb)
+{
+    return BASE_OPS->is_full(rb);
+}
+
+static void persist_clear(ring_buffer_t *rb)
+{
+    BASE_OPS->clear(rb);
+    
+    RB_STORE_RELEASE(&to_ctl(rb)->tail, (uint32_t)rb->tail);
+    RB_STORE_RELEASE(&to_ctl(rb)->head, (uint32_t)rb->head);
+}
+
+static ring_buffer_size_t persist_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                            ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    ring_buffer_size_t n = BASE_OPS->read_span(rb, len, fn, ctx, flags);
+    
+    if (n > 0 && !(flags & RING_BUFFER_SPAN_PEEK)) {
+        persist_commit_tail(rb);
+    }
+    return n;
+}
+
+static ring_buffer_size_t persist_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                             ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    ring_buffer_size_t n = BASE_OPS->write_span(rb, len, fn, ctx, flags);
+    
+    if (n > 0) {
+        persist_commit_head(rb, n);
+    }
+    return n;
+}
+
+static void persist_flush(ring_buffer_t *rb, uint8_t flags)
+{
+    if (flags & RING_BUFFER_FLUSH_WRITE) {
+        persist_sync(rb);
+    } else if (flags & RING_BUFFER_FLUSH_READ) {
+        persist_msync(to_persist(rb)->map, sizeof(persist_ctl_t));
+    }
+}
+
+static const ring_buffer_ops_t ring_buffer_persist_ops = {
+    .write       = persist_write,
+    .read        = persist_read,
+    .write_multi = persist_write_multi,
+    .read_multi  = persist_read_multi,
+    .available   = persist_available,
+    .free_space  = persist_free_space,
+    .is_empty    = persist_is_empty,
+    .is_full     = persist_is_full,
+    .clear       = persist_clear,
+    .read_span   = persist_read_span,
+    .write_span  = persist_write_span,
+    .flush       = persist_flush,
+};
+
+/**
+ * @brief 校验或初始化控制块
+ * @return true=可用（新建或恢复）, false=文件不属于本缓冲区或已损坏
+ */
+static bool persist_load_ctl(persist_ctl_t *ctl, ring_buffer_size_t size)
+{
+    uint32_t magic = RB_LOAD_ACQUIRE(&ctl->magic);
+    
+    /* 新文件或初始化中途崩溃：魔数尚未写入 */
+    if (magic == 0) {
+        ctl->version = PERSIST_VERSION;
+        ctl->size = size;
+        ctl->head = 0;
+        ctl->tail = 0;
+        RB_STORE_RELEASE(&ctl->magic, (uint32_t)PERSIST_MAGIC);
+        persist_msync(ctl, sizeof(*ctl));
+        return true;
+    }
+    
+    if (magic != PERSIST_MAGIC || ctl->version != PERSIST_VERSION) {
+        RB_LOG_ERROR("Bad persist header (magic=0x%08lx, version=%lu)",
+                     (unsigned long)magic, (unsigned long)ctl->version);
+        return false;
+    }
+    
+    if (ctl->size != size) {
+        RB_LOG_ERROR("Persist size mismatch: file=%lu, requested=%lu",
+                     (unsigned long)ctl->size, (unsigned long)size);
+        return false;
+    }
+    
+    if (ctl->head >= size || ctl->tail >= size) {
+        RB_LOG_ERROR("Persist header corrupt (head=%lu, tail=%lu)",
+                     (unsigned long)ctl->head, (unsigned long)ctl->tail);
+        return false;
+    }
+    
+    return true;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_persist_open(ring_buffer_persist_t *pr, const char *path,
+                              ring_buffer_size_t size, uint32_t sync_bytes)
+{
+    if (!pr || !path) {
+        RB_LOG_ERROR("pr or path is NULL");
+        return false;
+    }
+    
+    if (size < RING_BUFFER_MIN_SIZE) {
+        RB_LOG_ERROR("size=%u < MIN_SIZE=%u", size, RING_BUFFER_MIN_SIZE);
+        return false;
+    }
+    
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        RB_LOG_ERROR("open %s failed (errno=%d)", path, errno);
+        return false;
+    }
+    
+    size_t map_len = (size_t)PERSIST_HDR_SIZE + size;
+    struct stat st;
+    
+    if (fstat(fd, &st) != 0) {
+        RB_LOG_ERROR("fstat failed (errno=%d)", errno);
+        close(fd);
+        return false;
+    }
+    
+    if (st.st_size == 0) {
+        if (ftruncate(fd, (off_t)map_len) != 0) {
+            RB_LOG_ERROR("ftruncate failed (errno=%d)", errno);
+            close(fd);
+            return false;
+        }
+    } else if ((size_t)st.st_size != map_len) {
+        RB_LOG_ERROR("Persist file size mismatch: file=%lu, expected=%lu",
+                     (unsigned long)st.st_size, (unsigned long)map_len);
+        close(fd);
+        return false;
+    }
+    
+    void *map = mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        RB_LOG_ERROR("mmap failed (errno=%d)", errno);
+        close(fd);
+        return false;
+    }
+    
+    persist_ctl_t *ctl = (persist_ctl_t *)map;
+    if (!persist_load_ctl(ctl, size)) {
+        munmap(map, map_len);
+        close(fd);
+        return false;
+    }
+    
+    if (!ring_buffer_create(&pr->rb, (uint8_t *)map + PERSIST_HDR_SIZE, size, RING_BUFFER_TYPE_LOCKFREE)) {
+        munmap(map, map_len);
+        close(fd);
+        return false;
+    }
+    
+    /* 直接恢复读写指针，无需扫描数据 */
+    pr->rb.head = (ring_buffer_size_t)ctl->head;
+    pr->rb.tail = (ring_buffer_size_t)ctl->tail;
+    pr->rb.ops = &ring_buffer_persist_ops;
+    pr->map = map;
+    pr->map_len = map_len;
+    pr->fd = fd;
+    pr->sync_bytes = sync_bytes;
+    pr->dirty = 0;
+    
+    RB_LOG_INFO("Persist buffer opened (%s, size=%u, recovered=%u)",
+                path, size, ring_buffer_available(&pr->rb));
+    return true;
+}
+
+void ring_buffer_persist_close(ring_buffer_persist_t *pr)
+{
+    if (!pr || !pr->map) {
+        RB_LOG_ERROR("Close failed: persist buffer not open");
+        return;
+    }
+    
+    persist_sync(&pr->rb);
+    munmap(pr->map, pr->map_len);
+    close(pr->fd);
+    
+    pr->map = NULL;
+    pr->map_len = 0;
+    pr->fd = -1;
+    ring_buffer_destroy(&pr->rb);
+}
+
+#endif /* RING_BUFFER_ENABLE_PERSIST */
@@ -0,0 +1,315 @@
+/**
+ * @file    ring_buffer_pipeline.c
+ * @brief   多级流水线运行时（每级一个线程，级间 SPSC 缓冲区，背压逐级传递）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 解析 -> 过滤 -> 编码 -> 写出等分级处理，各级耗时不同，需要并行
+ * - 手写“缓冲区 + 线程 + 轮询循环”重复且容易漏掉背压与统计
+ *
+ * 实现要点：
+ * - 第 i 级从自己的输入缓冲区批量取出数据段，处理函数把结果写入第 i+1 级的输入缓冲区；
+ *   每个缓冲区只有一个生产者（上一级）和一个消费者（本级），使用无锁模式
+ * - 以 read_span 交给处理函数：零拷贝，读指针只按处理函数的返回值前移
+ * - 背压：下游已满时处理函数只处理能写下的部分，本级输入随之积压，上一级的写入也随之受阻，
+ *   直到入口的 write_multi 返回不足，无需额外信号
+ * - 空闲等待：连续多轮无进展后睡眠，避免空转占满核
+ * - 统计只由本级线程写入，读取方得到近似值
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE                 /* pthread_attr_setaffinity_np */
+#endif
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_PIPELINE
+
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+/* Private defines -----------------------------------------------------------*/
+
+#define PIPE_SLEEP_NS  50000L           /**< 空闲时每次睡眠的时长 */
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    ring_buffer_pipeline_t *pl;
+    ring_buffer_stage_t *stage;
+    ring_buffer_t *out;                     /**< 下一级输入（最后一级为 NULL）*/
+} pipe_worker_t;
+
+typedef struct {
+    pthread_t threads[RING_BUFFER_PIPE_MAX_STAGES];
+    pipe_worker_t workers[RING_BUFFER_PIPE_MAX_STAGES];
+    uint8_t started;                        /**< 已创建的线程数 */
+} pipe_impl_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+static void pipe_sleep(void)
+{
+    struct timespec ts = { 0, PIPE_SLEEP_NS };
+    nanosleep(&ts, NULL);
+}
+
+static ring_buffer_size_t pipe_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    pipe_worker_t *w = (pipe_worker_t *)ctx;
+    ring_buffer_stage_t *st = w->stage;
+    ring_buffer_size_t total = spans[0].len + ((count > 1) ? spans[1].len : 0);
+    
+    ring_buffer_size_t n = st->fn(st->ctx, spans, count, w->out);
+    if (n > total) {
+        n = total;
+    }
+    
+    st->bytes += n;
+    st->batches++;
+    if (n < total) {
+        st->stalls++;
+    }
+    return n;
+}
+
+static void *pipe_stage_run(void *arg)
+{
+    pipe_worker_t *w = (pipe_worker_t *)arg;
+    ring_buffer_stage_t *st = w->stage;
+    uint32_t idle = 0;
+    
+    while (RB_LOAD_ACQUIRE(&w->pl->running)) {
+        ring_buffer_size_t depth = ring_buffer_available(&st->in);
+        ring_buffer_size_t n = 0;
+        
+        if (depth > st->peak_depth) {
+            st->peak_depth = depth;
+        }
+        if (depth > 0) {
+            n = ring_buffer_read_span(&st->in, RING_BUFFER_PIPE_DRAIN, pipe_span_cb, w, 0);
+        }
+        
+        if (n > 0) {
+            idle = 0;
+        } else if (++idle < RING_BUFFER_PIPE_IDLE_SPINS) {
+            sched_yield();
+        } else {
+            pipe_sleep();
+        }
+    }
+    
+    return NULL;
+}
+
+static void pipe_join(ring_buffer_pipeline_t *pl, pipe_impl_t *impl)
+{
+    RB_STORE_RELEASE(&pl->running, false);
+    for (uint8_t i = 0; i < impl->started; i++) {
+        pthread_join(impl->threads[i], NULL);
+    }
+    impl->started = 0;
+}
+
+/**
+ * @brief 创建本级线程；指定了 CPU 时通过线程属性在创建前绑核，线程从第一条指令起就在目标核上运行
+ * @note 绑核失败（如 CPU 编号无效）只告警，退回不绑核创建
+ */
+static bool pipe_spawn(pthread_t *thread, pipe_worker_t *w, uint8_t idx)
+{
+    (void)idx;
+    
+#if defined(__linux__)
+    if (w->stage->cpu >= 0) {
+        pthread_attr_t attr;
+        cpu_set_t set;
+        bool ok = false;
+        
+        CPU_ZERO(&set);
+        
+        if (w->stage->cpu < CPU_SETSIZE && pthread_attr_init(&attr) == 0) {
+            CPU_SET(w->stage->cpu, &set);
+            ok = (pthread_attr_setaffinity_np(&attr, sizeof(set), &set) == 0) &&
+                 (pthread_create(thread, &attr, pipe_stage_run, w) == 0);
+            pthread_attr_destroy(&attr);
+        }
+        
+        if (ok) {
+            return true;
+        }
+        RB_LOG_WARN("Pin stage %u to cpu %d failed", idx, w->stage->cpu);
+    }
+#endif
+    
+    return pthread_create(thread, NULL, pipe_stage_run, w) == 0;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_pipeline_init(ring_buffer_pipeline_t *pl)
+{
+    if (!pl) {
+        RB_LOG_ERROR("pl is NULL");
+        return false;
+    }
+    
+    memset(pl, 0, sizeof(*pl));
+    return true;
+}
+
+bool ring_buffer_pipeline_add_stage(ring_buffer_pipeline_t *pl, ring_buffer_stage_fn_t fn, void *ctx,
+                                    ring_buffer_size_t in_size, int cpu)
+{
+    if (!pl || !fn) {
+        RB_LOG_ERROR("pl or fn is NULL");
+        return false;
+    }
+    
+    if (pl->impl) {
+        RB_LOG_ERROR("Pipeline already started");
+        return false;
+    }
+    
+    if (pl->count >= RING_BUFFER_PIPE_MAX_STAGES) {
+        RB_LOG_ERROR("Too many stages (max=%d)", RING_BUFFER_PIPE_MAX_STAGES);
+        return false;
+    }
+    
+    ring_buffer_stage_t *st = &pl->stages[pl->count];
+    memset(st, 0, sizeof(*st));
+    
+    st->storage = (uint8_t *)malloc(in_size);
+    if (!st->storage) {
+        RB_LOG_ERROR("Stage storage alloc failed (size=%u)", in_size);
+        return false;
+    }
+    
+    if (!ring_buffer_create(&st->in, st->storage, in_size, RING_BUFFER_TYPE_LOCKFREE)) {
+        free(st->storage);
+        st->storage = NULL;
+        return false;
+    }
+    
+    st->fn = fn;
+    st->ctx = ctx;
+    st->cpu = cpu;
+    pl->count++;
+    
+    RB_LOG_INFO("Stage %u added (in_size=%u, cpu=%d)", pl->count - 1U, in_size, cpu);
+    return true;
+}
+
+bool ring_buffer_pipeline_start(ring_buffer_pipeline_t *pl)
+{
+    if (!pl || pl->count == 0) {
+        RB_LOG_ERROR("pl is NULL or has no stage");
+        return false;
+    }
+    
+    if (pl->impl) {
+        RB_LOG_ERROR("Pipeline already started");
+        return false;
+    }
+    
+    pipe_impl_t *impl = (pipe_impl_t *)calloc(1, sizeof(pipe_impl_t));
+    if (!impl) {
+        RB_LOG_ERROR("Pipeline impl alloc failed");
+        return false;
+    }
+    
+    pl->running = true;
+    
+    for (uint8_t i = 0; i < pl->count; i++) {
+        pipe_worker_t *w = &impl->workers[i];
+        w->pl = pl;
+        w->stage = &pl->stages[i];
+        w->out = (i + 1U < pl->count) ? &pl->stages[i + 1U].in : NULL;
+        
+        if (!pipe_spawn(&impl->threads[i], w, i)) {
+            RB_LOG_ERROR("Create thread for stage %u failed", i);
+            pipe_join(pl, impl);
+            free(impl);
+            return false;
+        }
+        impl->started++;
+    }
+    
+    pl->impl = impl;
+    RB_LOG_INFO("Pipeline started (stages=%u)", pl->count);
+    return true;
+}
+
+void ring_buffer_pipeline_stop(ring_buffer_pipeline_t *pl, bool drain)
+{
+    if (!pl || !pl->impl) {
+        RB_LOG_ERROR("pl is NULL or not started");
+        return;
+    }
+    
+    /*
+     * 按顺序等待各级输入排空：读指针在处理函数返回后才前移，
+     * 第 i 级输入为空时其输出已全部写入第 i+1 级
+     */
+    if (drain) {
+        for (uint8_t i = 0; i < pl->count; i++) {
+            while (ring_buffer_available(&pl->stages[i].in) > 0) {
+                pipe_sleep();
+            }
+        }
+    }
+    
+    pipe_join(pl, (pipe_impl_t *)pl->impl);
+    free(pl->impl);
+    pl->impl = NULL;
+    
+    RB_LOG_INFO("Pipeline stopped (drain=%d)", drain);
+}
+
+bool ring_buffer_pipeline_stats(const ring_buffer_pipeline_t *pl, uint8_t stage, ring_buffer_stage_stats_t *st)
+{
+    if (!pl || !st) {
+        RB_LOG_ERROR("pl or st is NULL");
+        return false;
+    }
+    
+    if (stage >= pl->count) {
+        RB_LOG_ERROR("stage=%u >= count=%u", stage, pl->count);
+        return false;
+    }
+    
+    const ring_buffer_stage_t *s = &pl->stages[stage];
+    st->bytes = s->bytes;
+    st->batches = s->batches;
+    st->stalls = s->stalls;
+    st->depth = ring_buffer_available(&s->in);
+    st->peak_depth = s->peak_depth;
+    
+    return true;
+}
+
+void ring_buffer_pipeline_deinit(ring_buffer_pipeline_t *pl)
+{
+    if (!pl) {
+        RB_LOG_ERROR("pl is NULL");
+        return;
+    }
+    
+    if (pl->impl) {
+        RB_LOG_WARN("Pipeline still running, stopping without drain");
+        ring_buffer_pipeline_stop(pl, false);
+    }
+    
+    for (uint8_t i = 0; i < pl->count; i++) {
+        ring_buffer_destroy(&pl->stages[i].in);
+        free(pl->stages[i].storage);
+        pl->stages[i].storage = NULL;
+    }
+    pl->count = 0;
+}
+
+#endif /* RING_BUFFER_ENABLE_PIPELINE */
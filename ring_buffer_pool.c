@@ -0,0 +1,272 @@
+/**
+ * @file    ring_buffer_pool.c
+ * @brief   环形缓冲区池（控制块与存储区从同一 arena 按缓存行对齐切分）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 需要创建成百上千个同规格缓冲区（每连接/每通道一个）
+ * - 避免控制块零散分布、与无关热点数据共享缓存行
+ *
+ * 槽位布局（每个字段按 RING_BUFFER_CACHE_LINE 对齐）：
+ * - [ring_buffer_t 控制块 | 存储区]，槽位在 arena 中连续排列
+ *
+ * 实现要点：
+ * - 空闲槽位通过存储区前 4 字节串成单链表，分配/释放均为 O(1)
+ * - arena 可由用户提供（静态数组），也可在主机上用 mmap 分配并可选大页
+ * - 分配得到普通 ring_buffer_t *，可直接用于全部缓冲区 API
+ *
+ * @note 分配/释放本身不加锁，多线程调用需由调用者互斥
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_POOL
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <errno.h>
+    #include <sys/mman.h>
+    #define POOL_USE_MMAP
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+
+#define POOL_NIL         UINT32_MAX                     /**< 空闲链表结束 */
+#define POOL_HUGE_PAGE   (2UL * 1024UL * 1024UL)        /**< 大页大小 */
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline ring_buffer_t *pool_slot(const ring_buffer_pool_t *pool, uint32_t idx)
+{
+    return (ring_buffer_t *)(void *)(pool->arena + (size_t)idx * pool->stride);
+}
+
+static inline uint8_t *pool_storage(const ring_buffer_pool_t *pool, uint32_t idx)
+{
+    return pool->arena + (size_t)idx * pool->stride + RB_POOL_ALIGN(sizeof(ring_buffer_t));
+}
+
+/**
+ * @brief 在已对齐的 arena 上建立空闲链表
+ */
+static void pool_setup(ring_buffer_pool_t *pool, uint32_t capacity)
+{
+    pool->capacity = capacity;
+    pool->used = 0;
+    pool->free_head = 0;
+    
+    for (uint32_t i = 0; i < capacity; i++) {
+        uint32_t next = (i + 1U < capacity) ? (i + 1U) : POOL_NIL;
+        memcpy(pool_storage(pool, i), &next, sizeof(next));
+        pool_slot(pool, i)->buffer = NULL;
+    }
+}
+
+static bool pool_check_args(ring_buffer_pool_t *pool, ring_buffer_size_t ring_size)
+{
+    if (!pool) {
+        RB_LOG_ERROR("pool is NULL");
+        return false;
+    }
+    
+    if (ring_size < RING_BUFFER_MIN_SIZE) {
+        RB_LOG_ERROR("ring_size=%u < MIN_SIZE=%u", ring_size, RING_BUFFER_MIN_SIZE);
+        return false;
+    }
+    
+    return true;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_pool_init(ring_buffer_pool_t *pool, void *mem, size_t mem_len,
+                           ring_buffer_size_t ring_size, ring_buffer_type_t type)
+{
+    if (!pool_check_args(pool, ring_size)) {
+        return false;
+    }
+    
+    if (!mem) {
+        RB_LOG_ERROR("mem is NULL");
+        return false;
+    }
+    
+    /* 起始地址向上对齐到缓存行 */
+    uintptr_t base = ((uintptr_t)mem + RING_BUFFER_CACHE_LINE - 1U) & ~(uintptr_t)(RING_BUFFER_CACHE_LINE - 1U);
+    size_t pad = (size_t)(base - (uintptr_t)mem);
+    size_t stride = RING_BUFFER_POOL_SLOT_SIZE(ring_size);
+    
+    if (mem_len < pad + stride) {
+        RB_LOG_ERROR("Arena too small: len=%lu, slot=%lu",
+                     (unsigned long)mem_len, (unsigned long)stride);
+        return false;
+    }
+    
+    size_t capacity = (mem_len - pad) / stride;
+    if (capacity >= POOL_NIL) {
+        capacity = POOL_NIL - 1U;
+    }
+    
+    pool->arena = (uint8_t *)base;
+    pool->map = NULL;
+    pool->map_len = 0;
+    pool->stride = (uint32_t)stride;
+    pool->ring_size = ring_size;
+    pool->type = type;
+    pool->huge = false;
+    pool_setup(pool, (uint32_t)capacity);
+    
+    RB_LOG_INFO("Pool ready (rings=%lu, ring_size=%u, slot=%lu)",
+                (unsigned long)capacity, ring_size, (unsigned long)stride);
+    return true;
+}
+
+#ifdef POOL_USE_MMAP
+
+bool ring_buffer_pool_create(ring_buffer_pool_t *pool, uint32_t count,
+                             ring_buffer_size_t ring_size, ring_buffer_type_t type, uint8_t flags)
+{
+    if (!pool_check_args(pool, ring_size)) {
+        return false;
+    }
+    
+    if (count == 0 || count >= POOL_NIL) {
+        RB_LOG_ERROR("Invalid count=%lu", (unsigned long)count);
+        return false;
+    }
+    
+    size_t stride = RING_BUFFER_POOL_SLOT_SIZE(ring_size);
+    size_t len = stride * count;
+    void *map = MAP_FAILED;
+    bool huge = false;
+    
+#ifdef MAP_HUGETLB
+    if (flags & RING_BUFFER_POOL_HUGEPAGE) {
+        size_t huge_len = (len + POOL_HUGE_PAGE - 1U) & ~(size_t)(POOL_HUGE_PAGE - 1U);
+        map = mmap(NULL, huge_len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (map != MAP_FAILED) {
+            len = huge_len;
+            huge = true;
+        } else {
+            /* 未预留大页是常见情况，退化为普通页 */
+            RB_LOG_INFO("MAP_HUGETLB unavailable (errno=%d), using normal pages", errno);
+        }
+    }
+#endif
+    
+    if (map == MAP_FAILED) {
+        map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) {
+            RB_LOG_ERROR("mmap failed (len=%lu, errno=%d)", (unsigned long)len, errno);
+            return false;
+        }
+#ifdef MADV_HUGEPAGE
+        if (flags & RING_BUFFER_POOL_HUGEPAGE) {
+            madvise(map, len, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    
+    pool->arena = (uint8_t *)map;
+    pool->map = map;
+    pool->map_len = len;
+    pool->stride = (uint32_t)stride;
+    pool->ring_size = ring_size;
+    pool->type = type;
+    pool->huge = huge;
+    pool_setup(pool, count);
+    
+    RB_LOG_INFO("Pool created (rings=%lu, ring_size=%u, hugetlb=%d)",
+                (unsigned long)count, ring_size, huge);
+    return true;
+}
+
+#endif /* POOL_USE_MMAP */
+
+void ring_buffer_pool_deinit(ring_buffer_pool_t *pool)
+{
+    if (!pool || !pool->arena) {
+        RB_LOG_ERROR("Deinit failed: pool not initialized");
+        return;
+    }
+    
+    if (pool->used > 0) {
+        RB_LOG_WARN("Pool deinit with %lu rings in use", (unsigned long)pool->used);
+    }
+    
+#ifdef POOL_USE_MMAP
+    if (pool->map) {
+        munmap(pool->map, pool->map_len);
+    }
+#endif
+    
+    pool->arena = NULL;
+    pool->map = NULL;
+    pool->map_len = 0;
+    pool->capacity = 0;
+    pool->used = 0;
+    pool->free_head = POOL_NIL;
+}
+
+ring_buffer_t *ring_buffer_pool_alloc(ring_buffer_pool_t *pool)
+{
+    if (!pool || !pool->arena) {
+        RB_LOG_ERROR("pool is NULL or not initialized");
+        return NULL;
+    }
+    
+    if (pool->free_head == POOL_NIL) {
+        RB_LOG_WARN("Pool exhausted (%lu rings)", (unsigned long)pool->capacity);
+        return NULL;
+    }
+    
+    uint32_t idx = pool->free_head;
+    uint8_t *storage = pool_storage(pool, idx);
+    ring_buffer_t *rb = pool_slot(pool, idx);
+    
+    memcpy(&pool->free_head, storage, sizeof(pool->free_head));
+    
+    if (!ring_buffer_create(rb, storage, pool->ring_size, pool->type)) {
+        /* 放回链表头，保持池状态不变 */
+        rb->buffer = NULL;
+        memcpy(storage, &pool->free_head, sizeof(pool->free_head));
+        pool->free_head = idx;
+        return NULL;
+    }
+    
+    pool->used++;
+    return rb;
+}
+
+bool ring_buffer_pool_free(ring_buffer_pool_t *pool, ring_buffer_t *rb)
+{
+    if (!pool || !pool->arena || !rb) {
+        RB_LOG_ERROR("pool or rb is NULL");
+        return false;
+    }
+    
+    uintptr_t off = (uintptr_t)rb - (uintptr_t)pool->arena;
+    uint32_t idx = (uint32_t)(off / pool->stride);
+    
+    if ((uintptr_t)rb < (uintptr_t)pool->arena || off % pool->stride != 0 || idx >= pool->capacity) {
+        RB_LOG_ERROR("rb %p does not belong to pool", (void *)rb);
+        return false;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("Double free of pool ring %lu", (unsigned long)idx);
+        return false;
+    }
+    
+    ring_buffer_destroy(rb);
+    
+    memcpy(pool_storage(pool, idx), &pool->free_head, sizeof(pool->free_head));
+    pool->free_head = idx;
+    pool->used--;
+    return true;
+}
+
+#endif /* RING_BUFFER_ENABLE_POOL */
@@ -0,0 +1,184 @@
+/**
+ * @file    ring_buffer_prio.c
+ * @brief   多优先级通道缓冲区（严格优先级 / 加权轮询）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 控制报文与大块数据共用一条链路，控制报文不能排在大块数据之后
+ * - 消费者不希望轮询多个缓冲区
+ *
+ * 实现要点：
+ * - 2~8 个通道，每个通道是一个普通缓冲区（策略由创建时指定），通道 0 优先级最高
+ * - 非空位图：写入后置位，读空后清位；消费者一次加载即可找到有数据的通道
+ * - 清位后复查通道，防止与并发写入的置位交错而丢失通知
+ * - 严格优先级：总是服务编号最小的非空通道
+ * - 加权轮询：当前通道连续服务 weight 次读取后轮转到下一个非空通道
+ *
+ * @note 读取每次只从一个通道取数据，不会把不同通道的数据拼接在一起
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_PRIO
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    uint8_t *dst;                       /**< 目标地址 */
+} prio_copy_ctx_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+static ring_buffer_size_t prio_copy_out_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    prio_copy_ctx_t *cc = (prio_copy_ctx_t *)ctx;
+    ring_buffer_size_t done = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        RB_COPY_OUT(cc->dst + done, spans[i].data, spans[i].len);
+        done += spans[i].len;
+    }
+    return done;
+}
+
+/**
+ * @brief 从 from 开始循环查找第一个置位的通道
+ */
+static uint8_t prio_next_lane(uint8_t mask, uint8_t from, uint8_t lane_count)
+{
+    for (uint8_t i = 0; i < lane_count; i++) {
+        uint8_t lane = (uint8_t)((from + i) % lane_count);
+        if (mask & (1U << lane)) {
+            return lane;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 选择本次服务的通道（仅消费者调用）
+ */
+static uint8_t prio_select(ring_buffer_prio_t *p, uint8_t mask)
+{
+    if (p->mode == RING_BUFFER_PRIO_STRICT) {
+        return prio_next_lane(mask, 0, p->lane_count);
+    }
+    
+    /* 当前通道额度用完或已空，轮转到下一个非空通道 */
+    if (p->credit == 0 || !(mask & (1U << p->cursor))) {
+        p->cursor = prio_next_lane(mask, (uint8_t)(p->cursor + 1U), p->lane_count);
+        p->credit = p->weight[p->cursor];
+    }
+    
+    p->credit--;
+    return p->cursor;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_prio_create(ring_buffer_prio_t *p, const ring_buffer_prio_lane_t *lanes,
+                             uint8_t lane_count, ring_buffer_type_t type, ring_buffer_prio_mode_t mode)
+{
+    if (!p || !lanes) {
+        RB_LOG_ERROR("p or lanes is NULL");
+        return false;
+    }
+    
+    if (lane_count < 2 || lane_count > RING_BUFFER_PRIO_MAX_LANES) {
+        RB_LOG_ERROR("lane_count=%u out of range [2, %u]", lane_count, RING_BUFFER_PRIO_MAX_LANES);
+        return false;
+    }
+    
+    for (uint8_t i = 0; i < lane_count; i++) {
+        if (!ring_buffer_create(&p->lanes[i], lanes[i].buffer, lanes[i].size, type)) {
+            RB_LOG_ERROR("Lane %u create failed", i);
+            while (i > 0) {
+                ring_buffer_destroy(&p->lanes[--i]);
+            }
+            return false;
+        }
+        p->weight[i] = (lanes[i].weight > 0) ? lanes[i].weight : 1U;
+    }
+    
+    p->lane_count = lane_count;
+    p->mode = mode;
+    p->nonempty = 0;
+    p->cursor = 0;
+    p->credit = p->weight[0];
+    
+    RB_LOG_INFO("Created prio buffer (lanes=%u, mode=%s)", lane_count,
+                (mode == RING_BUFFER_PRIO_STRICT) ? "strict" : "weighted");
+    return true;
+}
+
+void ring_buffer_prio_destroy(ring_buffer_prio_t *p)
+{
+    if (!p) {
+        RB_LOG_ERROR("Destroy failed: p is NULL");
+        return;
+    }
+    
+    for (uint8_t i = 0; i < p->lane_count; i++) {
+        ring_buffer_destroy(&p->lanes[i]);
+    }
+    p->lane_count = 0;
+    p->nonempty = 0;
+}
+
+ring_buffer_size_t ring_buffer_prio_write(ring_buffer_prio_t *p, uint8_t lane,
+                                          const uint8_t *data, ring_buffer_size_t len)
+{
+    if (!p || lane >= p->lane_count) {
+        RB_LOG_ERROR("p is NULL or lane out of range");
+        return 0;
+    }
+    
+    ring_buffer_size_t n = ring_buffer_write_multi(&p->lanes[lane], data, len);
+    
+    /* 数据发布后再置位，消费者看到位即可读到数据 */
+    if (n > 0) {
+        RB_FETCH_OR(&p->nonempty, (uint8_t)(1U << lane));
+    }
+    return n;
+}
+
+ring_buffer_size_t ring_buffer_prio_read(ring_buffer_prio_t *p, uint8_t *data,
+                                         ring_buffer_size_t len, uint8_t *lane)
+{
+    if (!p || !data) {
+        RB_LOG_ERROR("p or data is NULL");
+        return 0;
+    }
+    
+    uint8_t mask = RB_LOAD_ACQUIRE(&p->nonempty);
+    if (mask == 0 || len == 0) {
+        return 0;
+    }
+    
+    uint8_t sel = prio_select(p, mask);
+    ring_buffer_t *rb = &p->lanes[sel];
+    prio_copy_ctx_t cc = {
+        .dst = data,
+    };
+    
+    ring_buffer_size_t n = ring_buffer_read_span(rb, len, prio_copy_out_cb, &cc, 0);
+    
+    if (ring_buffer_is_empty(rb)) {
+        RB_FETCH_AND(&p->nonempty, (uint8_t)~(1U << sel));
+        
+        /* 清位与生产者置位交错时恢复 */
+        if (!ring_buffer_is_empty(rb)) {
+            RB_FETCH_OR(&p->nonempty, (uint8_t)(1U << sel));
+        }
+    }
+    
+    if (lane) {
+        *lane = sel;
+    }
+    return n;
+}
+
+#endif /* RING_BUFFER_ENABLE_PRIO */
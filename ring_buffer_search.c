@@ -0,0 +1,318 @@
+/**
+ * @file    ring_buffer_search.c
+ * @brief   环形缓冲区预读与查找实现
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 协议解析（查找帧尾 '\n'、同步字节）
+ * - 帧头预读（不移除数据即可检查长度字段）
+ *
+ * 实现要点：
+ * - 基于策略的 read_span 接口，直接扫描缓冲区内的一或两个数据段
+ * - 不做额外拷贝，线程安全由所选策略保证
+ * - 单字节查找使用 memchr（主流 libc 已向量化）
+ * - 字节集合查找在 AVX2/SSE2/NEON 平台使用向量比较，否则使用位图查表
+ */
+
+#include "ring_buffer.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define SEARCH_USE_AVX2
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+    #define SEARCH_USE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define SEARCH_USE_NEON
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+
+/**
+ * @brief 使用向量比较的最大集合大小（超过后位图查表更快）
+ */
+#define SEARCH_SIMD_SET_MAX  8
+
+/* Private types -------------------------------------------------------------*/
+
+typedef struct {
+    const uint8_t *set;     /**< 字节集合 */
+    uint8_t set_len;        /**< 集合大小 */
+    bool found;             /**< 是否找到 */
+    ring_buffer_size_t pos; /**< 相对读指针的偏移 */
+} search_ctx_t;
+
+typedef struct {
+    ring_buffer_size_t offset;        /**< 跳过的字节数 */
+    uint8_t *data;                    /**< 目标地址 */
+    ring_buffer_size_t len;           /**< 期望复制的字节数 */
+    ring_buffer_size_t copied;        /**< 实际复制的字节数 */
+} peek_ctx_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 标量查找（位图查表）
+ * @return 首个命中位置，未命中返回 len
+ */
+static ring_buffer_size_t search_any_scalar(const uint8_t *p, ring_buffer_size_t len,
+                                            const uint8_t *set, uint8_t set_len)
+{
+    uint32_t map[8] = {0};
+    
+    for (uint8_t k = 0; k < set_len; k++) {
+        map[set[k] >> 5] |= 1UL << (set[k] & 31U);
+    }
+    
+    for (ring_buffer_size_t i = 0; i < len; i++) {
+        if (map[p[i] >> 5] & (1UL << (p[i] & 31U))) {
+            return i;
+        }
+    }
+    
+    return len;
+}
+
+/**
+ * @brief 查找字节集合中任意字节（向量化）
+ * @return 首个命中位置，未命中返回 len
+ */
+static ring_buffer_size_t search_any(const uint8_t *p, ring_buffer_size_t len,
+                                     const uint8_t *set, uint8_t set_len)
+{
+#if defined(SEARCH_USE_AVX2) || defined(SEARCH_USE_SSE2) || defined(SEARCH_USE_NEON)
+    if (set_len > SEARCH_SIMD_SET_MAX) {
+        return search_any_scalar(p, len, set, set_len);
+    }
+    
+    ring_buffer_size_t i = 0;
+    
+#if defined(SEARCH_USE_AVX2)
+    __m256i needles[SEARCH_SIMD_SET_MAX];
+    for (uint8_t k = 0; k < set_len; k++) {
+        needles[k] = _mm256_set1_epi8((char)set[k]);
+    }
+    
+    for (; (uint32_t)i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(p + i));
+        __m256i m = _mm256_cmpeq_epi8(v, needles[0]);
+        for (uint8_t k = 1; k < set_len; k++) {
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, needles[k]));
+        }
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(m);
+        if (mask) {
+            return i + (ring_buffer_size_t)__builtin_ctz(mask);
+        }
+    }
+#elif defined(SEARCH_USE_SSE2)
+    __m128i needles[SEARCH_SIMD_SET_MAX];
+    for (uint8_t k = 0; k < set_len; k++) {
+        needles[k] = _mm_set1_epi8((char)set[k]);
+    }
+    
+    for (; (uint32_t)i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(const void *)(p + i));
+        __m128i m = _mm_cmpeq_epi8(v, needles[0]);
+        for (uint8_t k = 1; k < set_len; k++) {
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(v, needles[k]));
+        }
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(m);
+        if (mask) {
+            return i + (ring_buffer_size_t)__builtin_ctz(mask);
+        }
+    }
+#else /* SEARCH_USE_NEON */
+    uint8x16_t needles[SEARCH_SIMD_SET_MAX];
+    for (uint8_t k = 0; k < set_len; k++) {
+        needles[k] = vdupq_n_u8(set[k]);
+    }
+    
+    for (; (uint32_t)i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8(p + i);
+        uint8x16_t m = vceqq_u8(v, needles[0]);
+        for (uint8_t k = 1; k < set_len; k++) {
+            m = vorrq_u8(m, vceqq_u8(v, needles[k]));
+        }
+        if (vmaxvq_u8(m)) {
+            /* 块内命中，交给标量定位 */
+            break;
+        }
+    }
+#endif
+    
+    /* 剩余不足一个向量的尾部 */
+    return i + search_any_scalar(p + i, len - i, set, set_len);
+#else
+    return search_any_scalar(p, len, set, set_len);
+#endif
+}
+
+static ring_buffer_size_t find_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    search_ctx_t *sc = (search_ctx_t *)ctx;
+    ring_buffer_size_t base = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        const uint8_t *hit = (const uint8_t *)memchr(spans[i].data, sc->set[0], spans[i].len);
+        if (hit) {
+            sc->found = true;
+            sc->pos = base + (ring_buffer_size_t)(hit - spans[i].data);
+            return sc->pos;
+        }
+        base += spans[i].len;
+    }
+    
+    return base;
+}
+
+static ring_buffer_size_t find_any_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    search_ctx_t *sc = (search_ctx_t *)ctx;
+    ring_buffer_size_t base = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        ring_buffer_size_t idx = search_any(spans[i].data, spans[i].len, sc->set, sc->set_len);
+        if (idx < spans[i].len) {
+            sc->found = true;
+            sc->pos = base + idx;
+            return sc->pos;
+        }
+        base += spans[i].len;
+    }
+    
+    return base;
+}
+
+static ring_buffer_size_t peek_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    peek_ctx_t *pc = (peek_ctx_t *)ctx;
+    ring_buffer_size_t skip = pc->offset;
+    ring_buffer_size_t done = 0;
+    
+    for (uint8_t i = 0; i < count && pc->copied < pc->len; i++) {
+        ring_buffer_size_t seg_len = spans[i].len;
+        
+        if (skip >= seg_len) {
+            skip -= seg_len;
+            done += seg_len;
+            continue;
+        }
+        
+        ring_buffer_size_t n = seg_len - skip;
+        if (n > pc->len - pc->copied) {
+            n = pc->len - pc->copied;
+        }
+        
+        memcpy(&pc->data[pc->copied], &spans[i].data[skip], n);
+        pc->copied += n;
+        done += skip + n;
+        skip = 0;
+    }
+    
+    return done;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+ring_buffer_size_t ring_buffer_peek_at(ring_buffer_t *rb, ring_buffer_size_t offset, uint8_t *data, ring_buffer_size_t len)
+{
+    if (!data) {
+        RB_LOG_ERROR("data is NULL");
+        return 0;
+    }
+    
+    if (len == 0) {
+        RB_LOG_WARN("len is 0");
+        return 0;
+    }
+    
+    peek_ctx_t pc = {
+        .offset = offset,
+        .data = data,
+        .len = len,
+        .copied = 0,
+    };
+    
+    /* offset + len 溢出时截断，超出部分本就不可能可读 */
+    ring_buffer_size_t span_len = RING_BUFFER_SIZE_MAX;
+    if (offset < RING_BUFFER_SIZE_MAX - len) {
+        span_len = offset + len;
+    }
+    
+    ring_buffer_read_span(rb, span_len, peek_span_cb, &pc, RING_BUFFER_SPAN_PEEK);
+    return pc.copied;
+}
+
+bool ring_buffer_find(ring_buffer_t *rb, uint8_t byte, ring_buffer_size_t *pos)
+{
+    if (!pos) {
+        RB_LOG_ERROR("pos is NULL");
+        return false;
+    }
+    
+    search_ctx_t sc = {
+        .set = &byte,
+        .set_len = 1,
+        .found = false,
+        .pos = 0,
+    };
+    
+    ring_buffer_read_span(rb, RING_BUFFER_SIZE_MAX, find_span_cb, &sc, RING_BUFFER_SPAN_PEEK);
+    
+    if (sc.found) {
+        *pos = sc.pos;
+    }
+    return sc.found;
+}
+
+bool ring_buffer_find_any(ring_buffer_t *rb, const uint8_t *set, uint8_t set_len, ring_buffer_size_t *pos)
+{
+    if (!set || set_len == 0) {
+        RB_LOG_ERROR("set is NULL or empty");
+        return false;
+    }
+    
+    if (!pos) {
+        RB_LOG_ERROR("pos is NULL");
+        return false;
+    }
+    
+    search_ctx_t sc = {
+        .set = set,
+        .set_len = set_len,
+        .found = false,
+        .pos = 0,
+    };
+    
+    ring_buffer_read_span(rb, RING_BUFFER_SIZE_MAX, find_any_span_cb, &sc, RING_BUFFER_SPAN_PEEK);
+    
+    if (sc.found) {
+        *pos = sc.pos;
+    }
+    return sc.found;
+}
+
+ring_buffer_size_t ring_buffer_read_until(ring_buffer_t *rb, uint8_t delim, uint8_t *data, ring_buffer_size_t len)
+{
+    if (!data) {
+        RB_LOG_ERROR("data is NULL");
+        return 0;
+    }
+    
+    ring_buffer_size_t pos;
+    if (!ring_buffer_find(rb, delim, &pos)) {
+        /* 分隔符未到达是正常情况 */
+        return 0;
+    }
+    
+    if (pos >= len) {
+        RB_LOG_WARN("Frame too long: frame=%u, capacity=%u", pos + 1, len);
+        return 0;
+    }
+    
+    return ring_buffer_read_multi(rb, data, pos + 1);
+}
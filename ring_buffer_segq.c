@@ -0,0 +1,287 @@
+/**
+ * @file    ring_buffer_segq.c
+ * @brief   分段队列（链式环形缓冲区段，吸收突发流量）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 平时流量小、偶发突发大，按最坏情况定长分配浪费内存
+ * - 突发期间不允许像定长缓冲区一样丢弃数据
+ *
+ * 实现要点：
+ * - 每个段是一个无锁环形缓冲区；当前段写满时生产者链接新段，
+ *   消费者读空当前段且发现后继段后跟随链接
+ * - 生产者链接新段后不再写入旧段，消费者看到 next 后旧段剩余数据即为全部
+ * - 消费者只发布自己所在的段；生产者回收其之前的段到私有空闲链表，
+ *   无需 CAS，单生产者单消费者全程无锁
+ * - 新段优先取自空闲链表，其次 malloc，直到达到段数上限（0 = 不限）
+ *
+ * @note 仅支持单生产者单消费者
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_SEGQ
+
+#include <stdlib.h>
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 队列段（数据区紧随结构体分配）
+ */
+struct ring_buffer_seg {
+    struct ring_buffer_seg *next;       /**< 后继段（生产者以释放语义发布）*/
+    void *mem;                          /**< malloc 返回的原始地址（ring_buffer_t 可能按缓存行对齐）*/
+    ring_buffer_t rb;                   /**< 段内环形缓冲区（无锁策略）*/
+};
+
+typedef struct {
+    const uint8_t *src;                 /**< 写入：源数据 */
+    uint8_t *dst;                       /**< 读取：目标地址 */
+} segq_copy_ctx_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+static ring_buffer_size_t segq_copy_in_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    segq_copy_ctx_t *cc = (segq_copy_ctx_t *)ctx;
+    ring_buffer_size_t done = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        RB_COPY_IN(spans[i].data, cc->src + done, spans[i].len);
+        done += spans[i].len;
+    }
+    return done;
+}
+
+static ring_buffer_size_t segq_copy_out_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    segq_copy_ctx_t *cc = (segq_copy_ctx_t *)ctx;
+    ring_buffer_size_t done = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        RB_COPY_OUT(cc->dst + done, spans[i].data, spans[i].len);
+        done += spans[i].len;
+    }
+    return done;
+}
+
+/**
+ * @brief 回收消费者已离开的段（生产者调用）
+ */
+static void segq_reclaim(ring_buffer_segq_t *q)
+{
+    ring_buffer_seg_t *stop = RB_LOAD_ACQUIRE(&q->read_seg);
+    
+    while (q->reclaim != stop) {
+        ring_buffer_seg_t *seg = q->reclaim;
+        q->reclaim = seg->next;
+        
+        seg->next = q->free_list;
+        q->free_list = seg;
+    }
+}
+
+/**
+ * @brief 分配一个空段：空闲链表 -> malloc（受段数上限约束）
+ * @return 空段，达到上限或内存不足时返回 NULL
+ */
+static ring_buffer_seg_t *segq_alloc(ring_buffer_segq_t *q)
+{
+    ring_buffer_seg_t *seg;
+    
+    if (!q->free_list) {
+        segq_reclaim(q);
+    }
+    
+    if (q->free_list) {
+        seg = q->free_list;
+        q->free_list = seg->next;
+        ring_buffer_clear(&seg->rb);
+        seg->next = NULL;
+        return seg;
+    }
+    
+    if (q->max_segs > 0 && q->seg_count >= q->max_segs) {
+        return NULL;
+    }
+    
+    /* malloc 只保证基本对齐，多申请一条缓存行后手动对齐 */
+    void *mem = malloc(sizeof(ring_buffer_seg_t) + q->seg_size + RING_BUFFER_CACHE_LINE - 1U);
+    if (!mem) {
+        RB_LOG_ERROR("Segment alloc failed (size=%u)", q->seg_size);
+        return NULL;
+    }
+    
+    seg = (ring_buffer_seg_t *)(((uintptr_t)mem + RING_BUFFER_CACHE_LINE - 1U) &
+                                ~(uintptr_t)(RING_BUFFER_CACHE_LINE - 1U));
+    seg->mem = mem;
+    
+    if (!ring_buffer_create(&seg->rb, (uint8_t *)(seg + 1), q->seg_size, RING_BUFFER_TYPE_LOCKFREE)) {
+        free(mem);
+        return NULL;
+    }
+    
+    seg->next = NULL;
+    q->seg_count++;
+    return seg;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_segq_init(ring_buffer_segq_t *q, ring_buffer_size_t seg_size, uint32_t max_segs)
+{
+    if (!q) {
+        RB_LOG_ERROR("q is NULL");
+        return false;
+    }
+    
+    if (seg_size < RING_BUFFER_MIN_SIZE) {
+        RB_LOG_ERROR("seg_size=%u < MIN_SIZE=%u", seg_size, RING_BUFFER_MIN_SIZE);
+        return false;
+    }
+    
+    q->seg_size = seg_size;
+    q->max_segs = max_segs;
+    q->seg_count = 0;
+    q->write_seg = NULL;
+    q->read_seg = NULL;
+    q->reclaim = NULL;
+    q->free_list = NULL;
+    
+    ring_buffer_seg_t *seg = segq_alloc(q);
+    if (!seg) {
+        return false;
+    }
+    
+    q->write_seg = seg;
+    q->read_seg = seg;
+    q->reclaim = seg;
+    
+    RB_LOG_INFO("Created segmented queue (seg_size=%u, max_segs=%lu)",
+                seg_size, (unsigned long)max_segs);
+    return true;
+}
+
+void ring_buffer_segq_deinit(ring_buffer_segq_t *q)
+{
+    if (!q || !q->reclaim) {
+        RB_LOG_ERROR("Deinit failed: queue not initialized");
+        return;
+    }
+    
+    ring_buffer_seg_t *lists[2] = {q->reclaim, q->free_list};
+    
+    for (uint8_t i = 0; i < 2; i++) {
+        ring_buffer_seg_t *seg = lists[i];
+        while (seg) {
+            ring_buffer_seg_t *next = seg->next;
+            free(seg->mem);
+            seg = next;
+        }
+    }
+    
+    q->write_seg = NULL;
+    q->read_seg = NULL;
+    q->reclaim = NULL;
+    q->free_list = NULL;
+    q->seg_count = 0;
+}
+
+ring_buffer_size_t ring_buffer_segq_write(ring_buffer_segq_t *q, const uint8_t *data, ring_buffer_size_t len)
+{
+    if (!q || !data) {
+        RB_LOG_ERROR("q or data is NULL");
+        return 0;
+    }
+    
+    segq_copy_ctx_t cc = {
+        .src = data,
+        .dst = NULL,
+    };
+    ring_buffer_size_t done = 0;
+    
+    while (done < len) {
+        cc.src = data + done;
+        done += ring_buffer_write_span(&q->write_seg->rb, len - done, segq_copy_in_cb, &cc, 0);
+        
+        if (done == len) {
+            break;
+        }
+        
+        /* 当前段已满，链接新段 */
+        ring_buffer_seg_t *seg = segq_alloc(q);
+        if (!seg) {
+            RB_LOG_WARN("Segment limit reached: requested=%u, written=%u", len, done);
+            break;
+        }
+        
+        RB_STORE_RELEASE(&q->write_seg->next, seg);
+        q->write_seg = seg;
+    }
+    
+    return done;
+}
+
+ring_buffer_size_t ring_buffer_segq_read(ring_buffer_segq_t *q, uint8_t *data, ring_buffer_size_t len)
+{
+    if (!q || !data) {
+        RB_LOG_ERROR("q or data is NULL");
+        return 0;
+    }
+    
+    segq_copy_ctx_t cc = {
+        .src = NULL,
+        .dst = data,
+    };
+    ring_buffer_seg_t *seg = q->read_seg;
+    ring_buffer_size_t done = 0;
+    
+    while (done < len) {
+        cc.dst = data + done;
+        done += ring_buffer_read_span(&seg->rb, len - done, segq_copy_out_cb, &cc, 0);
+        
+        if (done == len) {
+            break;
+        }
+        
+        ring_buffer_seg_t *next = RB_LOAD_ACQUIRE(&seg->next);
+        if (!next) {
+            break;
+        }
+        
+        /* 链接前写入的数据此时已可见，读空后才离开 */
+        if (!ring_buffer_is_empty(&seg->rb)) {
+            continue;
+        }
+        
+        seg = next;
+        RB_STORE_RELEASE(&q->read_seg, seg);
+    }
+    
+    return done;
+}
+
+ring_buffer_size_t ring_buffer_segq_available(ring_buffer_segq_t *q)
+{
+    if (!q) {
+        RB_LOG_ERROR("q is NULL");
+        return 0;
+    }
+    
+    uint32_t total = 0;
+    
+    for (ring_buffer_seg_t *seg = q->read_seg; seg; seg = RB_LOAD_ACQUIRE(&seg->next)) {
+        total += ring_buffer_available(&seg->rb);
+        if (total >= RING_BUFFER_SIZE_MAX) {
+            return (ring_buffer_size_t)RING_BUFFER_SIZE_MAX;
+        }
+    }
+    
+    return (ring_buffer_size_t)total;
+}
+
+#endif /* RING_BUFFER_ENABLE_SEGQ */
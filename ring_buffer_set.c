@@ -0,0 +1,268 @@
+/**
+ * @file    ring_buffer_set.c
+ * @brief   缓冲区集合（就绪位图 + 等待 + 轮询公平调度）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 一个消费者线程负责几十到几百个缓冲区
+ * - 逐个调用 ring_buffer_is_empty() 扫描的开销随缓冲区数量线性增长
+ *
+ * 实现要点：
+ * - 就绪位图：生产者写入后若对应位未置位则置位，消费者只遍历置位的缓冲区
+ * - 消费者取出就绪缓冲区时先清位再读取；生产者写入与检查位之间有全屏障，
+ *   二者必有一方看到对方的修改，不会丢失通知
+ * - 位由 0 变 1 时递增序号并唤醒等待者（Linux futex），无等待者时不进入内核
+ * - 从上次服务位置之后开始查找，按轮询顺序服务，避免低编号缓冲区饿死
+ *
+ * @note 每个集合只允许一个消费者；生产者可以有多个（各自写不同的缓冲区）
+ * @note 非 Linux 平台不支持阻塞等待，ring_buffer_set_next() 仅做一次查找
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_SET
+
+#if defined(__linux__)
+    #include <time.h>
+    #include <unistd.h>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #define SET_USE_FUTEX
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+
+#define SET_WORD_BITS  32U
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline uint16_t set_words(const ring_buffer_set_t *set)
+{
+    return (uint16_t)((set->count + SET_WORD_BITS - 1U) / SET_WORD_BITS);
+}
+
+static inline uint8_t set_ctz(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctz(v);
+#else
+    uint8_t n = 0;
+    while (!(v & 1U)) {
+        v >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+ * @brief 从 start 开始循环查找第一个就绪缓冲区
+ * @return 缓冲区编号，无就绪缓冲区返回 -1
+ */
+static int32_t set_find(const ring_buffer_set_t *set, uint16_t start)
+{
+    uint16_t words = set_words(set);
+    uint16_t w = (uint16_t)(start / SET_WORD_BITS);
+    uint32_t first_mask = ~0UL << (start % SET_WORD_BITS);
+    
+    /* 多扫描一次起始字，覆盖其低位部分 */
+    for (uint16_t i = 0; i <= words; i++) {
+        uint32_t bits = RB_LOAD_ACQUIRE(&set->ready[w]);
+        
+        if (i == 0) {
+            bits &= first_mask;
+        }
+        
+        if (bits) {
+            return (int32_t)(w * SET_WORD_BITS + set_ctz(bits));
+        }
+        
+        w = (uint16_t)((w + 1U == words) ? 0U : (w + 1U));
+    }
+    
+    return -1;
+}
+
+#ifdef SET_USE_FUTEX
+/**
+ * @brief 在序号未变化时睡眠，直到被唤醒或超时
+ */
+static void set_futex_wait(volatile uint32_t *addr, uint32_t expect, uint32_t timeout_ms)
+{
+    struct timespec ts;
+    struct timespec *pts = NULL;
+    
+    if (timeout_ms != RING_BUFFER_SET_WAIT_FOREVER) {
+        ts.tv_sec = (time_t)(timeout_ms / 1000U);
+        ts.tv_nsec = (long)(timeout_ms % 1000U) * 1000000L;
+        pts = &ts;
+    }
+    
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAIT_PRIVATE, expect, pts, NULL, 0);
+}
+
+static uint64_t set_now_ms(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U;
+}
+#endif
+
+/* Exported functions --------------------------------------------------------*/
+
+bool ring_buffer_set_init(ring_buffer_set_t *set)
+{
+    if (!set) {
+        RB_LOG_ERROR("set is NULL");
+        return false;
+    }
+    
+    memset(set, 0, sizeof(*set));
+    return true;
+}
+
+int32_t ring_buffer_set_add(ring_buffer_set_t *set, ring_buffer_t *rb)
+{
+    if (!set || !rb) {
+        RB_LOG_ERROR("set or rb is NULL");
+        return -1;
+    }
+    
+    if (set->count >= RING_BUFFER_SET_MAX_RINGS) {
+        RB_LOG_ERROR("Set full (%u rings)", RING_BUFFER_SET_MAX_RINGS);
+        return -1;
+    }
+    
+    uint16_t idx = set->count;
+    set->rings[idx] = rb;
+    set->count++;
+    
+    /* 加入前已有数据的缓冲区直接标记为就绪 */
+    if (!ring_buffer_is_empty(rb)) {
+        ring_buffer_set_notify(set, idx);
+    }
+    
+    return idx;
+}
+
+void ring_buffer_set_notify(ring_buffer_set_t *set, uint16_t idx)
+{
+    if (!set || idx >= set->count) {
+        RB_LOG_ERROR("set is NULL or idx out of range");
+        return;
+    }
+    
+    volatile uint32_t *word = &set->ready[idx / SET_WORD_BITS];
+    uint32_t bit = 1UL << (idx % SET_WORD_BITS);
+    
+    /* 与消费者"先清位再读取"配对：数据写入对其可见，或位的清除对本方可见 */
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+    
+    /* 已就绪时不重复写共享位图 */
+    if (RB_LOAD_ACQUIRE(word) & bit) {
+        return;
+    }
+    
+    if (RB_FETCH_OR(word, bit) & bit) {
+        return;
+    }
+    
+#ifdef SET_USE_FUTEX
+    __atomic_fetch_add(&set->seq, 1U, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&set->waiters, __ATOMIC_SEQ_CST) > 0) {
+        syscall(SYS_futex, (uint32_t *)&set->seq, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+#endif
+}
+
+ring_buffer_size_t ring_buffer_set_write(ring_buffer_set_t *set, uint16_t idx,
+                                         const uint8_t *data, ring_buffer_size_t len)
+{
+    if (!set || idx >= set->count) {
+        RB_LOG_ERROR("set is NULL or idx out of range");
+        return 0;
+    }
+    
+    ring_buffer_size_t n = ring_buffer_write_multi(set->rings[idx], data, len);
+    
+    if (n > 0) {
+        ring_buffer_set_notify(set, idx);
+    }
+    return n;
+}
+
+int32_t ring_buffer_set_next(ring_buffer_set_t *set, uint32_t timeout_ms)
+{
+    if (!set || set->count == 0) {
+        RB_LOG_ERROR("set is NULL or empty");
+        return -1;
+    }
+    
+#ifdef SET_USE_FUTEX
+    uint64_t deadline = 0;
+    if (timeout_ms != RING_BUFFER_SET_WAIT_FOREVER) {
+        deadline = set_now_ms() + timeout_ms;
+    }
+#endif
+    
+    for (;;) {
+        uint32_t seq = RB_LOAD_ACQUIRE(&set->seq);
+        int32_t idx = set_find(set, set->cursor);
+        
+        if (idx >= 0) {
+            /* 先清位再由调用者读取，与生产者的屏障配对 */
+            RB_FETCH_AND(&set->ready[idx / SET_WORD_BITS], ~(1UL << (idx % SET_WORD_BITS)));
+#if defined(__GNUC__) || defined(__clang__)
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+            set->cursor = (uint16_t)((idx + 1 >= set->count) ? 0 : (idx + 1));
+            return idx;
+        }
+        
+#ifdef SET_USE_FUTEX
+        uint32_t wait_ms = RING_BUFFER_SET_WAIT_FOREVER;
+        if (timeout_ms != RING_BUFFER_SET_WAIT_FOREVER) {
+            uint64_t now = set_now_ms();
+            if (now >= deadline) {
+                return -1;
+            }
+            wait_ms = (uint32_t)(deadline - now);
+        }
+        
+        __atomic_fetch_add(&set->waiters, 1U, __ATOMIC_SEQ_CST);
+        
+        /* 登记等待者后复查，避免与生产者的唤醒交错 */
+        if (set_find(set, set->cursor) < 0) {
+            set_futex_wait(&set->seq, seq, wait_ms);
+        }
+        
+        __atomic_fetch_sub(&set->waiters, 1U, __ATOMIC_SEQ_CST);
+#else
+        (void)seq;
+        (void)timeout_ms;
+        return -1;
+#endif
+    }
+}
+
+void ring_buffer_set_done(ring_buffer_set_t *set, uint16_t idx)
+{
+    if (!set || idx >= set->count) {
+        RB_LOG_ERROR("set is NULL or idx out of range");
+        return;
+    }
+    
+    /* 未读完的缓冲区重新标记为就绪，留待下一轮 */
+    if (!ring_buffer_is_empty(set->rings[idx])) {
+        ring_buffer_set_notify(set, idx);
+    }
+}
+
+#endif /* RING_BUFFER_ENABLE_SET */
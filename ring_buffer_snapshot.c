@@ -0,0 +1,93 @@
+/**
+ * @file    ring_buffer_snapshot.c
+ * @brief   快照读取（不移除数据、不加锁的监控读取）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 诊断线程转储运行中缓冲区的最近内容
+ * - read_multi 会移除数据，加互斥锁会阻塞真正的消费者
+ *
+ * 实现要点：
+ * - 以读指针为序号（顺序锁读端）：先读读指针、写指针，再复制，复制后重新读取读指针
+ * - 生产者只会覆盖消费者已释放的区域；读指针前进的距离未超过所复制区域的起点，
+ *   说明复制期间该区域未被释放，数据有效，否则重试
+ * - 只读取 head/tail，不写任何字段，生产者与消费者的热路径没有额外开销
+ *
+ * @note 读写指针按 size 取模，若复制期间读指针恰好前进整数圈则无法察觉；
+ *       监控用途下复制远短于缓冲区一圈的时间，可忽略
+ * @note 批量发布模式只能看到已发布的数据；自定义策略须同样使用 head/tail 表示数据区
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_SNAPSHOT
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 环上从 from 到 to 的距离
+ */
+static inline ring_buffer_size_t snapshot_dist(ring_buffer_size_t from, ring_buffer_size_t to,
+                                               ring_buffer_size_t size)
+{
+    return (ring_buffer_size_t)((to >= from) ? (to - from) : (size - from + to));
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+ring_buffer_size_t ring_buffer_snapshot(const ring_buffer_t *rb, uint8_t *data,
+                                        ring_buffer_size_t len, uint8_t flags)
+{
+    if (!rb || !data) {
+        RB_LOG_ERROR("rb or data is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    ring_buffer_size_t size = rb->size;
+    
+    for (uint8_t attempt = 0; attempt < RING_BUFFER_SNAPSHOT_RETRIES; attempt++) {
+        /* 先读读指针：其后读到的写指针之前的数据都已发布 */
+        ring_buffer_size_t tail = RB_LOAD_ACQUIRE(&rb->tail);
+        ring_buffer_size_t head = RB_LOAD_ACQUIRE(&rb->head);
+        ring_buffer_size_t avail = snapshot_dist(tail, head, size);
+        ring_buffer_size_t n = (len < avail) ? len : avail;
+        
+        if (n == 0) {
+            return 0;
+        }
+        
+        ring_buffer_size_t off = (flags & RING_BUFFER_SNAPSHOT_LATEST) ? (ring_buffer_size_t)(avail - n) : 0;
+        ring_buffer_size_t start = (ring_buffer_size_t)((tail + off) % size);
+        ring_buffer_size_t first = (ring_buffer_size_t)(size - start);
+        
+        if (first >= n) {
+            RB_COPY_OUT(data, &rb->buffer[start], n);
+        } else {
+            RB_COPY_OUT(data, &rb->buffer[start], first);
+            RB_COPY_OUT(data + first, rb->buffer, n - first);
+        }
+        
+        /* 复制完成后再读读指针（顺序锁读端的校验） */
+#if defined(__GNUC__) || defined(__clang__)
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+#endif
+        ring_buffer_size_t consumed = snapshot_dist(tail, RB_LOAD_ACQUIRE(&rb->tail), size);
+        
+        if (consumed <= off) {
+            return n;
+        }
+    }
+    
+    RB_LOG_WARN("Snapshot retries exhausted (len=%u)", len);
+    return 0;
+}
+
+#endif /* RING_BUFFER_ENABLE_SNAPSHOT */
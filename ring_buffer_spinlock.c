@@ -0,0 +1,338 @@
+/**
+ * @file    ring_buffer_spinlock.c
+ * @brief   环形缓冲区排队自旋锁实现（多核主机）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - Linux 等多核主机上多生产者/多消费者共享缓冲区
+ * - 临界区极短（拷贝几十字节），pthread 互斥锁的系统调用与唤醒开销占主导
+ * - 关中断模式的多核替代：同样复用无锁实现的内部逻辑，只替换临界区
+ *
+ * 实现要点：
+ * - 票号锁：先到先得，无饥饿；锁状态为控制块内两个 32 位计数
+ * - 比例退避：按前面排队的等待者数量 pause，减少对锁所在缓存行的争抢
+ * - 自旋若干轮仍未轮到时让出 CPU，避免线程数超过核数时空转整个时间片
+ *
+ * @warning
+ * - 不适用于中断上下文（持锁线程被中断打断时会死锁）
+ * - 回调在持锁状态下执行，应尽量简短
+ * - 竞争线程数应不超过 CPU 核数：票号锁按顺序交接，排在前面的线程被调度走时
+ *   后面的线程只能等待，线程数超过核数时吞吐会急剧下降
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_SPINLOCK
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sched.h>
+    #define SPIN_YIELD()    sched_yield()
+#else
+    #define SPIN_YIELD()    ((void)0)
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define SPIN_RELAX()    __builtin_ia32_pause()
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+    #define SPIN_RELAX()    __asm__ __volatile__("yield" ::: "memory")
+#else
+    #define SPIN_RELAX()    __asm__ __volatile__("" ::: "memory")
+#endif
+
+/* 复用无锁实现的内部逻辑 */
+extern const struct ring_buffer_ops ring_buffer_lockfree_ops;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 取号并等待轮到自己
+ * @note 查询类接口的 rb 为 const，锁字段为 volatile 成员，这里统一去掉 const
+ */
+static inline void spin_lock(const ring_buffer_t *crb)
+{
+    ring_buffer_t *rb = (ring_buffer_t *)crb;
+    uint32_t me = __atomic_fetch_add(&rb->spin_next, 1U, __ATOMIC_RELAXED);
+    uint32_t rounds = 0;
+    
+    for (;;) {
+        uint32_t owner = __atomic_load_n(&rb->spin_owner, __ATOMIC_ACQUIRE);
+        if (owner == me) {
+            return;
+        }
+        
+        for (uint32_t n = (me - owner) * RING_BUFFER_SPIN_BACKOFF; n > 0; n--) {
+            SPIN_RELAX();
+        }
+        
+        if (RING_BUFFER_SPIN_YIELD_AFTER > 0 && ++rounds >= RING_BUFFER_SPIN_YIELD_AFTER) {
+            rounds = 0;
+            SPIN_YIELD();
+        }
+    }
+}
+
+static inline void spin_unlock(const ring_buffer_t *crb)
+{
+    ring_buffer_t *rb = (ring_buffer_t *)crb;
+    
+    /* 只有持锁者修改 spin_owner，无需读改写原子操作 */
+    __atomic_store_n(&rb->spin_owner, rb->spin_owner + 1U, __ATOMIC_RELEASE);
+}
+
+/* Exported functions (Implementation) ---------------------------------------*/
+
+static bool spinlock_write(ring_buffer_t *rb, uint8_t data)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return false;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return false;
+    }
+    
+    spin_lock(rb);
+    
+    bool ret = ring_buffer_lockfree_ops.write(rb, data);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static bool spinlock_read(ring_buffer_t *rb, uint8_t *data)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return false;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return false;
+    }
+    
+    if (!data) {
+        RB_LOG_ERROR("data is NULL (rb=%p)", rb);
+        return false;
+    }
+    
+    spin_lock(rb);
+    
+    bool ret = ring_buffer_lockfree_ops.read(rb, data);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static ring_buffer_size_t spinlock_write_multi(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!data) {
+        RB_LOG_ERROR("data is NULL (rb=%p, len=%u)", rb, len);
+        return 0;
+    }
+    
+    if (len == 0) {
+        RB_LOG_WARN("len is 0");
+        return 0;
+    }
+    
+    spin_lock(rb);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.write_multi(rb, data, len);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static ring_buffer_size_t spinlock_read_multi(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!data) {
+        RB_LOG_ERROR("data is NULL (rb=%p, len=%u)", rb, len);
+        return 0;
+    }
+    
+    if (len == 0) {
+        RB_LOG_WARN("len is 0");
+        return 0;
+    }
+    
+    spin_lock(rb);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.read_multi(rb, data, len);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static ring_buffer_size_t spinlock_read_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                             ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 注意: 回调在持锁状态下执行 */
+    spin_lock(rb);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.read_span(rb, len, fn, ctx, flags);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static ring_buffer_size_t spinlock_write_span(ring_buffer_t *rb, ring_buffer_size_t len,
+                                              ring_buffer_span_fn_t fn, void *ctx, uint8_t flags)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    if (!rb->buffer) {
+        RB_LOG_ERROR("buffer is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    if (!fn) {
+        RB_LOG_ERROR("fn is NULL (rb=%p)", rb);
+        return 0;
+    }
+    
+    /* 注意: 回调在持锁状态下执行 */
+    spin_lock(rb);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.write_span(rb, len, fn, ctx, flags);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static ring_buffer_size_t spinlock_available(const ring_buffer_t *rb)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    spin_lock(rb);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.available(rb);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static ring_buffer_size_t spinlock_free_space(const ring_buffer_t *rb)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return 0;
+    }
+    
+    spin_lock(rb);
+    
+    ring_buffer_size_t ret = ring_buffer_lockfree_ops.free_space(rb);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static bool spinlock_is_empty(const ring_buffer_t *rb)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return true;
+    }
+    
+    spin_lock(rb);
+    
+    bool ret = ring_buffer_lockfree_ops.is_empty(rb);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static bool spinlock_is_full(const ring_buffer_t *rb)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return false;
+    }
+    
+    spin_lock(rb);
+    
+    bool ret = ring_buffer_lockfree_ops.is_full(rb);
+    
+    spin_unlock(rb);
+    return ret;
+}
+
+static void spinlock_clear(ring_buffer_t *rb)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return;
+    }
+    
+    spin_lock(rb);
+    
+    ring_buffer_lockfree_ops.clear(rb);
+    
+    spin_unlock(rb);
+    
+    RB_LOG_INFO("Spinlock buffer cleared");
+}
+
+/* Exported constant ---------------------------------------------------------*/
+
+const ring_buffer_ops_t ring_buffer_spinlock_ops = {
+    .write       = spinlock_write,
+    .read        = spinlock_read,
+    .write_multi = spinlock_write_multi,
+    .read_multi  = spinlock_read_multi,
+    .available   = spinlock_available,
+    .free_space  = spinlock_free_space,
+    .is_empty    = spinlock_is_empty,
+    .is_full     = spinlock_is_full,
+    .clear       = spinlock_clear,
+    .read_span   = spinlock_read_span,
+    .write_span  = spinlock_write_span,
+};
+
+#endif /* RING_BUFFER_ENABLE_SPINLOCK */
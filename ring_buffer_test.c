@@ -11,6 +11,23 @@
 #include <assert.h>
 #include "ring_buffer.h"
 
+#if RING_BUFFER_ENABLE_FD_IO || RING_BUFFER_ENABLE_AIO || RING_BUFFER_ENABLE_PERSIST || RING_BUFFER_ENABLE_TRACE || \
+    RING_BUFFER_ENABLE_PIPELINE
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+#if RING_BUFFER_ENABLE_PERSIST
+#include <sys/wait.h>
+#endif
+
+#if (RING_BUFFER_ENABLE_SET && defined(__linux__)) || RING_BUFFER_ENABLE_DEQUE || RING_BUFFER_ENABLE_MPSC || \
+    RING_BUFFER_ENABLE_SPINLOCK || RING_BUFFER_ENABLE_SNAPSHOT
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
 /* Test utilities ------------------------------------------------------------*/
 
 #define TEST_ASSERT(cond) do { \
@@ -174,13 +191,21 @@ bool test_wrap_around(void)
         TEST_ASSERT(data == i);
     }
     
-    /* д5Ի */
-    for (int i = 100; i < 105; i++) {
+    /* д3ǡڳĿռ䣩дָ */
+    for (int i = 100; i < 103; i++) {
         TEST_ASSERT(ring_buffer_write(&rb, i));
     }
+    TEST_ASSERT(ring_buffer_is_full(&rb));
+    TEST_ASSERT(!ring_buffer_write(&rb, 0xFF));
     
-    /* ֤ */
-    TEST_ASSERT(ring_buffer_available(&rb) == 9);  // 4 + 5
+    /* ֤ݣ4 + 3д˳ԽƵ */
+    TEST_ASSERT(ring_buffer_available(&rb) == 7);
+    const uint8_t expect[7] = {3, 4, 5, 6, 100, 101, 102};
+    for (int i = 0; i < 7; i++) {
+        TEST_ASSERT(ring_buffer_read(&rb, &data));
+        TEST_ASSERT(data == expect[i]);
+    }
+    TEST_ASSERT(ring_buffer_is_empty(&rb));
     
     ring_buffer_destroy(&rb);
     return true;
@@ -253,6 +278,1604 @@ bool test_clear(void)
     return true;
 }
 
+bool test_peek_find(void)
+{
+    static uint8_t buffer[16];
+    ring_buffer_t rb;
+    
+    ring_buffer_create(&rb, buffer, 16, RING_BUFFER_TYPE_LOCKFREE);
+    
+    /* ƽдָ룬ʹݿԽĩβ */
+    uint8_t pad[12] = {0};
+    uint8_t tmp[12];
+    ring_buffer_write_multi(&rb, pad, 12);
+    ring_buffer_read_multi(&rb, tmp, 12);
+    
+    uint8_t frame[] = {'A', 'T', '+', 'O', 'K', '\r', '\n', 'X'};
+    TEST_ASSERT(ring_buffer_write_multi(&rb, frame, 8) == 8);
+    
+    /* 绷ƵԤ */
+    uint8_t peek[4];
+    TEST_ASSERT(ring_buffer_peek_at(&rb, 2, peek, 4) == 4);
+    TEST_ASSERT(memcmp(peek, &frame[2], 4) == 0);
+    TEST_ASSERT(ring_buffer_peek_at(&rb, 6, peek, 4) == 2);
+    TEST_ASSERT(ring_buffer_available(&rb) == 8);
+    
+    /*  */
+    ring_buffer_size_t pos;
+    TEST_ASSERT(ring_buffer_find(&rb, '\n', &pos));
+    TEST_ASSERT(pos == 6);
+    TEST_ASSERT(!ring_buffer_find(&rb, 'Z', &pos));
+    
+    uint8_t set[] = {'\r', '\n'};
+    TEST_ASSERT(ring_buffer_find_any(&rb, set, 2, &pos));
+    TEST_ASSERT(pos == 5);
+    
+    /* ָȡ */
+    uint8_t line[16];
+    TEST_ASSERT(ring_buffer_read_until(&rb, '\n', line, 4) == 0);
+    TEST_ASSERT(ring_buffer_read_until(&rb, '\n', line, 16) == 7);
+    TEST_ASSERT(memcmp(line, frame, 7) == 0);
+    TEST_ASSERT(ring_buffer_available(&rb) == 1);
+    TEST_ASSERT(ring_buffer_read_until(&rb, '\n', line, 16) == 0);
+    
+    ring_buffer_destroy(&rb);
+    return true;
+}
+
+bool test_fused_xform(void)
+{
+    static uint8_t buffer[15];
+    ring_buffer_t rb;
+    
+    ring_buffer_create(&rb, buffer, 15, RING_BUFFER_TYPE_LOCKFREE);
+    
+    /* CRC32C ׼Уֵ */
+    const uint8_t check[] = "123456789";
+    TEST_ASSERT(ring_buffer_crc32c(0, check, 9) == 0xE3069283UL);
+    
+    /* дȡʱֱۼӣӦһ */
+    uint32_t wcrc = 0, rcrc = 0;
+    uint8_t out[16];
+    TEST_ASSERT(ring_buffer_write_multi_crc32c(&rb, check, 9, &wcrc) == 9);
+    TEST_ASSERT(ring_buffer_read_multi_crc32c(&rb, out, 9, &rcrc) == 9);
+    TEST_ASSERT(wcrc == 0xE3069283UL && rcrc == wcrc);
+    TEST_ASSERT(memcmp(out, check, 9) == 0);
+    
+    /* ֽת size ֿԽĩβ */
+    uint8_t be[8] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+    TEST_ASSERT(ring_buffer_write_multi_bswap(&rb, be, 8, 4) == 8);
+    TEST_ASSERT(buffer[9] == 0x78 && buffer[14] == 0xDE && buffer[0] == 0xBC);
+    TEST_ASSERT(ring_buffer_read_multi_bswap(&rb, out, 7, 2) == 6);
+    TEST_ASSERT(out[0] == 0x56 && out[1] == 0x78 && out[4] == 0xDE && out[5] == 0xF0);
+    TEST_ASSERT(ring_buffer_available(&rb) == 2);
+    ring_buffer_clear(&rb);
+    
+    /* int16 -> float */
+    int16_t pcm[5] = {0, 16384, -16384, 32767, -32768};
+    float f[5];
+    ring_buffer_write_multi(&rb, (const uint8_t *)pcm, sizeof(pcm));
+    TEST_ASSERT(ring_buffer_read_s16_to_f32(&rb, f, 5, 1.0f / 32768) == 5);
+    TEST_ASSERT(f[0] == 0.0f && f[1] == 0.5f && f[2] == -0.5f && f[4] == -1.0f);
+    
+    ring_buffer_destroy(&rb);
+    return true;
+}
+
+#if RING_BUFFER_ENABLE_COPY_ENGINE
+bool test_copy_engine(void)
+{
+    static uint8_t buffer[3000];
+    static uint8_t src[2000], dst[2000];
+    ring_buffer_t rb;
+    
+    ring_buffer_create(&rb, buffer, 3000, RING_BUFFER_TYPE_LOCKFREE);
+    for (uint16_t i = 0; i < sizeof(src); i++) {
+        src[i] = (uint8_t)(i * 7 + 1);
+    }
+    
+    /* ֵΪ 0ǿʽ洢Ԥȡ· */
+    ring_buffer_copy_set_threshold(0, 0);
+    TEST_ASSERT(ring_buffer_copy_kernel_name() != NULL);
+    
+    /* ڶֿԽĩβγȾ */
+    for (uint8_t round = 0; round < 2; round++) {
+        memset(dst, 0, sizeof(dst));
+        TEST_ASSERT(ring_buffer_write_multi(&rb, src, 2000) == 2000);
+        TEST_ASSERT(ring_buffer_read_multi(&rb, dst, 2000) == 2000);
+        TEST_ASSERT(memcmp(src, dst, 2000) == 0);
+    }
+    
+    ring_buffer_copy_set_threshold(RING_BUFFER_SIZE_MAX, RING_BUFFER_SIZE_MAX);
+    ring_buffer_destroy(&rb);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+bool test_batch_publish(void)
+{
+    static uint8_t buffer[64];
+    uint8_t data[64] = {0};
+    ring_buffer_t rb;
+    
+    TEST_ASSERT(ring_buffer_create(&rb, buffer, 64, RING_BUFFER_TYPE_LOCKFREE_BATCH));
+    TEST_ASSERT(ring_buffer_set_batch(&rb, 8, 0));
+    TEST_ASSERT(!ring_buffer_set_batch(&rb, 0, 0));
+    
+    /* δһʱ߲ɼ */
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 4) == 4);
+    TEST_ASSERT(ring_buffer_available(&rb) == 0);
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 4) == 4);
+    TEST_ASSERT(ring_buffer_available(&rb) == 8);
+    
+    /* ʽˢ */
+    TEST_ASSERT(ring_buffer_write(&rb, 0xAA));
+    TEST_ASSERT(ring_buffer_available(&rb) == 8);
+    ring_buffer_flush(&rb, RING_BUFFER_FLUSH_WRITE);
+    TEST_ASSERT(ring_buffer_available(&rb) == 9);
+    
+    /* ָͬͷţʱͷ */
+    TEST_ASSERT(ring_buffer_read_multi(&rb, data, 3) == 3);
+    TEST_ASSERT(ring_buffer_free_space(&rb) == 54);
+    TEST_ASSERT(ring_buffer_read_multi(&rb, data, 5) == 5);
+    TEST_ASSERT(ring_buffer_free_space(&rb) == 62);
+    TEST_ASSERT(ring_buffer_read_multi(&rb, data, 4) == 1 && data[0] == 0xAA);
+    TEST_ASSERT(ring_buffer_free_space(&rb) == 63);
+    
+    /* ֵضϵ 1/4 */
+    TEST_ASSERT(ring_buffer_set_batch(&rb, 1000, 0));
+    TEST_ASSERT(rb.batch_bytes == RING_BUFFER_BATCH_LIMIT(64));
+    ring_buffer_destroy(&rb);
+    
+    /* Ĭֵǡдǡöʱѯ is_full/is_empty ˫ụ */
+    TEST_ASSERT(ring_buffer_create(&rb, buffer, 64, RING_BUFFER_TYPE_LOCKFREE_BATCH));
+    TEST_ASSERT(rb.batch_bytes <= RING_BUFFER_BATCH_LIMIT(64));
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 63) == 63);
+    TEST_ASSERT(!ring_buffer_is_empty(&rb) && ring_buffer_available(&rb) == 63);
+    TEST_ASSERT(ring_buffer_read_multi(&rb, data, 63) == 63);
+    TEST_ASSERT(!ring_buffer_is_full(&rb) && ring_buffer_free_space(&rb) == 63);
+    
+    /* ֽд */
+    for (int i = 0; i < 63; i++) {
+        TEST_ASSERT(ring_buffer_write(&rb, (uint8_t)i));
+    }
+    TEST_ASSERT(ring_buffer_available(&rb) == 63);
+    
+    ring_buffer_destroy(&rb);
+    return true;
+}
+#endif
+
+bool test_iov(void)
+{
+    static uint8_t buffer[16];
+    ring_buffer_t rb;
+    
+    ring_buffer_create(&rb, buffer, 16, RING_BUFFER_TYPE_LOCKFREE);
+    
+    uint8_t hdr[2] = {0xAA, 0x05};
+    uint8_t payload[5] = {1, 2, 3, 4, 5};
+    uint8_t tail[1] = {0x55};
+    ring_buffer_iovec_t msg[3] = {
+        {hdr, 2}, {payload, 5}, {tail, 1},
+    };
+    
+    /* ۼд룺Ϣд룬ռ䲻ʱ */
+    TEST_ASSERT(ring_buffer_writev(&rb, msg, 3) == 8);
+    TEST_ASSERT(ring_buffer_available(&rb) == 8);
+    TEST_ASSERT(ring_buffer_writev(&rb, msg, 3) == 0);
+    TEST_ASSERT(ring_buffer_available(&rb) == 8);
+    
+    /* ɢȡ */
+    uint8_t h[2], p[5], t[1];
+    ring_buffer_iovec_t out[3] = {
+        {h, 2}, {p, 5}, {t, 1},
+    };
+    TEST_ASSERT(ring_buffer_readv(&rb, out, 3) == 8);
+    TEST_ASSERT(h[1] == 0x05 && p[4] == 5 && t[0] == 0x55);
+    
+    /* Խĩβ */
+    TEST_ASSERT(ring_buffer_writev(&rb, msg, 3) == 8);
+    TEST_ASSERT(ring_buffer_writev(&rb, msg, 3) == 0);
+    memset(p, 0, sizeof(p));
+    TEST_ASSERT(ring_buffer_readv(&rb, out, 3) == 8);
+    TEST_ASSERT(memcmp(p, payload, 5) == 0 && t[0] == 0x55);
+    
+    ring_buffer_destroy(&rb);
+    return true;
+}
+
+#if RING_BUFFER_ENABLE_FD_IO
+bool test_fd_io(void)
+{
+    static uint8_t buffer[16];
+    ring_buffer_t rb;
+    int fds[2];
+    uint8_t data[20];
+    
+    TEST_ASSERT(pipe(fds) == 0);
+    ring_buffer_create(&rb, buffer, 16, RING_BUFFER_TYPE_LOCKFREE);
+    
+    for (uint8_t i = 0; i < 20; i++) {
+        data[i] = i;
+    }
+    
+    /* ÿпռ价ƣreadv  */
+    ring_buffer_write_multi(&rb, data, 10);
+    ring_buffer_read_multi(&rb, data, 10);
+    TEST_ASSERT(write(fds[1], data, 12) == 12);
+    TEST_ASSERT(ring_buffer_fill_from_fd(&rb, fds[0], 15) == 12);
+    TEST_ASSERT(ring_buffer_available(&rb) == 12);
+    
+    /* ݶλƣwritev д */
+    TEST_ASSERT(ring_buffer_drain_to_fd(&rb, fds[1], 15) == 12);
+    TEST_ASSERT(ring_buffer_is_empty(&rb));
+    memset(data, 0, sizeof(data));
+    TEST_ASSERT(read(fds[0], data, sizeof(data)) == 12);
+    TEST_ASSERT(data[0] == 0 && data[11] == 11);
+    
+    /* ʱ -1 */
+    close(fds[1]);
+    ring_buffer_write_multi(&rb, data, 4);
+    TEST_ASSERT(ring_buffer_drain_to_fd(&rb, -1, 4) == -1);
+    TEST_ASSERT(ring_buffer_available(&rb) == 4);
+    
+    close(fds[0]);
+    ring_buffer_destroy(&rb);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_AIO
+bool test_aio(void)
+{
+    static uint8_t buffer[4096];
+    static uint8_t data[20000], check[20000];
+    ring_buffer_t rb;
+    ring_buffer_aio_t aio;
+    char path[] = "/tmp/rb_aio_XXXXXX";
+    int fd = mkstemp(path);
+    int fds[2];
+    
+    TEST_ASSERT(fd >= 0 && pipe(fds) == 0);
+    unlink(path);
+    
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 31 + (i >> 8));
+    }
+    
+    /* ļĿ꣺ֺ˸дһΣio_uring ʱ AUTO ˻Ϊ̳߳أ*/
+    ring_buffer_aio_backend_t backends[2] = {RING_BUFFER_AIO_AUTO, RING_BUFFER_AIO_THREAD};
+    for (uint8_t b = 0; b < 2; b++) {
+        ring_buffer_create(&rb, buffer, sizeof(buffer), RING_BUFFER_TYPE_LOCKFREE);
+        TEST_ASSERT(ring_buffer_aio_init(&aio, &rb, fd, 0, backends[b]));
+        
+        /* ԶСɺͷſռ */
+        uint32_t sent = 0;
+        while (sent < sizeof(data)) {
+            ring_buffer_size_t n = (ring_buffer_size_t)(sizeof(data) - sent);
+            n = (n > 1000) ? 1000 : n;
+            if (ring_buffer_free_space(&rb) >= n) {
+                sent += ring_buffer_write_multi(&rb, &data[sent], n);
+            }
+            TEST_ASSERT(ring_buffer_aio_poll(&aio, ring_buffer_free_space(&rb) < n) >= 0);
+        }
+        TEST_ASSERT(ring_buffer_aio_drain(&aio));
+        TEST_ASSERT(ring_buffer_is_empty(&rb) && aio.inflight == 0);
+        ring_buffer_aio_deinit(&aio);
+        
+        memset(check, 0, sizeof(check));
+        TEST_ASSERT(pread(fd, check, sizeof(check), 0) == (ssize_t)sizeof(check));
+        TEST_ASSERT(memcmp(data, check, sizeof(data)) == 0);
+        ring_buffer_destroy(&rb);
+    }
+    
+    /* ʽĿ꣺ܵ˳д */
+    ring_buffer_create(&rb, buffer, sizeof(buffer), RING_BUFFER_TYPE_LOCKFREE);
+    TEST_ASSERT(ring_buffer_aio_init(&aio, &rb, fds[1], -1, RING_BUFFER_AIO_AUTO));
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 3000) == 3000);
+    TEST_ASSERT(ring_buffer_aio_drain(&aio));
+    ring_buffer_aio_deinit(&aio);
+    TEST_ASSERT(read(fds[0], check, sizeof(check)) == 3000);
+    TEST_ASSERT(memcmp(data, check, 3000) == 0);
+    
+    /* дݱڻ */
+    close(fds[0]);
+    close(fds[1]);
+    TEST_ASSERT(ring_buffer_aio_init(&aio, &rb, fds[1], -1, RING_BUFFER_AIO_THREAD));
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 10) == 10);
+    TEST_ASSERT(!ring_buffer_aio_drain(&aio));
+    TEST_ASSERT(aio.error != 0 && ring_buffer_available(&rb) == 10);
+    ring_buffer_aio_deinit(&aio);
+    
+    close(fd);
+    ring_buffer_destroy(&rb);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_PERSIST
+bool test_persist(void)
+{
+    ring_buffer_persist_t pr;
+    uint8_t out[16];
+    char path[] = "/tmp/rb_persist_XXXXXX";
+    int fd = mkstemp(path);
+    
+    TEST_ASSERT(fd >= 0);
+    close(fd);
+    
+    /* ӽд󲻹رֱ˳ģ */
+    pid_t pid = fork();
+    TEST_ASSERT(pid >= 0);
+    if (pid == 0) {
+        if (!ring_buffer_persist_open(&pr, path, 64, 0)) {
+            _exit(1);
+        }
+        ring_buffer_write_multi(&pr.rb, (const uint8_t *)"hello world", 11);
+        ring_buffer_read_multi(&pr.rb, out, 6);
+        _exit(0);
+    }
+    
+    int status = 0;
+    TEST_ASSERT(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    
+    /* ´򿪣ָδ */
+    TEST_ASSERT(ring_buffer_persist_open(&pr, path, 64, 16));
+    TEST_ASSERT(ring_buffer_available(&pr.rb) == 5);
+    TEST_ASSERT(ring_buffer_read_multi(&pr.rb, out, sizeof(out)) == 5);
+    TEST_ASSERT(memcmp(out, "world", 5) == 0);
+    
+    /* Խĩβдر */
+    for (uint8_t i = 0; i < 60; i++) {
+        TEST_ASSERT(ring_buffer_write(&pr.rb, i));
+    }
+    TEST_ASSERT(ring_buffer_read_multi(&pr.rb, out, 10) == 10);
+    ring_buffer_persist_close(&pr);
+    
+    TEST_ASSERT(ring_buffer_persist_open(&pr, path, 64, 0));
+    TEST_ASSERT(ring_buffer_available(&pr.rb) == 50);
+    TEST_ASSERT(ring_buffer_read(&pr.rb, out) && out[0] == 10);
+    ring_buffer_persist_close(&pr);
+    
+    /* һµļܾ */
+    TEST_ASSERT(!ring_buffer_persist_open(&pr, path, 128, 0));
+    
+    unlink(path);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_SEGQ
+bool test_segq(void)
+{
+    ring_buffer_segq_t q;
+    uint8_t data[300], out[300];
+    
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7 + 1);
+    }
+    
+    /* ÿ 64 ֽڣ 4  */
+    TEST_ASSERT(ring_buffer_segq_init(&q, 64, 4));
+    TEST_ASSERT(q.seg_count == 1);
+    
+    /* ͻд볬¶ */
+    TEST_ASSERT(ring_buffer_segq_write(&q, data, 150) == 150);
+    TEST_ASSERT(q.seg_count == 3);
+    TEST_ASSERT(ring_buffer_segq_available(&q) == 150);
+    
+    /* ﵽޣд */
+    ring_buffer_size_t n = ring_buffer_segq_write(&q, &data[150], 150);
+    TEST_ASSERT(n > 0 && n < 150 && q.seg_count == 4);
+    
+    /* д˳ζ */
+    TEST_ASSERT(ring_buffer_segq_read(&q, out, sizeof(out)) == 150 + n);
+    TEST_ASSERT(memcmp(out, data, 150 + n) == 0);
+    TEST_ASSERT(ring_buffer_segq_available(&q) == 0);
+    
+    /* յĶαոãٷ¶ */
+    for (uint8_t round = 0; round < 10; round++) {
+        TEST_ASSERT(ring_buffer_segq_write(&q, data, 200) == 200);
+        TEST_ASSERT(ring_buffer_segq_read(&q, out, 120) == 120);
+        TEST_ASSERT(ring_buffer_segq_read(&q, &out[120], 200) == 80);
+        TEST_ASSERT(memcmp(out, data, 200) == 0);
+    }
+    TEST_ASSERT(q.seg_count == 4);
+    
+    ring_buffer_segq_deinit(&q);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_POOL
+bool test_pool(void)
+{
+    static uint8_t arena[8 * RING_BUFFER_POOL_SLOT_SIZE(100) + RING_BUFFER_CACHE_LINE];
+    ring_buffer_pool_t pool;
+    ring_buffer_t *rings[8];
+    uint8_t byte;
+    
+    TEST_ASSERT(ring_buffer_pool_init(&pool, arena, sizeof(arena), 100, RING_BUFFER_TYPE_LOCKFREE));
+    TEST_ASSERT(pool.capacity == 8);
+    
+    /* ƿ洢ж룬 */
+    for (uint8_t i = 0; i < 8; i++) {
+        rings[i] = ring_buffer_pool_alloc(&pool);
+        TEST_ASSERT(rings[i] != NULL);
+        TEST_ASSERT((uintptr_t)rings[i] % RING_BUFFER_CACHE_LINE == 0);
+        TEST_ASSERT((uintptr_t)rings[i]->buffer % RING_BUFFER_CACHE_LINE == 0);
+        TEST_ASSERT(ring_buffer_write(rings[i], i));
+    }
+    for (uint8_t i = 0; i < 8; i++) {
+        TEST_ASSERT(ring_buffer_read(rings[i], &byte) && byte == i);
+    }
+    
+    /* ľʧܣͷźͬһλ */
+    TEST_ASSERT(ring_buffer_pool_alloc(&pool) == NULL);
+    TEST_ASSERT(ring_buffer_pool_free(&pool, rings[3]));
+    TEST_ASSERT(!ring_buffer_pool_free(&pool, rings[3]));
+    TEST_ASSERT(!ring_buffer_pool_free(&pool, (ring_buffer_t *)(void *)((uint8_t *)rings[2] + 8)));
+    TEST_ASSERT(ring_buffer_pool_alloc(&pool) == rings[3]);
+    TEST_ASSERT(ring_buffer_is_empty(rings[3]));
+    
+    for (uint8_t i = 0; i < 8; i++) {
+        TEST_ASSERT(ring_buffer_pool_free(&pool, rings[i]));
+    }
+    TEST_ASSERT(pool.used == 0);
+    ring_buffer_pool_deinit(&pool);
+    
+#if defined(__unix__) || defined(__APPLE__)
+    /* mmap arenaҳʱ˻Ϊͨҳ */
+    TEST_ASSERT(ring_buffer_pool_create(&pool, 1000, 256, RING_BUFFER_TYPE_LOCKFREE, RING_BUFFER_POOL_HUGEPAGE));
+    for (uint16_t i = 0; i < 1000; i++) {
+        ring_buffer_t *rb = ring_buffer_pool_alloc(&pool);
+        TEST_ASSERT(rb != NULL && ring_buffer_free_space(rb) > 0);
+    }
+    TEST_ASSERT(ring_buffer_pool_alloc(&pool) == NULL);
+    ring_buffer_pool_deinit(&pool);
+#endif
+    
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_PRIO
+bool test_prio(void)
+{
+    static uint8_t ctrl[32], normal[64], bulk[256];
+    ring_buffer_prio_lane_t cfg[3] = {
+        {ctrl, sizeof(ctrl), 1},
+        {normal, sizeof(normal), 2},
+        {bulk, sizeof(bulk), 1},
+    };
+    ring_buffer_prio_t p;
+    uint8_t out[16];
+    uint8_t lane = 0xFF;
+    
+    /* ϸȼдĿƱȱ */
+    TEST_ASSERT(ring_buffer_prio_create(&p, cfg, 3, RING_BUFFER_TYPE_LOCKFREE, RING_BUFFER_PRIO_STRICT));
+    TEST_ASSERT(ring_buffer_prio_pending(&p) == 0);
+    TEST_ASSERT(ring_buffer_prio_read(&p, out, sizeof(out), &lane) == 0);
+    
+    TEST_ASSERT(ring_buffer_prio_write(&p, 2, (const uint8_t *)"bulkbulkbulk", 12) == 12);
+    TEST_ASSERT(ring_buffer_prio_write(&p, 0, (const uint8_t *)"CMD", 3) == 3);
+    TEST_ASSERT(ring_buffer_prio_pending(&p) == 0x05);
+    
+    TEST_ASSERT(ring_buffer_prio_read(&p, out, sizeof(out), &lane) == 3);
+    TEST_ASSERT(lane == 0 && memcmp(out, "CMD", 3) == 0);
+    TEST_ASSERT(ring_buffer_prio_pending(&p) == 0x04);
+    
+    TEST_ASSERT(ring_buffer_prio_read(&p, out, 4, &lane) == 4 && lane == 2);
+    TEST_ASSERT(ring_buffer_prio_pending(&p) == 0x04);
+    TEST_ASSERT(ring_buffer_prio_read(&p, out, sizeof(out), &lane) == 8 && lane == 2);
+    TEST_ASSERT(ring_buffer_prio_pending(&p) == 0);
+    ring_buffer_prio_destroy(&p);
+    
+    /* Ȩѯͨ 1 Ȩ 2Ϊ 1 */
+    TEST_ASSERT(ring_buffer_prio_create(&p, cfg, 3, RING_BUFFER_TYPE_LOCKFREE, RING_BUFFER_PRIO_WEIGHTED));
+    for (uint8_t i = 0; i < 8; i++) {
+        uint8_t v[3] = {(uint8_t)(i), (uint8_t)(0x10 + i), (uint8_t)(0x20 + i)};
+        for (uint8_t l = 0; l < 3; l++) {
+            TEST_ASSERT(ring_buffer_prio_write(&p, l, &v[l], 1) == 1);
+        }
+    }
+    
+    const uint8_t expect[8] = {0, 1, 1, 2, 0, 1, 1, 2};
+    for (uint8_t i = 0; i < 8; i++) {
+        TEST_ASSERT(ring_buffer_prio_read(&p, out, 1, &lane) == 1);
+        TEST_ASSERT(lane == expect[i]);
+    }
+    
+    /* ͨպֻʣһͨʱͨ */
+    while (ring_buffer_prio_read(&p, out, 1, &lane) == 1) {
+    }
+    TEST_ASSERT(ring_buffer_prio_pending(&p) == 0);
+    TEST_ASSERT(ring_buffer_prio_write(&p, 2, (const uint8_t *)"xyz", 3) == 3);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT(ring_buffer_prio_read(&p, out, 1, &lane) == 1 && lane == 2);
+    }
+    
+    ring_buffer_prio_destroy(&p);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_SET
+static ring_buffer_set_t set_under_test;
+
+static void *set_late_producer(void *arg)
+{
+    (void)arg;
+    usleep(20000);
+    ring_buffer_set_write(&set_under_test, 70, (const uint8_t *)"late", 4);
+    return NULL;
+}
+
+bool test_set(void)
+{
+    static uint8_t storage[100][16];
+    static ring_buffer_t rings[100];
+    ring_buffer_set_t *set = &set_under_test;
+    uint8_t out[16];
+    
+    TEST_ASSERT(ring_buffer_set_init(set));
+    for (uint8_t i = 0; i < 100; i++) {
+        TEST_ASSERT(ring_buffer_create(&rings[i], storage[i], sizeof(storage[i]), RING_BUFFER_TYPE_LOCKFREE));
+        TEST_ASSERT(ring_buffer_set_add(set, &rings[i]) == i);
+    }
+    
+    /* ޾Աȴ */
+    TEST_ASSERT(ring_buffer_set_next(set, 0) == -1);
+    
+    /* ֻԱѯ˳ */
+    TEST_ASSERT(ring_buffer_set_write(set, 90, (const uint8_t *)"a", 1) == 1);
+    TEST_ASSERT(ring_buffer_set_write(set, 5, (const uint8_t *)"bb", 2) == 2);
+    TEST_ASSERT(ring_buffer_set_write(set, 40, (const uint8_t *)"c", 1) == 1);
+    TEST_ASSERT(ring_buffer_set_write(set, 5, (const uint8_t *)"b", 1) == 1);
+    
+    TEST_ASSERT(ring_buffer_set_next(set, 0) == 5);
+    TEST_ASSERT(ring_buffer_read_multi(set->rings[5], out, 1) == 1);
+    ring_buffer_set_done(set, 5);
+    TEST_ASSERT(ring_buffer_set_next(set, 0) == 40);
+    TEST_ASSERT(ring_buffer_read_multi(set->rings[40], out, 1) == 1);
+    ring_buffer_set_done(set, 40);
+    TEST_ASSERT(ring_buffer_set_next(set, 0) == 90);
+    TEST_ASSERT(ring_buffer_read_multi(set->rings[90], out, 1) == 1);
+    ring_buffer_set_done(set, 90);
+    
+    /* Ա 5 δ꣬ƺٴη */
+    TEST_ASSERT(ring_buffer_set_next(set, 0) == 5);
+    TEST_ASSERT(ring_buffer_read_multi(set->rings[5], out, 2) == 2);
+    ring_buffer_set_done(set, 5);
+    TEST_ASSERT(ring_buffer_set_next(set, 0) == -1);
+    
+#if defined(__linux__)
+    /* ȴ߳д */
+    pthread_t tid;
+    TEST_ASSERT(pthread_create(&tid, NULL, set_late_producer, NULL) == 0);
+    TEST_ASSERT(ring_buffer_set_next(set, 2000) == 70);
+    pthread_join(tid, NULL);
+    TEST_ASSERT(ring_buffer_read_multi(set->rings[70], out, 4) == 4 && memcmp(out, "late", 4) == 0);
+    ring_buffer_set_done(set, 70);
+    TEST_ASSERT(ring_buffer_set_next(set, 10) == -1);
+#endif
+    
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_DEQUE
+#define DEQUE_TASKS  20000
+
+static ring_buffer_deque_t deque_under_test;
+static volatile uint8_t deque_done;
+static uint8_t deque_seen[DEQUE_TASKS];
+
+static void *deque_thief(void *arg)
+{
+    uint32_t *stolen = (uint32_t *)arg;
+    void *task;
+    
+    while (!deque_done) {
+        if (ring_buffer_deque_steal(&deque_under_test, &task) == RING_BUFFER_STEAL_OK) {
+            __atomic_fetch_add(&deque_seen[(uintptr_t)task - 1U], 1U, __ATOMIC_RELAXED);
+            (*stolen)++;
+        }
+    }
+    return NULL;
+}
+
+bool test_deque(void)
+{
+    static void *storage[64];
+    ring_buffer_deque_t *dq = &deque_under_test;
+    void *task = NULL;
+    
+    /*  2  */
+    TEST_ASSERT(!ring_buffer_deque_create(dq, (uint8_t *)storage, 3 * sizeof(void *)));
+    TEST_ASSERT(ring_buffer_deque_create(dq, (uint8_t *)storage, sizeof(storage)));
+    
+    /*  LIFOȡ FIFO */
+    for (uintptr_t i = 1; i <= 4; i++) {
+        TEST_ASSERT(ring_buffer_deque_push(dq, (void *)i));
+    }
+    TEST_ASSERT(ring_buffer_deque_size(dq) == 4);
+    TEST_ASSERT(ring_buffer_deque_pop(dq, &task) && task == (void *)4);
+    TEST_ASSERT(ring_buffer_deque_steal(dq, &task) == RING_BUFFER_STEAL_OK && task == (void *)1);
+    TEST_ASSERT(ring_buffer_deque_pop(dq, &task) && task == (void *)3);
+    TEST_ASSERT(ring_buffer_deque_pop(dq, &task) && task == (void *)2);
+    TEST_ASSERT(!ring_buffer_deque_pop(dq, &task));
+    TEST_ASSERT(ring_buffer_deque_steal(dq, &task) == RING_BUFFER_STEAL_EMPTY);
+    
+    /* ʱܾѹ */
+    for (uintptr_t i = 1; i <= 64; i++) {
+        TEST_ASSERT(ring_buffer_deque_push(dq, (void *)i));
+    }
+    TEST_ASSERT(!ring_buffer_deque_push(dq, (void *)65));
+    while (ring_buffer_deque_pop(dq, &task)) {
+    }
+    
+    /* ȡÿǡñִһ */
+    pthread_t thieves[2];
+    uint32_t stolen[2] = {0, 0};
+    uint32_t popped = 0;
+    
+    memset(deque_seen, 0, sizeof(deque_seen));
+    deque_done = 0;
+    for (uint8_t i = 0; i < 2; i++) {
+        TEST_ASSERT(pthread_create(&thieves[i], NULL, deque_thief, &stolen[i]) == 0);
+    }
+    
+    for (uintptr_t i = 1; i <= DEQUE_TASKS; i++) {
+        while (!ring_buffer_deque_push(dq, (void *)i)) {
+            if (ring_buffer_deque_pop(dq, &task)) {
+                deque_seen[(uintptr_t)task - 1U]++;
+                popped++;
+            }
+        }
+        if ((i & 3U) == 0 && ring_buffer_deque_pop(dq, &task)) {
+            __atomic_fetch_add(&deque_seen[(uintptr_t)task - 1U], 1U, __ATOMIC_RELAXED);
+            popped++;
+        }
+    }
+    while (ring_buffer_deque_pop(dq, &task)) {
+        __atomic_fetch_add(&deque_seen[(uintptr_t)task - 1U], 1U, __ATOMIC_RELAXED);
+        popped++;
+    }
+    
+    deque_done = 1;
+    for (uint8_t i = 0; i < 2; i++) {
+        pthread_join(thieves[i], NULL);
+    }
+    
+    TEST_ASSERT(popped + stolen[0] + stolen[1] == DEQUE_TASKS);
+    for (uint32_t i = 0; i < DEQUE_TASKS; i++) {
+        TEST_ASSERT(deque_seen[i] == 1);
+    }
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_MPSC
+#define MPSC_PRODUCERS  3
+#define MPSC_PER_LANE   20000
+
+static ring_buffer_mpsc_t mpsc_under_test;
+
+static void *mpsc_producer(void *arg)
+{
+    (void)arg;
+    int32_t lane = ring_buffer_mpsc_register(&mpsc_under_test);
+    
+    for (uint32_t seq = 0; lane >= 0 && seq < MPSC_PER_LANE; seq++) {
+        uint8_t v[4];
+        ring_buffer_size_t done = 0;
+        
+        /* ͨʱֻдһ֣дʣֽ */
+        memcpy(v, &seq, sizeof(v));
+        while (done < sizeof(v)) {
+            ring_buffer_size_t n = ring_buffer_mpsc_write(&mpsc_under_test, (uint8_t)lane,
+                                                          v + done, (ring_buffer_size_t)(sizeof(v) - done));
+            if (n == 0) {
+                sched_yield();
+            }
+            done += n;
+        }
+    }
+    return NULL;
+}
+
+bool test_mpsc(void)
+{
+    static uint8_t storage[4 * 64];
+    ring_buffer_mpsc_t *m = &mpsc_under_test;
+    uint8_t out[64];
+    uint8_t lane = 0xFF;
+    
+    TEST_ASSERT(!ring_buffer_mpsc_init(m, storage, 64, RING_BUFFER_MPSC_MAX_LANES + 1));
+    TEST_ASSERT(ring_buffer_mpsc_init(m, storage, 64, 4));
+    TEST_ASSERT(ring_buffer_mpsc_read(m, out, sizeof(out), &lane) == 0);
+    
+    /* ͨעʧ */
+    for (int32_t i = 0; i < 4; i++) {
+        TEST_ASSERT(ring_buffer_mpsc_register(m) == i);
+    }
+    TEST_ASSERT(ring_buffer_mpsc_register(m) == -1);
+    
+    /* ÿֻһͨѯ˳ */
+    TEST_ASSERT(ring_buffer_mpsc_write(m, 2, (const uint8_t *)"cc", 2) == 2);
+    TEST_ASSERT(ring_buffer_mpsc_write(m, 0, (const uint8_t *)"aaa", 3) == 3);
+    TEST_ASSERT(ring_buffer_mpsc_write(m, 3, (const uint8_t *)"d", 1) == 1);
+    TEST_ASSERT(ring_buffer_mpsc_available(m) == 6);
+    
+    TEST_ASSERT(ring_buffer_mpsc_read(m, out, 2, &lane) == 2 && lane == 0);
+    TEST_ASSERT(ring_buffer_mpsc_read(m, out, sizeof(out), &lane) == 2 && lane == 2);
+    TEST_ASSERT(memcmp(out, "cc", 2) == 0);
+    TEST_ASSERT(ring_buffer_mpsc_read(m, out, sizeof(out), &lane) == 1 && lane == 3);
+    TEST_ASSERT(ring_buffer_mpsc_read(m, out, sizeof(out), &lane) == 1 && lane == 0);
+    TEST_ASSERT(ring_buffer_mpsc_read(m, out, sizeof(out), &lane) == 0);
+    
+    /* ʾλʧʱɨ貹 */
+    TEST_ASSERT(ring_buffer_mpsc_write(m, 1, (const uint8_t *)"b", 1) == 1);
+    m->hint = 0;
+    TEST_ASSERT(ring_buffer_mpsc_read(m, out, sizeof(out), &lane) == 1 && lane == 1);
+    ring_buffer_mpsc_deinit(m);
+    
+    /* ÿͨڱ˳ݲʧ */
+    pthread_t tids[MPSC_PRODUCERS];
+    uint32_t expect[MPSC_PRODUCERS] = {0};
+    uint8_t stage[MPSC_PRODUCERS][4];
+    uint8_t staged[MPSC_PRODUCERS] = {0};
+    uint32_t total = 0;
+    
+    TEST_ASSERT(ring_buffer_mpsc_init(m, storage, 64, MPSC_PRODUCERS));
+    for (uint8_t i = 0; i < MPSC_PRODUCERS; i++) {
+        TEST_ASSERT(pthread_create(&tids[i], NULL, mpsc_producer, NULL) == 0);
+    }
+    
+    while (total < MPSC_PRODUCERS * MPSC_PER_LANE) {
+        ring_buffer_size_t n = ring_buffer_mpsc_read(m, out, 16, &lane);
+        if (n == 0) {
+            sched_yield();
+            continue;
+        }
+        for (ring_buffer_size_t k = 0; k < n; k++) {
+            stage[lane][staged[lane]++] = out[k];
+            if (staged[lane] == 4) {
+                uint32_t seq;
+                memcpy(&seq, stage[lane], sizeof(seq));
+                TEST_ASSERT(seq == expect[lane]);
+                expect[lane]++;
+                staged[lane] = 0;
+                total++;
+            }
+        }
+    }
+    
+    for (uint8_t i = 0; i < MPSC_PRODUCERS; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    TEST_ASSERT(ring_buffer_mpsc_read(m, out, sizeof(out), &lane) == 0);
+    ring_buffer_mpsc_deinit(m);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_MERGE
+/**
+ * @brief ƴӼ¼أؿܻΪΣ
+ */
+static uint32_t merge_collect(const ring_buffer_merge_rec_t *rec, uint8_t *out)
+{
+    uint32_t n = 0;
+    
+    for (uint8_t i = 0; i < rec->count; i++) {
+        memcpy(out + n, rec->spans[i].data, rec->spans[i].len);
+        n += rec->spans[i].len;
+    }
+    return n;
+}
+
+bool test_merge(void)
+{
+    static uint8_t storage[3][64];
+    ring_buffer_t rings[3];
+    ring_buffer_merge_t m;
+    ring_buffer_merge_rec_t rec;
+    uint8_t out[32];
+    
+    TEST_ASSERT(ring_buffer_merge_init(&m, 50));
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT(ring_buffer_create(&rings[i], storage[i], sizeof(storage[i]), RING_BUFFER_TYPE_LOCKFREE));
+        TEST_ASSERT(ring_buffer_merge_add(&m, &rings[i]) == i);
+    }
+    TEST_ASSERT(!ring_buffer_merge_next(&m, &rec, 0));
+    
+    /* ¼Ųʱд */
+    TEST_ASSERT(!ring_buffer_merge_put(&rings[0], 1, out, 60));
+    TEST_ASSERT(ring_buffer_is_empty(&rings[0]));
+    
+    /* ȫж׼¼ʱȫ */
+    TEST_ASSERT(ring_buffer_merge_put(&rings[0], 10, (const uint8_t *)"a10", 3));
+    TEST_ASSERT(ring_buffer_merge_put(&rings[0], 40, (const uint8_t *)"a40", 3));
+    TEST_ASSERT(ring_buffer_merge_put(&rings[1], 20, (const uint8_t *)"b20", 3));
+    TEST_ASSERT(ring_buffer_merge_put(&rings[1], 30, (const uint8_t *)"b30", 3));
+    TEST_ASSERT(ring_buffer_merge_put(&rings[2], 5, (const uint8_t *)"c5", 2));
+    
+    TEST_ASSERT(ring_buffer_merge_next(&m, &rec, 0));
+    TEST_ASSERT(rec.ts == 5 && rec.ring == 2 && merge_collect(&rec, out) == 2 && memcmp(out, "c5", 2) == 0);
+    TEST_ASSERT(!ring_buffer_merge_next(&m, &rec, 0));  /* δͷǰһ */
+    ring_buffer_merge_release(&m);
+    
+    /*  2 ѿգʱ 40  10 δ 50ȴ */
+    TEST_ASSERT(!ring_buffer_merge_next(&m, &rec, 0));
+    
+    /* ¼¼˳ */
+    TEST_ASSERT(ring_buffer_merge_put(&rings[2], 25, (const uint8_t *)"c25", 3));
+    const uint64_t expect_ts[5] = {10, 20, 25, 30, 40};
+    for (uint8_t i = 0; i < 5; i++) {
+        uint8_t flags = (i >= 3) ? RING_BUFFER_MERGE_FLUSH : 0;
+        TEST_ASSERT(ring_buffer_merge_next(&m, &rec, flags));
+        TEST_ASSERT(rec.ts == expect_ts[i] && rec.len == 3);
+        ring_buffer_merge_release(&m);
+    }
+    TEST_ASSERT(!ring_buffer_merge_next(&m, &rec, RING_BUFFER_MERGE_FLUSH));
+    
+    /* ڣѼʱ 50 ϵļ¼ֱ */
+    TEST_ASSERT(ring_buffer_merge_put(&rings[0], 100, (const uint8_t *)"x", 1));
+    TEST_ASSERT(ring_buffer_merge_put(&rings[1], 200, (const uint8_t *)"y", 1));
+    TEST_ASSERT(ring_buffer_merge_next(&m, &rec, 0) && rec.ts == 100);
+    ring_buffer_merge_release(&m);
+    TEST_ASSERT(!ring_buffer_merge_next(&m, &rec, 0));
+    
+    /* ڴڵļ¼ */
+    TEST_ASSERT(ring_buffer_merge_put(&rings[2], 90, (const uint8_t *)"z", 1));
+    TEST_ASSERT(ring_buffer_merge_next(&m, &rec, 0) && rec.ts == 90 && rec.ring == 2);
+    ring_buffer_merge_release(&m);
+    TEST_ASSERT(m.late == 1);
+    TEST_ASSERT(ring_buffer_merge_next(&m, &rec, RING_BUFFER_MERGE_FLUSH) && rec.ts == 200);
+    ring_buffer_merge_release(&m);
+    
+    /* ػƻĩβʱݶ */
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT(ring_buffer_merge_put(&rings[0], 300 + i, (const uint8_t *)"0123456789abcdef", 16));
+        TEST_ASSERT(ring_buffer_merge_next(&m, &rec, RING_BUFFER_MERGE_FLUSH));
+        TEST_ASSERT(merge_collect(&rec, out) == 16 && memcmp(out, "0123456789abcdef", 16) == 0);
+        ring_buffer_merge_release(&m);
+    }
+    
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_LZ
+bool test_lz(void)
+{
+    static const char dict[] = "[INFO] sensor temperature=  humidity=  [WARN] battery voltage low ";
+    static uint8_t storage[512];
+    static ring_buffer_lz_t lz;
+    ring_buffer_t rb;
+    char line[96];
+    uint8_t out[RING_BUFFER_LZ_MAX_RECORD];
+    
+    TEST_ASSERT(ring_buffer_create(&rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE));
+    TEST_ASSERT(ring_buffer_lz_init(&lz, &rb, (const uint8_t *)dict, (uint16_t)(sizeof(dict) - 1)));
+    TEST_ASSERT(ring_buffer_lz_read(&lz, out, sizeof(out)) == 0);
+    TEST_ASSERT(ring_buffer_lz_ratio(&lz) == 100);
+    
+    /* ظıһ£ռСԭʼ */
+    for (uint32_t round = 0; round < 40; round++) {
+        for (uint8_t k = 0; k < 3; k++) {
+            int n = snprintf(line, sizeof(line), "[INFO] sensor %u temperature=%u humidity=%u",
+                             (unsigned)k, (unsigned)(20 + round % 5), (unsigned)(40 + k));
+            TEST_ASSERT(ring_buffer_lz_write(&lz, (const uint8_t *)line, (ring_buffer_size_t)n));
+        }
+        for (uint8_t k = 0; k < 3; k++) {
+            int n = snprintf(line, sizeof(line), "[INFO] sensor %u temperature=%u humidity=%u",
+                             (unsigned)k, (unsigned)(20 + round % 5), (unsigned)(40 + k));
+            TEST_ASSERT(ring_buffer_lz_read(&lz, out, sizeof(out)) == (ring_buffer_size_t)n);
+            TEST_ASSERT(memcmp(out, line, (size_t)n) == 0);
+        }
+    }
+    TEST_ASSERT(ring_buffer_lz_ratio(&lz) >= 200);
+    TEST_ASSERT(lz.stats.records == 120 && lz.stats.corrupt == 0);
+    
+    /* ¼ڳظصƥ䣩벻ѹ */
+    uint8_t rnd[200];
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < sizeof(rnd); i++) {
+        seed = seed * 1103515245U + 12345U;
+        rnd[i] = (uint8_t)(seed >> 16);
+    }
+    memset(line, 'x', 80);
+    TEST_ASSERT(ring_buffer_lz_write(&lz, (const uint8_t *)line, 80));
+    TEST_ASSERT(ring_buffer_lz_write(&lz, rnd, sizeof(rnd)));
+    TEST_ASSERT(ring_buffer_lz_read(&lz, out, sizeof(out)) == 80 && memcmp(out, line, 80) == 0);
+    TEST_ASSERT(ring_buffer_lz_read(&lz, out, 100) == 0);   /* ռ䲻ʱȡ */
+    TEST_ASSERT(ring_buffer_lz_read(&lz, out, sizeof(out)) == sizeof(rnd));
+    TEST_ASSERT(memcmp(out, rnd, sizeof(rnd)) == 0);
+    
+    /* ռ䲻ʱ */
+    while (ring_buffer_lz_write(&lz, rnd, sizeof(rnd))) {
+    }
+    TEST_ASSERT(lz.stats.dropped == 1);
+    while (ring_buffer_lz_read(&lz, out, sizeof(out)) == sizeof(rnd)) {
+    }
+    TEST_ASSERT(ring_buffer_is_empty(&rb));
+    
+    /* 𻵼¼Խ */
+    memset(line, 'y', 64);
+    TEST_ASSERT(ring_buffer_lz_write(&lz, (const uint8_t *)line, 64));
+    TEST_ASSERT(ring_buffer_lz_write(&lz, (const uint8_t *)line, 64));
+    storage[(rb.tail + RING_BUFFER_LZ_HDR_SIZE + 1) % sizeof(storage)] = 0xFF;
+    storage[(rb.tail + RING_BUFFER_LZ_HDR_SIZE + 2) % sizeof(storage)] = 0xFF;
+    TEST_ASSERT(ring_buffer_lz_read(&lz, out, sizeof(out)) == 0 && lz.stats.corrupt == 1);
+    TEST_ASSERT(ring_buffer_lz_read(&lz, out, sizeof(out)) == 64 && memcmp(out, line, 64) == 0);
+    
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_SPINLOCK
+#define SPIN_THREADS  4
+#define SPIN_ITERS    20000
+
+static ring_buffer_t spin_under_test;
+
+typedef struct {
+    uint8_t tag;                        /**< ߳дֵֽ */
+    uint64_t written;                   /**< дֵֽ֮ */
+    uint64_t read;                      /**< ֵֽ֮ */
+} spin_worker_t;
+
+static void *spin_worker(void *arg)
+{
+    spin_worker_t *w = (spin_worker_t *)arg;
+    uint8_t msg[8];
+    uint8_t out[8];
+    
+    memset(msg, w->tag, sizeof(msg));
+    for (uint32_t i = 0; i < SPIN_ITERS; i++) {
+        ring_buffer_size_t n = ring_buffer_write_multi(&spin_under_test, msg, sizeof(msg));
+        w->written += (uint64_t)n * w->tag;
+        
+        n = ring_buffer_read_multi(&spin_under_test, out, sizeof(out));
+        for (ring_buffer_size_t k = 0; k < n; k++) {
+            w->read += out[k];
+        }
+    }
+    return NULL;
+}
+
+bool test_spinlock(void)
+{
+    static uint8_t storage[64];
+    ring_buffer_t *rb = &spin_under_test;
+    uint8_t out[64];
+    
+    /* ߳Ϊģʽһ */
+    TEST_ASSERT(ring_buffer_create(rb, storage, sizeof(storage), RING_BUFFER_TYPE_SPINLOCK));
+    TEST_ASSERT(ring_buffer_write(rb, 0xA5));
+    TEST_ASSERT(ring_buffer_write_multi(rb, (const uint8_t *)"spin", 4) == 4);
+    TEST_ASSERT(ring_buffer_available(rb) == 5);
+    TEST_ASSERT(ring_buffer_read(rb, out) && out[0] == 0xA5);
+    TEST_ASSERT(ring_buffer_read_multi(rb, out, sizeof(out)) == 4 && memcmp(out, "spin", 4) == 0);
+    TEST_ASSERT(ring_buffer_is_empty(rb));
+    
+    /* ߳ͬʱддغ㣬һ */
+    pthread_t tids[SPIN_THREADS];
+    spin_worker_t workers[SPIN_THREADS];
+    uint64_t written = 0;
+    uint64_t read = 0;
+    
+    for (uint8_t i = 0; i < SPIN_THREADS; i++) {
+        workers[i].tag = (uint8_t)(i + 1);
+        workers[i].written = 0;
+        workers[i].read = 0;
+        TEST_ASSERT(pthread_create(&tids[i], NULL, spin_worker, &workers[i]) == 0);
+    }
+    for (uint8_t i = 0; i < SPIN_THREADS; i++) {
+        pthread_join(tids[i], NULL);
+        written += workers[i].written;
+        read += workers[i].read;
+    }
+    
+    ring_buffer_size_t n = ring_buffer_read_multi(rb, out, sizeof(out));
+    for (ring_buffer_size_t k = 0; k < n; k++) {
+        read += out[k];
+    }
+    TEST_ASSERT(written == read);
+    TEST_ASSERT(rb->spin_next == rb->spin_owner);
+    
+    ring_buffer_destroy(rb);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_SNAPSHOT
+#define SNAP_BYTES  200000UL
+
+static ring_buffer_t snap_under_test;
+static volatile bool snap_done;
+
+/* дֽУ߱߶У */
+static void *snap_producer(void *arg)
+{
+    uint8_t next = 0;
+    
+    (void)arg;
+    for (uint32_t sent = 0; sent < SNAP_BYTES; ) {
+        uint8_t chunk[13];
+        for (uint8_t i = 0; i < sizeof(chunk); i++) {
+            chunk[i] = (uint8_t)(next + i);
+        }
+        ring_buffer_size_t n = ring_buffer_write_multi(&snap_under_test, chunk, sizeof(chunk));
+        next = (uint8_t)(next + n);
+        sent += n;
+        if (n == 0) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *snap_consumer(void *arg)
+{
+    uint8_t expect = 0;
+    uint8_t out[7];
+    
+    for (uint32_t got = 0; got < SNAP_BYTES; ) {
+        ring_buffer_size_t n = ring_buffer_read_multi(&snap_under_test, out, sizeof(out));
+        for (ring_buffer_size_t i = 0; i < n; i++) {
+            if (out[i] != expect++) {
+                *(bool *)arg = false;
+            }
+        }
+        got += n;
+        if (n == 0) {
+            sched_yield();
+        }
+    }
+    snap_done = true;
+    return NULL;
+}
+
+bool test_snapshot(void)
+{
+    static uint8_t storage[64];
+    ring_buffer_t *rb = &snap_under_test;
+    uint8_t data[80];
+    uint8_t out[80];
+    
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+    
+    TEST_ASSERT(ring_buffer_create(rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE));
+    TEST_ASSERT(ring_buffer_snapshot(rb, out, sizeof(out), 0) == 0);
+    
+    /* 컷ƣдָ붼Խĩβ */
+    TEST_ASSERT(ring_buffer_write_multi(rb, data, 50) == 50);
+    TEST_ASSERT(ring_buffer_read_multi(rb, out, 40) == 40);
+    TEST_ASSERT(ring_buffer_write_multi(rb, data + 50, 30) == 30);
+    
+    ring_buffer_size_t head = rb->head;
+    ring_buffer_size_t tail = rb->tail;
+    
+    /*  / ݣԽĩβ */
+    TEST_ASSERT(ring_buffer_snapshot(rb, out, 30, 0) == 30);
+    TEST_ASSERT(memcmp(out, data + 40, 30) == 0);
+    TEST_ASSERT(ring_buffer_snapshot(rb, out, 20, RING_BUFFER_SNAPSHOT_LATEST) == 20);
+    TEST_ASSERT(memcmp(out, data + 60, 20) == 0);
+    
+    /* 󳬹ɶʱֻƿɶ */
+    TEST_ASSERT(ring_buffer_snapshot(rb, out, sizeof(out), RING_BUFFER_SNAPSHOT_LATEST) == 40);
+    TEST_ASSERT(memcmp(out, data + 40, 40) == 0);
+    
+    /* Ƴݡ޸Ķдָ */
+    TEST_ASSERT(rb->head == head && rb->tail == tail);
+    TEST_ASSERT(ring_buffer_available(rb) == 40);
+    
+    /* ߡ߲ʱʼĵ */
+    bool consumer_ok = true;
+    pthread_t prod;
+    pthread_t cons;
+    uint32_t snaps = 0;
+    
+    ring_buffer_clear(rb);
+    snap_done = false;
+    TEST_ASSERT(pthread_create(&prod, NULL, snap_producer, NULL) == 0);
+    TEST_ASSERT(pthread_create(&cons, NULL, snap_consumer, &consumer_ok) == 0);
+    
+    while (!snap_done) {
+        ring_buffer_size_t n = ring_buffer_snapshot(rb, out, 16, (snaps & 1U) ? RING_BUFFER_SNAPSHOT_LATEST : 0);
+        for (ring_buffer_size_t i = 1; i < n; i++) {
+            TEST_ASSERT(out[i] == (uint8_t)(out[i - 1] + 1));
+        }
+        snaps += (n > 0);
+        sched_yield();
+    }
+    
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    TEST_ASSERT(consumer_ok);
+    
+    ring_buffer_destroy(rb);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_HUGEMEM
+bool test_hugemem(void)
+{
+    ring_buffer_hugemem_t mem;
+    ring_buffer_t rb;
+    const ring_buffer_size_t size = 60000;
+    uint8_t data[256];
+    uint8_t out[256];
+    
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i ^ 0x5A);
+    }
+    
+    /* ͸ҳ + ؽڵ + Ԥȱҳ +  */
+    uint8_t *buf = ring_buffer_hugemem_alloc(&mem, size, RING_BUFFER_HUGEMEM_NODE_LOCAL,
+                                             RING_BUFFER_HUGEMEM_THP | RING_BUFFER_HUGEMEM_PREFAULT |
+                                             RING_BUFFER_HUGEMEM_MLOCK);
+    TEST_ASSERT(buf != NULL && buf == mem.base);
+    TEST_ASSERT(mem.map_len >= size && ((uintptr_t)buf % RING_BUFFER_HUGEMEM_PAGE) == 0);
+    TEST_ASSERT(mem.applied & RING_BUFFER_HUGEMEM_PREFAULT);
+    
+    TEST_ASSERT(ring_buffer_create(&rb, buf, size, RING_BUFFER_TYPE_LOCKFREE));
+    for (uint32_t i = 0; i < 1000; i++) {
+        TEST_ASSERT(ring_buffer_write_multi(&rb, data, sizeof(data)) == sizeof(data));
+        TEST_ASSERT(ring_buffer_read_multi(&rb, out, sizeof(out)) == sizeof(out));
+        TEST_ASSERT(memcmp(out, data, sizeof(data)) == 0);
+    }
+    ring_buffer_destroy(&rb);
+    ring_buffer_hugemem_free(&mem);
+    TEST_ASSERT(mem.base == NULL);
+    
+    /* ʽҳδԤʱ˻ͨӳ䣬Կʹ */
+    buf = ring_buffer_hugemem_alloc(&mem, size, RING_BUFFER_HUGEMEM_NODE_ANY, RING_BUFFER_HUGEMEM_HUGETLB);
+    TEST_ASSERT(buf != NULL && mem.node == -1);
+    buf[0] = 1;
+    buf[size - 1] = 2;
+    ring_buffer_hugemem_free(&mem);
+    
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_TRACE
+bool test_trace(void)
+{
+    static ring_buffer_trace_rec_t recs[8], loaded[8];
+    ring_buffer_trace_t tr, tr2;
+    ring_buffer_trace_result_t res;
+    ring_buffer_t rb;
+    uint8_t storage[64];
+    uint8_t data[100] = {0};
+    uint32_t dropped = 0;
+    char path[] = "/tmp/rb_trace_XXXXXX";
+    int fd = mkstemp(path);
+    
+    TEST_ASSERT(fd >= 0);
+    close(fd);
+    
+    TEST_ASSERT(ring_buffer_create(&rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE));
+    TEST_ASSERT(ring_buffer_trace_init(&tr, recs, 4));
+    TEST_ASSERT(ring_buffer_trace_start(&rb, &tr));
+    
+    /* ¼󳤶ʵɳȣ 63*/
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 10) == 10);
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 60) == 53);
+    TEST_ASSERT(ring_buffer_read_multi(&rb, data, 20) == 20);
+    TEST_ASSERT(ring_buffer_read_multi(&rb, data, 100) == 43);
+    
+    /* д */
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 5) == 5);
+    ring_buffer_trace_stop(&rb);
+    TEST_ASSERT(ring_buffer_write_multi(&rb, data, 5) == 5);
+    TEST_ASSERT(ring_buffer_trace_count(&tr, &dropped) == 4 && dropped == 1);
+    
+    TEST_ASSERT(recs[0].len == 10 && recs[0].done == 10);
+    TEST_ASSERT(recs[1].len == 60 && recs[1].done == 53);
+    TEST_ASSERT(recs[2].len == (20 | RING_BUFFER_TRACE_OP_READ) && recs[2].done == 20);
+    TEST_ASSERT(recs[3].len == (100 | RING_BUFFER_TRACE_OP_READ) && recs[3].done == 43);
+    TEST_ASSERT(recs[0].time <= recs[1].time && recs[2].time <= recs[3].time);
+    
+    /* 룬һ */
+    TEST_ASSERT(ring_buffer_trace_save(&tr, path));
+    TEST_ASSERT(ring_buffer_trace_load(&tr2, loaded, 8, path));
+    TEST_ASSERT(ring_buffer_trace_count(&tr2, NULL) == 4 && tr2.ring_size == sizeof(storage));
+    TEST_ASSERT(memcmp(loaded, recs, 4 * sizeof(recs[0])) == 0);
+    
+    /* ʱض */
+    TEST_ASSERT(ring_buffer_trace_load(&tr2, loaded, 2, path));
+    TEST_ASSERT(ring_buffer_trace_count(&tr2, NULL) == 2);
+    TEST_ASSERT(ring_buffer_trace_load(&tr2, loaded, 8, path));
+    
+    /* طŵСĻд˲ֽغ */
+    uint8_t small[32];
+    ring_buffer_t rb2;
+    TEST_ASSERT(ring_buffer_create(&rb2, small, sizeof(small), RING_BUFFER_TYPE_LOCKFREE));
+    TEST_ASSERT(ring_buffer_trace_replay(&tr2, &rb2, 1, &res));
+    TEST_ASSERT(res.written <= 31 + 31 && res.short_writes >= 1);
+    TEST_ASSERT(res.written - res.read == ring_buffer_available(&rb2));
+    TEST_ASSERT(res.peak_used <= 31);
+    
+    /* ¼ļܾ */
+    FILE *fp = fopen(path, "wb");
+    TEST_ASSERT(fp && fwrite("not a trace file", 1, 16, fp) == 16);
+    fclose(fp);
+    TEST_ASSERT(!ring_buffer_trace_load(&tr2, loaded, 8, path));
+    
+    unlink(path);
+    ring_buffer_destroy(&rb2);
+    ring_buffer_destroy(&rb);
+    return true;
+}
+#endif
+
+bool test_transfer(void)
+{
+    static uint8_t buf_a[16], buf_b[12];
+    ring_buffer_t rings[2];
+    ring_buffer_t *a = &rings[0];
+    ring_buffer_t *b = &rings[1];
+    uint8_t data[20], out[20];
+    
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i + 1);
+    }
+    
+    ring_buffer_create(a, buf_a, sizeof(buf_a), RING_BUFFER_TYPE_LOCKFREE);
+    ring_buffer_create(b, buf_b, sizeof(buf_b), RING_BUFFER_TYPE_LOCKFREE);
+    
+    /* Ķдָ붼ĩβԴĿжζ */
+    TEST_ASSERT(ring_buffer_write_multi(a, data, 13) == 13);
+    TEST_ASSERT(ring_buffer_read_multi(a, out, 13) == 13);
+    TEST_ASSERT(ring_buffer_write_multi(b, data, 9) == 9);
+    TEST_ASSERT(ring_buffer_read_multi(b, out, 9) == 9);
+    
+    /* ԴַϵͣΪԴ */
+    TEST_ASSERT(ring_buffer_write_multi(a, data, 10) == 10);
+    TEST_ASSERT(ring_buffer_transfer(b, a, 4) == 4);
+    TEST_ASSERT(ring_buffer_transfer(b, a, 100) == 6);
+    TEST_ASSERT(ring_buffer_is_empty(a));
+    TEST_ASSERT(ring_buffer_read_multi(b, out, sizeof(out)) == 10);
+    TEST_ASSERT(memcmp(out, data, 10) == 0);
+    
+    /* ԴַϸߣΪĿ껺Ŀпռ */
+    TEST_ASSERT(ring_buffer_write_multi(b, data, 11) == 11);
+    TEST_ASSERT(ring_buffer_write_multi(a, data, 8) == 8);
+    TEST_ASSERT(ring_buffer_transfer(a, b, 100) == 7);
+    TEST_ASSERT(ring_buffer_is_full(a));
+    TEST_ASSERT(ring_buffer_transfer(a, b, 100) == 0);
+    TEST_ASSERT(ring_buffer_available(b) == 4);
+    TEST_ASSERT(ring_buffer_read_multi(a, out, sizeof(out)) == 15);
+    TEST_ASSERT(memcmp(out, data, 8) == 0 && memcmp(out + 8, data, 7) == 0);
+    
+    /* ԴΪաͬһ */
+    TEST_ASSERT(ring_buffer_transfer(b, a, 100) == 0);
+    TEST_ASSERT(ring_buffer_transfer(b, b, 100) == 0);
+    TEST_ASSERT(ring_buffer_transfer(NULL, a, 100) == 0);
+    
+#if RING_BUFFER_ENABLE_SPINLOCK
+    /* ˲ԲͬԵٽǶ */
+    ring_buffer_destroy(b);
+    ring_buffer_create(b, buf_b, sizeof(buf_b), RING_BUFFER_TYPE_SPINLOCK);
+    TEST_ASSERT(ring_buffer_write_multi(a, data, 9) == 9);
+    TEST_ASSERT(ring_buffer_transfer(b, a, 100) == 9);
+    TEST_ASSERT(ring_buffer_transfer(a, b, 5) == 5);
+    TEST_ASSERT(ring_buffer_read_multi(a, out, sizeof(out)) == 5 && memcmp(out, data, 5) == 0);
+    TEST_ASSERT(ring_buffer_read_multi(b, out, sizeof(out)) == 4 && memcmp(out, data + 5, 4) == 0);
+    TEST_ASSERT(b->spin_next == b->spin_owner);
+#endif
+    
+    ring_buffer_destroy(a);
+    ring_buffer_destroy(b);
+    return true;
+}
+
+#if RING_BUFFER_ENABLE_PIPELINE
+typedef struct {
+    uint32_t sum;
+    uint32_t seen;
+    uint32_t calls;
+    bool tail_out;                      /**< һյ˷ǿյ */
+} pipe_test_sink_t;
+
+/**
+ * @brief һÿֽڼ 1 תοռ䲻ʱֻдµĲ
+ */
+static ring_buffer_size_t pipe_test_inc(void *ctx, const ring_buffer_span_t *spans, uint8_t count, ring_buffer_t *out)
+{
+    uint8_t tmp[RING_BUFFER_PIPE_DRAIN];
+    ring_buffer_size_t room = ring_buffer_free_space(out);
+    ring_buffer_size_t n = 0;
+    
+    (void)ctx;
+    for (uint8_t s = 0; s < count; s++) {
+        for (ring_buffer_size_t i = 0; i < spans[s].len && n < room; i++) {
+            tmp[n++] = (uint8_t)(spans[s].data[i] + 1U);
+        }
+    }
+    return ring_buffer_write_multi(out, tmp, n);
+}
+
+/**
+ * @brief ڶԭת
+ */
+static ring_buffer_size_t pipe_test_fwd(void *ctx, const ring_buffer_span_t *spans, uint8_t count, ring_buffer_t *out)
+{
+    ring_buffer_iovec_t iov[2];
+    ring_buffer_size_t done = 0;
+    
+    (void)ctx;
+    for (uint8_t s = 0; s < count; s++) {
+        iov[s].base = spans[s].data;
+        iov[s].len = spans[s].len;
+    }
+    for (uint8_t s = 0; s < count; s++) {
+        ring_buffer_size_t n = ring_buffer_write_multi(out, (const uint8_t *)iov[s].base, iov[s].len);
+        done += n;
+        if (n < iov[s].len) {
+            break;
+        }
+    }
+    return done;
+}
+
+/**
+ * @brief һۼӣҴ챳ѹ
+ */
+static ring_buffer_size_t pipe_test_sink(void *ctx, const ring_buffer_span_t *spans, uint8_t count, ring_buffer_t *out)
+{
+    pipe_test_sink_t *sink = (pipe_test_sink_t *)ctx;
+    ring_buffer_size_t done = 0;
+    
+    sink->tail_out |= (out != NULL);
+    for (uint8_t s = 0; s < count; s++) {
+        for (ring_buffer_size_t i = 0; i < spans[s].len; i++) {
+            sink->sum += spans[s].data[i];
+        }
+        done += spans[s].len;
+    }
+    sink->seen += done;
+    if (++sink->calls % 8 == 0) {
+        usleep(1000);
+    }
+    return done;
+}
+
+bool test_pipeline(void)
+{
+    ring_buffer_pipeline_t pl;
+    ring_buffer_stage_stats_t st[3];
+    pipe_test_sink_t sink = {0, 0, 0, false};
+    uint8_t data[257];
+    uint32_t expect = 0;
+    const uint32_t total = 200000;
+    
+    TEST_ASSERT(ring_buffer_pipeline_init(&pl));
+    TEST_ASSERT(!ring_buffer_pipeline_start(&pl));
+    TEST_ASSERT(ring_buffer_pipeline_add_stage(&pl, pipe_test_inc, NULL, 4096, 0));
+    TEST_ASSERT(ring_buffer_pipeline_add_stage(&pl, pipe_test_fwd, NULL, 1024, -1));
+    TEST_ASSERT(ring_buffer_pipeline_add_stage(&pl, pipe_test_sink, &sink, 512, -1));
+    TEST_ASSERT(ring_buffer_pipeline_start(&pl));
+    TEST_ASSERT(!ring_buffer_pipeline_add_stage(&pl, pipe_test_fwd, NULL, 64, -1));
+    
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 13U);
+    }
+    
+    /* д벻㼴Ϊѹʣಿ */
+    uint32_t short_pushes = 0;
+    for (uint32_t sent = 0; sent < total; ) {
+        ring_buffer_size_t chunk = (ring_buffer_size_t)((total - sent < sizeof(data)) ? (total - sent) : sizeof(data));
+        ring_buffer_size_t off = (ring_buffer_size_t)(sent % sizeof(data));
+        if (chunk > sizeof(data) - off) {
+            chunk = (ring_buffer_size_t)(sizeof(data) - off);
+        }
+        ring_buffer_size_t n = ring_buffer_write_multi(&pl.stages[0].in, &data[off], chunk);
+        if (n < chunk) {
+            short_pushes++;
+            usleep(100);
+        }
+        sent += n;
+    }
+    for (uint32_t i = 0; i < total; i++) {
+        expect += (uint8_t)(data[i % sizeof(data)] + 1U);
+    }
+    
+    ring_buffer_pipeline_stop(&pl, true);
+    TEST_ASSERT(sink.seen == total && sink.sum == expect && !sink.tail_out);
+    
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT(ring_buffer_pipeline_stats(&pl, i, &st[i]));
+        TEST_ASSERT(st[i].bytes == total && st[i].depth == 0);
+    }
+    TEST_ASSERT(!ring_buffer_pipeline_stats(&pl, 3, &st[0]));
+    
+    /* ĩ뱻ѹֱ */
+    TEST_ASSERT(st[2].peak_depth == 511);
+    TEST_ASSERT(st[1].stalls > 0 && short_pushes > 0);
+    
+    ring_buffer_pipeline_deinit(&pl);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_NOTIFY
+typedef struct {
+    uint32_t data;
+    uint32_t space;
+} notify_test_ctx_t;
+
+static void notify_test_cb(void *ctx, uint8_t event)
+{
+    notify_test_ctx_t *c = (notify_test_ctx_t *)ctx;
+    if (event == RING_BUFFER_NOTIFY_DATA) {
+        c->data++;
+    } else if (event == RING_BUFFER_NOTIFY_SPACE) {
+        c->space++;
+    }
+}
+
+bool test_notify(void)
+{
+    ring_buffer_t rb;
+    ring_buffer_notify_t nt;
+    notify_test_ctx_t c = {0, 0};
+    uint8_t storage[65];
+    uint8_t data[80];
+    uint8_t out[80];
+    
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 3U + 1U);
+    }
+    
+    TEST_ASSERT(ring_buffer_create(&rb, storage, sizeof(storage), RING_BUFFER_TYPE_LOCKFREE));
+    TEST_ASSERT(!ring_buffer_notify_init(&nt, &rb, 0, 0, 0, notify_test_cb, &c));
+    TEST_ASSERT(!ring_buffer_notify_init(&nt, &rb, 16, 16, 0, notify_test_cb, &c));
+    TEST_ASSERT(ring_buffer_notify_init(&nt, &rb, 16, 8, 0, notify_test_cb, &c));
+    
+    /* ڸˮλ֪ͨﵽֻ֪ͨһ */
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT(ring_buffer_notify_write(&nt, &data[i * 5U], 5) == 5);
+    }
+    TEST_ASSERT(c.data == 0);
+    TEST_ASSERT(ring_buffer_notify_write(&nt, &data[15], 5) == 5);
+    TEST_ASSERT(c.data == 1);
+    TEST_ASSERT(ring_buffer_notify_write(&nt, &data[20], 5) == 5);
+    TEST_ASSERT(c.data == 1);
+    
+    /* δղ²պˢ´ظˢ²ظ֪ͨ */
+    TEST_ASSERT(ring_buffer_notify_read(&nt, out, 4) == 4);
+    TEST_ASSERT(c.data == 1 && memcmp(out, data, 4) == 0);
+    TEST_ASSERT(ring_buffer_notify_read(&nt, out, sizeof(out)) == 21);
+    TEST_ASSERT(memcmp(out, &data[4], 21) == 0 && c.data == 1);
+    TEST_ASSERT(ring_buffer_notify_write(&nt, data, 3) == 3);
+    TEST_ASSERT(c.data == 1);
+    ring_buffer_notify_flush(&nt);
+    ring_buffer_notify_flush(&nt);
+    TEST_ASSERT(c.data == 2);
+    
+    /* ֪ͨ󡢶ǰˢ󲻻ᶪʧ²һд֪ͨ */
+    TEST_ASSERT(ring_buffer_notify_write(&nt, data, 2) == 2);
+    ring_buffer_notify_flush(&nt);
+    TEST_ASSERT(c.data == 2);
+    TEST_ASSERT(ring_buffer_notify_read(&nt, out, sizeof(out)) == 5);
+    TEST_ASSERT(c.data == 2 && (nt.armed & RING_BUFFER_NOTIFY_DATA));
+    TEST_ASSERT(ring_buffer_notify_write(&nt, data, 1) == 1);
+    TEST_ASSERT(c.data == 3);
+    TEST_ASSERT(ring_buffer_notify_read(&nt, out, sizeof(out)) == 1);
+    
+    /* д SPACEˮλʱ֪ͨһ */
+    TEST_ASSERT(ring_buffer_notify_write(&nt, data, sizeof(data)) == 64);
+    TEST_ASSERT(c.space == 0 && (nt.armed & RING_BUFFER_NOTIFY_SPACE));
+    TEST_ASSERT(ring_buffer_notify_read(&nt, out, 50) == 50);
+    TEST_ASSERT(c.space == 0);
+    TEST_ASSERT(ring_buffer_notify_read(&nt, out, 6) == 6);
+    TEST_ASSERT(c.space == 1 && !(nt.armed & RING_BUFFER_NOTIFY_SPACE));
+    TEST_ASSERT(ring_buffer_notify_read(&nt, out, sizeof(out)) == 8);
+    TEST_ASSERT(c.space == 1);
+    
+    /* ʱʱã㶨ʱ󴥷 */
+    uint32_t before = c.data;
+    uint32_t t0 = RING_BUFFER_NOTIFY_TICKS();
+    TEST_ASSERT(ring_buffer_notify_init(&nt, &rb, 32, 0, 1, notify_test_cb, &c));
+    TEST_ASSERT(ring_buffer_notify_write(&nt, data, 1) == 1);
+    for (uint32_t i = 0; i < 100000 && c.data == before; i++) {
+        ring_buffer_notify_poll(&nt);
+    }
+    TEST_ASSERT((c.data == before + 1) || (RING_BUFFER_NOTIFY_TICKS() == t0));
+    TEST_ASSERT(nt.data_events == c.data - before);
+    
+    ring_buffer_destroy(&rb);
+    return true;
+}
+#endif
+
+#if RING_BUFFER_ENABLE_LOCKFREE
+RING_BUFFER_DEFINE(test_static_rb, 16, LOCKFREE);
+RING_BUFFER_DEFINE(test_static_odd, 10, LOCKFREE);
+RING_BUFFER_DEFINE_OPS(test_static_ops, 32, ring_buffer_lockfree_ops);
+#if RING_BUFFER_ENABLE_SPINLOCK
+RING_BUFFER_DEFINE(test_static_spin, 64, SPINLOCK);
+#endif
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+RING_BUFFER_DEFINE(test_static_batch, 64, LOCKFREE_BATCH);
+#endif
+
+bool test_static_define(void)
+{
+    uint8_t v = 0;
+    uint8_t out[32];
+    
+    /* δ create Ѿ */
+    TEST_ASSERT(test_static_rb.buffer == test_static_rb_storage && test_static_rb.size == 16);
+    TEST_ASSERT(test_static_rb.ops == &ring_buffer_lockfree_ops);
+    TEST_ASSERT(ring_buffer_is_empty(&test_static_rb) && ring_buffer_free_space(&test_static_rb) == 15);
+    
+    /*  API ʹã */
+    for (uint32_t i = 0; i < 100; i++) {
+        TEST_ASSERT(test_static_rb_put((uint8_t)i));
+        TEST_ASSERT(ring_buffer_write(&test_static_rb, (uint8_t)(i + 1U)));
+        TEST_ASSERT(ring_buffer_read(&test_static_rb, &v) && v == (uint8_t)i);
+        TEST_ASSERT(test_static_rb_get(&v) && v == (uint8_t)(i + 1U));
+    }
+    TEST_ASSERT(!test_static_rb_get(&v));
+    
+    /* Ϊ size - 1 put ʧ */
+    for (uint8_t i = 0; i < 15; i++) {
+        TEST_ASSERT(test_static_rb_put(i));
+    }
+    TEST_ASSERT(!test_static_rb_put(99) && ring_buffer_is_full(&test_static_rb));
+    TEST_ASSERT(ring_buffer_read_multi(&test_static_rb, out, sizeof(out)) == 15);
+    for (uint8_t i = 0; i < 15; i++) {
+        TEST_ASSERT(out[i] == i);
+    }
+    
+    /*  2 ݴС */
+    for (uint32_t i = 0; i < 50; i++) {
+        TEST_ASSERT(test_static_odd_put((uint8_t)(i * 7U)));
+        if (i % 3 == 2) {
+            TEST_ASSERT(ring_buffer_write_multi(&test_static_odd, (const uint8_t *)"ab", 2) == 2);
+            TEST_ASSERT(ring_buffer_available(&test_static_odd) == 3);
+            TEST_ASSERT(test_static_odd_get(&v) && v == (uint8_t)(i * 7U));
+            TEST_ASSERT(ring_buffer_read_multi(&test_static_odd, out, 2) == 2 && memcmp(out, "ab", 2) == 0);
+        } else {
+            TEST_ASSERT(test_static_odd_get(&v) && v == (uint8_t)(i * 7U));
+        }
+    }
+    
+    /* ֱӰ󶨲 */
+    TEST_ASSERT(ring_buffer_write_multi(&test_static_ops, (const uint8_t *)"static", 6) == 6);
+    TEST_ASSERT(ring_buffer_read_multi(&test_static_ops, out, sizeof(out)) == 6 && memcmp(out, "static", 6) == 0);
+    
+#if RING_BUFFER_ENABLE_SPINLOCK
+    TEST_ASSERT(test_static_spin.ops == &ring_buffer_spinlock_ops);
+    TEST_ASSERT(ring_buffer_write_multi(&test_static_spin, (const uint8_t *)"spin", 4) == 4);
+    TEST_ASSERT(ring_buffer_read_multi(&test_static_spin, out, sizeof(out)) == 4 && memcmp(out, "spin", 4) == 0);
+#endif
+    
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+    TEST_ASSERT(test_static_batch.batch_bytes == RING_BUFFER_BATCH_CLAMP(RING_BUFFER_BATCH_BYTES, 64));
+    TEST_ASSERT(test_static_batch.batch_delay == RING_BUFFER_BATCH_MAX_DELAY);
+    TEST_ASSERT(ring_buffer_write_multi(&test_static_batch, (const uint8_t *)"batch", 5) == 5);
+    ring_buffer_flush(&test_static_batch, RING_BUFFER_FLUSH_WRITE);
+    TEST_ASSERT(ring_buffer_read_multi(&test_static_batch, out, sizeof(out)) == 5 && memcmp(out, "batch", 5) == 0);
+#endif
+    
+    return true;
+}
+#endif
+
 /* Main ----------------------------------------------------------------------*/
 
 int main(void)
@@ -268,6 +1891,70 @@ int main(void)
     RUN_TEST(test_full_condition);
     RUN_TEST(test_empty_condition);
     RUN_TEST(test_clear);
+    RUN_TEST(test_peek_find);
+    RUN_TEST(test_fused_xform);
+#if RING_BUFFER_ENABLE_COPY_ENGINE
+    RUN_TEST(test_copy_engine);
+#endif
+#if RING_BUFFER_ENABLE_LOCKFREE_BATCH
+    RUN_TEST(test_batch_publish);
+#endif
+    RUN_TEST(test_iov);
+#if RING_BUFFER_ENABLE_FD_IO
+    RUN_TEST(test_fd_io);
+#endif
+#if RING_BUFFER_ENABLE_AIO
+    RUN_TEST(test_aio);
+#endif
+#if RING_BUFFER_ENABLE_PERSIST
+    RUN_TEST(test_persist);
+#endif
+#if RING_BUFFER_ENABLE_SEGQ
+    RUN_TEST(test_segq);
+#endif
+#if RING_BUFFER_ENABLE_POOL
+    RUN_TEST(test_pool);
+#endif
+#if RING_BUFFER_ENABLE_PRIO
+    RUN_TEST(test_prio);
+#endif
+#if RING_BUFFER_ENABLE_SET
+    RUN_TEST(test_set);
+#endif
+#if RING_BUFFER_ENABLE_DEQUE
+    RUN_TEST(test_deque);
+#endif
+#if RING_BUFFER_ENABLE_MPSC
+    RUN_TEST(test_mpsc);
+#endif
+#if RING_BUFFER_ENABLE_MERGE
+    RUN_TEST(test_merge);
+#endif
+#if RING_BUFFER_ENABLE_LZ
+    RUN_TEST(test_lz);
+#endif
+#if RING_BUFFER_ENABLE_SPINLOCK
+    RUN_TEST(test_spinlock);
+#endif
+#if RING_BUFFER_ENABLE_SNAPSHOT
+    RUN_TEST(test_snapshot);
+#endif
+#if RING_BUFFER_ENABLE_HUGEMEM
+    RUN_TEST(test_hugemem);
+#endif
+#if RING_BUFFER_ENABLE_TRACE
+    RUN_TEST(test_trace);
+#endif
+    RUN_TEST(test_transfer);
+#if RING_BUFFER_ENABLE_PIPELINE
+    RUN_TEST(test_pipeline);
+#endif
+#if RING_BUFFER_ENABLE_NOTIFY
+    RUN_TEST(test_notify);
+#endif
+#if RING_BUFFER_ENABLE_LOCKFREE
+    RUN_TEST(test_static_define);
+#endif
     
     printf("\n========== All Tests Passed! ==========\n\n");
     
@@ -0,0 +1,403 @@
+/**
+ * @file    ring_buffer_test.cpp
+ * @brief   环形缓冲区 C++ 模板前端单元测试
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ */
+
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ring_buffer.hpp"
+
+/* Test utilities ------------------------------------------------------------*/
+
+#define TEST_ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("? FAILED: %s (line %d)\n", #cond, __LINE__); \
+        return false; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    printf("Testing: %s ... ", #test_func); \
+    if (test_func()) { \
+        printf("? PASSED\n"); \
+    } else { \
+        printf("? FAILED\n"); \
+        return 1; \
+    } \
+} while(0)
+
+/* Test cases ----------------------------------------------------------------*/
+
+bool test_ring_basic(void)
+{
+    rb::ring<uint32_t, 4> r;
+    uint32_t v = 0;
+    
+    static_assert(rb::ring<uint32_t, 4>::capacity() == 4, "capacity");
+    
+    TEST_ASSERT(r.empty() && !r.try_pop(v));
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT(r.try_push(i));
+    }
+    TEST_ASSERT(r.full() && !r.try_push(99U));
+    
+    /* 反复环绕，先进先出 */
+    for (uint32_t i = 4; i < 100; i++) {
+        TEST_ASSERT(r.try_pop(v) && v == i - 4);
+        TEST_ASSERT(r.try_push(i));
+    }
+    TEST_ASSERT(r.size() == 4);
+    
+    return true;
+}
+
+static int live_objects = 0;
+
+struct tracked {
+    std::unique_ptr<std::string> s;
+    
+    explicit tracked(const char *text) : s(new std::string(text)) { live_objects++; }
+    tracked() { live_objects++; }
+    tracked(tracked &&o) noexcept : s(std::move(o.s)) { live_objects++; }
+    tracked &operator=(tracked &&o) noexcept { s = std::move(o.s); return *this; }
+    ~tracked() { live_objects--; }
+};
+
+bool test_ring_nontrivial(void)
+{
+    {
+        rb::ring<tracked, 3> r;
+        tracked out;
+        
+        TEST_ASSERT(r.emplace("alpha"));
+        TEST_ASSERT(r.emplace("beta"));
+        TEST_ASSERT(r.try_push(tracked("gamma")));
+        TEST_ASSERT(!r.emplace("delta"));
+        TEST_ASSERT(live_objects == 4);
+        
+        /* 移动取出后槽位内的对象已析构 */
+        TEST_ASSERT(r.try_pop(out) && *out.s == "alpha");
+        TEST_ASSERT(live_objects == 3);
+        TEST_ASSERT(r.try_pop(out) && *out.s == "beta");
+        TEST_ASSERT(r.emplace("epsilon"));
+    }
+    
+    /* 析构时销毁剩余元素 */
+    TEST_ASSERT(live_objects == 0);
+    
+    return true;
+}
+
+bool test_ring_c_interop(void)
+{
+    rb::ring<uint32_t, 15> r;
+    ring_buffer_t *c = r.c_handle();
+    uint32_t words[4] = {0x11111111U, 0x22222222U, 0x33333333U, 0x44444444U};
+    uint32_t v = 0;
+    
+    /* C++ 写入、C 读取 */
+    TEST_ASSERT(r.try_push(words[0]) && r.try_push(words[1]));
+    TEST_ASSERT(ring_buffer_available(c) == 2 * sizeof(uint32_t));
+    TEST_ASSERT(ring_buffer_read_multi(c, (uint8_t *)&v, sizeof(v)) == sizeof(v) && v == words[0]);
+    
+    /* C 写入、C++ 读取 */
+    TEST_ASSERT(ring_buffer_write_multi(c, (const uint8_t *)&words[2], 2 * sizeof(uint32_t)) == 2 * sizeof(uint32_t));
+    TEST_ASSERT(r.size() == 3);
+    TEST_ASSERT(r.try_pop(v) && v == words[1]);
+    TEST_ASSERT(r.try_pop(v) && v == words[2]);
+    TEST_ASSERT(r.try_pop(v) && v == words[3]);
+    TEST_ASSERT(ring_buffer_is_empty(c));
+    
+    /* 接近满时 C 端只写整元素，不会写入半个元素使写指针错位 */
+    rb::ring<uint32_t, 3> small;
+    c = small.c_handle();
+    TEST_ASSERT(ring_buffer_free_space(c) == 3 * sizeof(uint32_t));
+    TEST_ASSERT(ring_buffer_write_multi(c, (const uint8_t *)words, sizeof(words)) == 3 * sizeof(uint32_t));
+    TEST_ASSERT(ring_buffer_is_full(c) && ring_buffer_free_space(c) == 0);
+    TEST_ASSERT(ring_buffer_write_multi(c, (const uint8_t *)&words[3], sizeof(uint32_t)) == 0);
+    TEST_ASSERT(!ring_buffer_write(c, 0xEE));
+    TEST_ASSERT(small.size() == 3);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT(small.try_pop(v) && v == words[i]);
+    }
+    TEST_ASSERT(!small.try_pop(v));
+    
+    /* 长度不足整元素时向下取整，读取同理 */
+    TEST_ASSERT(ring_buffer_write_multi(c, (const uint8_t *)words, 6) == sizeof(uint32_t));
+    TEST_ASSERT(small.try_push(words[1]));
+    uint8_t raw[8];
+    TEST_ASSERT(ring_buffer_read_multi(c, raw, 7) == sizeof(uint32_t));
+    TEST_ASSERT(memcmp(raw, &words[0], sizeof(uint32_t)) == 0);
+    TEST_ASSERT(ring_buffer_read_multi(c, raw, sizeof(raw)) == sizeof(uint32_t));
+    TEST_ASSERT(memcmp(raw, &words[1], sizeof(uint32_t)) == 0);
+    TEST_ASSERT(small.empty());
+    
+    return true;
+}
+
+/**
+ * @brief 多生产者多消费者：元素总和守恒
+ */
+template <typename Policy>
+bool ring_stress(unsigned producers, unsigned consumers)
+{
+    constexpr uint32_t per_producer = 20000;
+    static rb::ring<uint64_t, 64, Policy> r;
+    std::atomic<uint64_t> popped_sum{0};
+    std::atomic<uint32_t> popped{0};
+    uint32_t total = per_producer * producers;
+    std::vector<std::thread> threads;
+    
+    for (unsigned p = 0; p < producers; p++) {
+        threads.emplace_back([p] {
+            for (uint32_t i = 0; i < per_producer; i++) {
+                while (!r.try_push((uint64_t)p * per_producer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (unsigned c = 0; c < consumers; c++) {
+        threads.emplace_back([&] {
+            uint64_t v;
+            while (popped.load() < total) {
+                if (r.try_pop(v)) {
+                    popped_sum += v;
+                    popped++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    
+    uint64_t n = total;
+    TEST_ASSERT(popped.load() == total);
+    TEST_ASSERT(popped_sum.load() == n * (n - 1) / 2);
+    TEST_ASSERT(r.empty());
+    
+    return true;
+}
+
+bool test_ring_policies(void)
+{
+    TEST_ASSERT(ring_stress<rb::policy::spsc>(1, 1));
+    TEST_ASSERT(ring_stress<rb::policy::mpsc>(3, 1));
+    TEST_ASSERT(ring_stress<rb::policy::mpmc>(3, 3));
+    TEST_ASSERT(ring_stress<rb::policy::locked>(3, 3));
+    
+    return true;
+}
+
+#if RB_HAS_COROUTINES
+/**
+ * @brief 最小协程任务：立即开始执行，结束后由调用者销毁
+ */
+struct co_task {
+    struct promise_type {
+        co_task get_return_object() { return co_task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    
+    std::coroutine_handle<promise_type> handle;
+    
+    explicit co_task(std::coroutine_handle<promise_type> h) : handle(h) {}
+    co_task(co_task &&o) noexcept : handle(o.handle) { o.handle = nullptr; }
+    ~co_task() { if (handle) handle.destroy(); }
+    bool done() const { return handle.done(); }
+};
+
+static co_task co_consumer(rb::async_ring<uint8_t, 16> &r, uint32_t total, uint32_t *sum, uint32_t *suspends)
+{
+    uint8_t buf[5];
+    
+    for (uint32_t got = 0; got < total; ) {
+        bool was_empty = r.empty();
+        std::size_t n = co_await r.read_some(buf);
+        *suspends += was_empty;
+        for (std::size_t i = 0; i < n; i++) {
+            *sum += buf[i];
+        }
+        got += (uint32_t)n;
+    }
+}
+
+static co_task co_producer(rb::async_ring<uint8_t, 16> &r, const uint8_t *data, uint32_t len, uint32_t chunk)
+{
+    for (uint32_t off = 0; off < len; off += chunk) {
+        uint32_t n = (len - off < chunk) ? (len - off) : chunk;
+        co_await r.write_all(std::span<const uint8_t>(data + off, n));
+    }
+}
+
+bool test_async_ring(void)
+{
+    rb::async_ring<uint8_t, 16> r;
+    static uint8_t data[10000];
+    uint32_t expect = 0;
+    uint32_t sum = 0;
+    uint32_t suspends = 0;
+    
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7U);
+        expect += data[i];
+    }
+    
+    /* 读空时挂起，写入方发布后直接恢复 */
+    {
+        co_task c = co_consumer(r, 3, &sum, &suspends);
+        TEST_ASSERT(!c.done());
+        TEST_ASSERT(r.try_push(1));
+        TEST_ASSERT(r.try_push(2));
+        TEST_ASSERT(r.try_push(3));
+        TEST_ASSERT(c.done() && sum == 6);
+    }
+    
+    /* 写满时挂起，读取方腾出空间后代为写完并恢复 */
+    {
+        co_task p = co_producer(r, data, 40, 40);
+        TEST_ASSERT(!p.done() && r.size() == 16);
+        uint32_t got = 0;
+        uint8_t v;
+        while (r.try_pop(v)) {
+            TEST_ASSERT(v == data[got]);
+            got++;
+        }
+        TEST_ASSERT(p.done() && got == 40);
+    }
+    
+    /* 两个协程之间纯粹靠交接推进，无轮询 */
+    sum = 0;
+    suspends = 0;
+    {
+        co_task c = co_consumer(r, sizeof(data), &sum, &suspends);
+        co_task p = co_producer(r, data, sizeof(data), 37);
+        TEST_ASSERT(c.done() && p.done());
+        TEST_ASSERT(sum == expect && suspends > 0);
+    }
+    TEST_ASSERT(r.empty());
+    
+    return true;
+}
+
+static std::atomic<uint32_t> co_posted{0};
+
+static void co_post(void *ctx, std::coroutine_handle<> h)
+{
+    /* 模拟执行器：记录后在当前线程恢复 */
+    (void)ctx;
+    co_posted++;
+    h.resume();
+}
+
+bool test_async_ring_threads(void)
+{
+    static rb::async_ring<uint8_t, 16> r(co_post, nullptr);
+    uint32_t sum = 0;
+    uint32_t suspends = 0;
+    uint32_t expect = 0;
+    
+    co_task c = co_consumer(r, 50000, &sum, &suspends);
+    
+    /* 另一线程用非挂起接口写入，消费者协程由发布方线程恢复 */
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < 50000; i++) {
+            while (!r.try_push((uint8_t)i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (uint32_t i = 0; i < 50000; i++) {
+        expect += (uint8_t)i;
+    }
+    producer.join();
+    
+    TEST_ASSERT(c.done() && sum == expect);
+    TEST_ASSERT(co_posted.load() > 0);
+    
+    return true;
+}
+
+static co_task co_sum(rb::async_ring<uint32_t, 8, rb::policy::mpsc> &r, uint32_t total, uint64_t *sum)
+{
+    uint32_t buf[3];
+    
+    for (uint32_t got = 0; got < total; ) {
+        std::size_t n = co_await r.read_some(buf);
+        for (std::size_t i = 0; i < n; i++) {
+            *sum += buf[i];
+        }
+        got += (uint32_t)n;
+    }
+}
+
+/**
+ * @brief 多个发布方线程同时恢复同一个协程：恢复后的协程在原地重新挂起，
+ *        旧的 await_suspend 不得误删新的登记
+ */
+bool test_async_ring_publishers(void)
+{
+    constexpr unsigned producers = 3;
+    constexpr uint32_t per_producer = 5000;
+    
+    for (int round = 0; round < 20; round++) {
+        static rb::async_ring<uint32_t, 8, rb::policy::mpsc> r;
+        uint64_t sum = 0;
+        uint64_t n = (uint64_t)producers * per_producer;
+        std::vector<std::thread> threads;
+        
+        co_task c = co_sum(r, (uint32_t)n, &sum);
+        for (unsigned p = 0; p < producers; p++) {
+            threads.emplace_back([p] {
+                for (uint32_t i = 0; i < per_producer; i++) {
+                    while (!r.try_push(p * per_producer + i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+        
+        TEST_ASSERT(c.done() && sum == n * (n - 1) / 2);
+        TEST_ASSERT(r.empty());
+    }
+    
+    return true;
+}
+#endif
+
+/* Main ----------------------------------------------------------------------*/
+
+int main(void)
+{
+    printf("\n========== Ring Buffer C++ Tests ==========\n\n");
+    
+    RUN_TEST(test_ring_basic);
+    RUN_TEST(test_ring_nontrivial);
+    RUN_TEST(test_ring_c_interop);
+    RUN_TEST(test_ring_policies);
+#if RB_HAS_COROUTINES
+    RUN_TEST(test_async_ring);
+    RUN_TEST(test_async_ring_threads);
+    RUN_TEST(test_async_ring_publishers);
+#endif
+    
+    printf("\n========== All Tests Passed! ==========\n\n");
+    
+    return 0;
+}
@@ -0,0 +1,396 @@
+/**
+ * @file    ring_buffer_trace.c
+ * @brief   读写轨迹录制与回放（按真实流量离线选择策略与参数）
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 合成基准的到达模式与现场突发流量不符，参数选择依据不足
+ * - 现场录制一段 write_multi/read_multi 轨迹，离线按原节奏（或加速）
+ *   重放到不同策略、容量、批量阈值的缓冲区上比较丢弃次数与峰值占用
+ *
+ * 实现要点：
+ * - 录制挂在 ring_buffer_write_multi/ring_buffer_read_multi 入口，
+ *   未开始录制时只多一次指针判断
+ * - 记录槽位以原子加法预留，多个生产者/消费者可同时录制，不加锁
+ * - 每条记录 16 字节：相对时间（纳秒）、请求长度（最高位为操作类型）、实际完成长度
+ * - 回放时写记录与读记录分别在两个线程上按各自时间表执行，还原生产者与消费者的相对节奏
+ *
+ * @note 录制文件按主机字节序存储，仅用于同一架构的主机之间
+ */
+
+#include "ring_buffer.h"
+
+#if RING_BUFFER_ENABLE_TRACE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+/* Private defines -----------------------------------------------------------*/
+
+#define TRACE_MAGIC    0x52545242UL     /**< "RBTR"（小端）*/
+#define TRACE_VERSION  1U
+#define TRACE_SPIN_NS  50000U           /**< 距目标时刻小于此值时改为让出 CPU 轮询 */
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 录制文件头（16 字节）
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t rec_size;                      /**< sizeof(ring_buffer_trace_rec_t)，用于校验 */
+    uint32_t ring_size;                     /**< 录制时的缓冲区大小 */
+    uint32_t count;                         /**< 记录数 */
+} trace_file_hdr_t;
+
+/**
+ * @brief 回放线程上下文（写端、读端各一个）
+ */
+typedef struct {
+    const ring_buffer_trace_t *tr;
+    ring_buffer_t *rb;
+    uint32_t speed;
+    uint64_t t0;                            /**< 回放开始时刻 */
+    bool reader;                            /**< true = 执行读记录 */
+    uint8_t *scratch;                       /**< 写入/读出的数据区 */
+    ring_buffer_trace_result_t res;         /**< 本端结果 */
+} trace_replay_ctx_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+static inline uint64_t trace_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 等待到 target 时刻
+ * @return 实际执行时刻落后 target 的纳秒数
+ */
+static uint64_t trace_wait_until(uint64_t target)
+{
+    uint64_t now = trace_now_ns();
+    
+    while (now < target) {
+        /* 远离目标时睡眠，临近时让出 CPU 轮询以减小误差 */
+        if (target - now > TRACE_SPIN_NS) {
+            uint64_t ns = target - now - TRACE_SPIN_NS;
+            struct timespec ts = { (time_t)(ns / 1000000000ULL), (long)(ns % 1000000000ULL) };
+            nanosleep(&ts, NULL);
+        } else {
+            sched_yield();
+        }
+        now = trace_now_ns();
+    }
+    return now - target;
+}
+
+static int trace_cmp_time(const void *a, const void *b)
+{
+    uint64_t ta = ((const ring_buffer_trace_rec_t *)a)->time;
+    uint64_t tb = ((const ring_buffer_trace_rec_t *)b)->time;
+    
+    return (ta > tb) - (ta < tb);
+}
+
+static void *trace_replay_run(void *arg)
+{
+    trace_replay_ctx_t *ctx = (trace_replay_ctx_t *)arg;
+    ring_buffer_t *rb = ctx->rb;
+    uint32_t count = ring_buffer_trace_count(ctx->tr, NULL);
+    
+    for (uint32_t i = 0; i < count; i++) {
+        const ring_buffer_trace_rec_t *rec = &ctx->tr->recs[i];
+        
+        if (((rec->len & RING_BUFFER_TRACE_OP_READ) != 0) != ctx->reader) {
+            continue;
+        }
+        
+        /* 目标缓冲区容量可能小于录制时，单次请求不超过容量 */
+        uint32_t want = rec->len & ~(uint32_t)RING_BUFFER_TRACE_OP_READ;
+        ring_buffer_size_t len = (ring_buffer_size_t)((want < rb->size) ? want : rb->size);
+        if (len == 0) {
+            continue;
+        }
+        
+        if (ctx->speed > 0) {
+            uint64_t lag = trace_wait_until(ctx->t0 + rec->time / ctx->speed);
+            if (lag > ctx->res.max_lag_ns) {
+                ctx->res.max_lag_ns = lag;
+            }
+        }
+        
+        if (ctx->reader) {
+            ring_buffer_size_t n = ring_buffer_read_multi(rb, ctx->scratch, len);
+            ctx->res.read += n;
+            if (n == 0) {
+                ctx->res.empty_reads++;
+            }
+        } else {
+            ring_buffer_size_t n = ring_buffer_write_multi(rb, ctx->scratch, len);
+            ctx->res.written += n;
+            if (n < len) {
+                ctx->res.short_writes++;
+            }
+            
+            ring_buffer_size_t used = ring_buffer_available(rb);
+            if (used > ctx->res.peak_used) {
+                ctx->res.peak_used = used;
+            }
+        }
+    }
+    
+    /* 批量发布模式下发布残留的读/写指针 */
+    ring_buffer_flush(rb, ctx->reader ? RING_BUFFER_FLUSH_READ : RING_BUFFER_FLUSH_WRITE);
+    return NULL;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 追加一条记录（由 ring_buffer_write_multi/ring_buffer_read_multi 调用）
+ */
+void ring_buffer_trace_record(ring_buffer_trace_t *tr, uint32_t len, ring_buffer_size_t done)
+{
+    uint64_t now = trace_now_ns();
+    
+    /* 写满后不再预留槽位，避免计数回绕后覆盖已有记录 */
+    if (RB_LOAD_ACQUIRE(&tr->count) >= tr->capacity) {
+        RB_FETCH_ADD(&tr->dropped, 1U);
+        return;
+    }
+    
+    uint32_t i = RB_FETCH_ADD(&tr->count, 1U);
+    if (i >= tr->capacity) {
+        return;
+    }
+    
+    ring_buffer_trace_rec_t *rec = &tr->recs[i];
+    rec->time = now - tr->start;
+    rec->len = len;
+    rec->done = (uint32_t)done;
+}
+
+bool ring_buffer_trace_init(ring_buffer_trace_t *tr, ring_buffer_trace_rec_t *recs, uint32_t capacity)
+{
+    if (!tr || !recs || capacity == 0) {
+        RB_LOG_ERROR("tr or recs is NULL, or capacity is 0");
+        return false;
+    }
+    
+    tr->recs = recs;
+    tr->capacity = capacity;
+    tr->count = 0;
+    tr->dropped = 0;
+    tr->ring_size = 0;
+    tr->start = 0;
+    
+    return true;
+}
+
+bool ring_buffer_trace_start(ring_buffer_t *rb, ring_buffer_trace_t *tr)
+{
+    if (!rb || !tr) {
+        RB_LOG_ERROR("rb or tr is NULL");
+        return false;
+    }
+    
+    if (!tr->recs) {
+        RB_LOG_ERROR("trace not initialized (tr=%p)", (void *)tr);
+        return false;
+    }
+    
+    tr->start = trace_now_ns();
+    tr->ring_size = (uint32_t)rb->size;
+    RB_STORE_RELEASE(&rb->trace, tr);
+    
+    RB_LOG_INFO("Trace started (size=%u, capacity=%lu)", rb->size, (unsigned long)tr->capacity);
+    return true;
+}
+
+void ring_buffer_trace_stop(ring_buffer_t *rb)
+{
+    if (!rb) {
+        RB_LOG_ERROR("rb is NULL");
+        return;
+    }
+    
+    RB_STORE_RELEASE(&rb->trace, (ring_buffer_trace_t *)NULL);
+}
+
+uint32_t ring_buffer_trace_count(const ring_buffer_trace_t *tr, uint32_t *dropped)
+{
+    if (!tr) {
+        RB_LOG_ERROR("tr is NULL");
+        return 0;
+    }
+    
+    uint32_t count = RB_LOAD_ACQUIRE(&tr->count);
+    uint32_t valid = (count < tr->capacity) ? count : tr->capacity;
+    
+    if (dropped) {
+        /* 预留时越过容量的槽位同样计为丢弃 */
+        *dropped = tr->dropped + (count - valid);
+    }
+    return valid;
+}
+
+bool ring_buffer_trace_save(ring_buffer_trace_t *tr, const char *path)
+{
+    if (!tr || !path) {
+        RB_LOG_ERROR("tr or path is NULL");
+        return false;
+    }
+    
+    uint32_t count = ring_buffer_trace_count(tr, NULL);
+    
+    /* 多线程预留的槽位顺序与时间顺序可能略有出入 */
+    qsort(tr->recs, count, sizeof(ring_buffer_trace_rec_t), trace_cmp_time);
+    
+    FILE *fp = fopen(path, "wb");
+    if (!fp) {
+        RB_LOG_ERROR("Open %s failed", path);
+        return false;
+    }
+    
+    trace_file_hdr_t hdr = {
+        .magic = TRACE_MAGIC,
+        .version = TRACE_VERSION,
+        .rec_size = (uint16_t)sizeof(ring_buffer_trace_rec_t),
+        .ring_size = tr->ring_size,
+        .count = count,
+    };
+    
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+              fwrite(tr->recs, sizeof(ring_buffer_trace_rec_t), count, fp) == count;
+    ok = (fclose(fp) == 0) && ok;
+    
+    if (!ok) {
+        RB_LOG_ERROR("Write %s failed", path);
+        return false;
+    }
+    
+    RB_LOG_INFO("Trace saved (%s, count=%lu)", path, (unsigned long)count);
+    return true;
+}
+
+bool ring_buffer_trace_load(ring_buffer_trace_t *tr, ring_buffer_trace_rec_t *recs,
+                            uint32_t capacity, const char *path)
+{
+    if (!path) {
+        RB_LOG_ERROR("path is NULL");
+        return false;
+    }
+    
+    if (!ring_buffer_trace_init(tr, recs, capacity)) {
+        return false;
+    }
+    
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        RB_LOG_ERROR("Open %s failed", path);
+        return false;
+    }
+    
+    trace_file_hdr_t hdr;
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 || hdr.magic != TRACE_MAGIC ||
+        hdr.version != TRACE_VERSION || hdr.rec_size != sizeof(ring_buffer_trace_rec_t)) {
+        RB_LOG_ERROR("%s is not a trace file", path);
+        fclose(fp);
+        return false;
+    }
+    
+    uint32_t count = hdr.count;
+    if (count > capacity) {
+        RB_LOG_WARN("Trace truncated (count=%lu, capacity=%lu)", (unsigned long)count, (unsigned long)capacity);
+        count = capacity;
+    }
+    
+    if (fread(recs, sizeof(ring_buffer_trace_rec_t), count, fp) != count) {
+        RB_LOG_ERROR("%s is truncated", path);
+        fclose(fp);
+        return false;
+    }
+    fclose(fp);
+    
+    tr->count = count;
+    tr->ring_size = hdr.ring_size;
+    
+    RB_LOG_INFO("Trace loaded (%s, count=%lu, size=%lu)", path, (unsigned long)count,
+                (unsigned long)hdr.ring_size);
+    return true;
+}
+
+bool ring_buffer_trace_replay(const ring_buffer_trace_t *tr, ring_buffer_t *rb, uint32_t speed,
+                              ring_buffer_trace_result_t *result)
+{
+    if (!tr || !rb || !result) {
+        RB_LOG_ERROR("tr, rb or result is NULL");
+        return false;
+    }
+    
+    if (!rb->buffer || !rb->ops) {
+        RB_LOG_ERROR("rb not created (rb=%p)", (void *)rb);
+        return false;
+    }
+    
+    trace_replay_ctx_t ctx[2];
+    memset(ctx, 0, sizeof(ctx));
+    
+    for (uint8_t i = 0; i < 2; i++) {
+        ctx[i].tr = tr;
+        ctx[i].rb = rb;
+        ctx[i].speed = speed;
+        ctx[i].reader = (i == 1);
+        ctx[i].scratch = (uint8_t *)malloc(rb->size);
+    }
+    
+    if (!ctx[0].scratch || !ctx[1].scratch) {
+        RB_LOG_ERROR("Scratch alloc failed (size=%u)", rb->size);
+        free(ctx[0].scratch);
+        free(ctx[1].scratch);
+        return false;
+    }
+    memset(ctx[0].scratch, 0x5A, rb->size);
+    
+    /* 写端在新线程，读端在调用线程，两端共用同一起点 */
+    uint64_t t0 = trace_now_ns();
+    ctx[0].t0 = t0;
+    ctx[1].t0 = t0;
+    
+    pthread_t writer;
+    if (pthread_create(&writer, NULL, trace_replay_run, &ctx[0]) != 0) {
+        RB_LOG_ERROR("Create replay thread failed");
+        free(ctx[0].scratch);
+        free(ctx[1].scratch);
+        return false;
+    }
+    trace_replay_run(&ctx[1]);
+    pthread_join(writer, NULL);
+    
+    *result = ctx[0].res;
+    result->read = ctx[1].res.read;
+    result->empty_reads = ctx[1].res.empty_reads;
+    result->elapsed_ns = trace_now_ns() - t0;
+    if (ctx[1].res.max_lag_ns > result->max_lag_ns) {
+        result->max_lag_ns = ctx[1].res.max_lag_ns;
+    }
+    
+    free(ctx[0].scratch);
+    free(ctx[1].scratch);
+    
+    RB_LOG_INFO("Trace replayed (speed=%lu, written=%lu, short_writes=%lu)", (unsigned long)speed,
+                (unsigned long)result->written, (unsigned long)result->short_writes);
+    return true;
+}
+
+#endif /* RING_BUFFER_ENABLE_TRACE */
@@ -0,0 +1,475 @@
+/**
+ * @file    ring_buffer_xform.c
+ * @brief   环形缓冲区融合变换读写实现
+ * @author  CRITTY.熙影
+ * @date    2026-10-18
+ * @version 2.3
+ *
+ * @details
+ * 适用场景：
+ * - 读写同时计算 CRC32C 校验
+ * - 大端传感器数据字节序翻转
+ * - int16 采样转 float（音频/ADC）
+ *
+ * 实现要点：
+ * - 基于策略的 read_span/write_span 接口，拷贝与变换在同一遍历中完成
+ * - 每个字节只被访问一次，省去读出后的第二遍处理
+ * - 跨越缓冲区末尾的字通过 8 字节临时区拼接，不要求 size 为字宽整数倍
+ * - 指令集按编译目标选择：SSE4.2/ARMv8 CRC、SSSE3/AVX2/NEON 重排，否则使用标量实现
+ */
+
+#include "ring_buffer.h"
+
+#if defined(__SSE4_2__) || defined(__SSSE3__) || defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+
+/**
+ * @brief 单个变换单元的最大字节数（拼接临时区大小）
+ */
+#define XFORM_UNIT_MAX  8
+
+/* Private types -------------------------------------------------------------*/
+
+/**
+ * @brief 变换内核：处理 units 个单元，src/dst 均可能未对齐
+ */
+typedef void (*xform_kernel_t)(uint8_t *dst, const uint8_t *src, ring_buffer_size_t units, void *arg);
+
+typedef struct {
+    xform_kernel_t kernel;        /**< 变换内核 */
+    void *arg;                    /**< 内核参数 */
+    uint8_t in_unit;              /**< 输入单元字节数 */
+    uint8_t out_unit;             /**< 输出单元字节数 */
+    const uint8_t *src;           /**< 用户侧输入（写方向）*/
+    uint8_t *dst;                 /**< 用户侧输出（读方向）*/
+    ring_buffer_size_t units_max; /**< 最多处理的单元数 */
+} xform_ctx_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+#if !(defined(__SSE4_2__) && defined(__x86_64__)) && !defined(__ARM_FEATURE_CRC32)
+/**
+ * @brief CRC32C 半字节查表（反射多项式 0x82F63B78，仅 64 字节 ROM）
+ */
+static const uint32_t crc32c_nibble_table[16] = {
+    0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
+    0x417B1DBCUL, 0x5125DAD3UL, 0x61C69362UL, 0x7198540DUL,
+    0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
+    0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL,
+};
+#endif
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 累加 CRC32C（未取反的内部状态），dst 非 NULL 时同时拷贝
+ */
+static uint32_t crc32c_update(uint32_t crc, uint8_t *dst, const uint8_t *src, ring_buffer_size_t len)
+{
+    ring_buffer_size_t i = 0;
+    
+#if defined(__SSE4_2__) && defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; (uint32_t)i + 8 <= len; i += 8) {
+        uint64_t v;
+        memcpy(&v, &src[i], 8);
+        if (dst) {
+            memcpy(&dst[i], &v, 8);
+        }
+        crc64 = _mm_crc32_u64(crc64, v);
+    }
+    crc = (uint32_t)crc64;
+    for (; i < len; i++) {
+        if (dst) {
+            dst[i] = src[i];
+        }
+        crc = _mm_crc32_u8(crc, src[i]);
+    }
+#elif defined(__ARM_FEATURE_CRC32)
+    for (; (uint32_t)i + 4 <= len; i += 4) {
+        uint32_t v;
+        memcpy(&v, &src[i], 4);
+        if (dst) {
+            memcpy(&dst[i], &v, 4);
+        }
+        crc = __crc32cw(crc, v);
+    }
+    for (; i < len; i++) {
+        if (dst) {
+            dst[i] = src[i];
+        }
+        crc = __crc32cb(crc, src[i]);
+    }
+#else
+    for (; i < len; i++) {
+        uint8_t b = src[i];
+        if (dst) {
+            dst[i] = b;
+        }
+        crc ^= b;
+        crc = (crc >> 4) ^ crc32c_nibble_table[crc & 0x0FU];
+        crc = (crc >> 4) ^ crc32c_nibble_table[crc & 0x0FU];
+    }
+#endif
+    
+    return crc;
+}
+
+/**
+ * @brief 拷贝并累加 CRC32C（arg 指向未取反的内部状态）
+ */
+static void xform_crc32c_kernel(uint8_t *dst, const uint8_t *src, ring_buffer_size_t units, void *arg)
+{
+    uint32_t *state = (uint32_t *)arg;
+    *state = crc32c_update(*state, dst, src, units);
+}
+
+/**
+ * @brief 按字宽翻转字节序（arg 指向字宽）
+ */
+static void xform_bswap_kernel(uint8_t *dst, const uint8_t *src, ring_buffer_size_t units, void *arg)
+{
+    uint8_t width = *(const uint8_t *)arg;
+    uint32_t bytes = (uint32_t)units * width;
+    uint32_t i = 0;
+    
+#if defined(__AVX2__)
+    const __m256i mask = (width == 2) ?
+        _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                         1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+        (width == 4) ?
+        _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                         3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+        _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                         7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)&src[i]);
+        _mm256_storeu_si256((__m256i *)(void *)&dst[i], _mm256_shuffle_epi8(v, mask));
+    }
+#elif defined(__SSSE3__)
+    const __m128i mask = (width == 2) ?
+        _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+        (width == 4) ?
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+        _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&src[i]);
+        _mm_storeu_si128((__m128i *)(void *)&dst[i], _mm_shuffle_epi8(v, mask));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= bytes; i += 16) {
+        uint8x16_t v = vld1q_u8(&src[i]);
+        if (width == 2) {
+            v = vrev16q_u8(v);
+        } else if (width == 4) {
+            v = vrev32q_u8(v);
+        } else {
+            v = vrev64q_u8(v);
+        }
+        vst1q_u8(&dst[i], v);
+    }
+#endif
+    
+    /* 标量处理剩余部分（向量块总是字宽的整数倍）*/
+    for (; i < bytes; i += width) {
+        for (uint8_t k = 0; k < width; k++) {
+            dst[i + k] = src[i + width - 1 - k];
+        }
+    }
+}
+
+/**
+ * @brief int16 转 float（arg 指向缩放系数）
+ */
+static void xform_s16_f32_kernel(uint8_t *dst, const uint8_t *src, ring_buffer_size_t units, void *arg)
+{
+    float scale = *(const float *)arg;
+    ring_buffer_size_t i = 0;
+    
+#if defined(__AVX2__)
+    const __m256 vscale = _mm256_set1_ps(scale);
+    for (; (uint32_t)i + 8 <= units; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&src[i * 2]);
+        __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v));
+        _mm256_storeu_ps((float *)(void *)&dst[i * 4], _mm256_mul_ps(f, vscale));
+    }
+#elif defined(__SSE2__)
+    const __m128 vscale = _mm_set1_ps(scale);
+    for (; (uint32_t)i + 4 <= units; i += 4) {
+        __m128i v = _mm_loadl_epi64((const __m128i *)(const void *)&src[i * 2]);
+        __m128i w = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        _mm_storeu_ps((float *)(void *)&dst[i * 4], _mm_mul_ps(_mm_cvtepi32_ps(w), vscale));
+    }
+#elif defined(__ARM_NEON)
+    for (; (uint32_t)i + 4 <= units; i += 4) {
+        int16x4_t v = vreinterpret_s16_u8(vld1_u8(&src[i * 2]));
+        float32x4_t f = vcvtq_f32_s32(vmovl_s16(v));
+        vst1q_u8(&dst[i * 4], vreinterpretq_u8_f32(vmulq_n_f32(f, scale)));
+    }
+#endif
+    
+    for (; i < units; i++) {
+        int16_t s;
+        float f;
+        memcpy(&s, &src[i * 2], sizeof(s));
+        f = (float)s * scale;
+        memcpy(&dst[i * 4], &f, sizeof(f));
+    }
+}
+
+/**
+ * @brief 读方向：缓冲区数据段 → 变换 → 用户缓冲区
+ */
+static ring_buffer_size_t xform_read_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    xform_ctx_t *xc = (xform_ctx_t *)ctx;
+    ring_buffer_size_t total = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        total += spans[i].len;
+    }
+    
+    ring_buffer_size_t units = total / xc->in_unit;
+    if (units > xc->units_max) {
+        units = xc->units_max;
+    }
+    
+    ring_buffer_size_t remain = units;
+    ring_buffer_size_t skip = 0;  /* 第二段开头已被拼接单元消耗的字节数 */
+    
+    for (uint8_t i = 0; i < count && remain > 0; i++) {
+        const uint8_t *p = spans[i].data + skip;
+        ring_buffer_size_t seg_len = spans[i].len - skip;
+        ring_buffer_size_t n = seg_len / xc->in_unit;
+        
+        if (n > remain) {
+            n = remain;
+        }
+        
+        xc->kernel(xc->dst, p, n, xc->arg);
+        xc->dst += (uint32_t)n * xc->out_unit;
+        remain -= n;
+        skip = 0;
+        
+        /* 跨越末尾的单元：拼接后处理 */
+        ring_buffer_size_t rest = seg_len - n * xc->in_unit;
+        if (remain > 0 && rest > 0 && i + 1 < count) {
+            uint8_t tmp[XFORM_UNIT_MAX];
+            memcpy(tmp, p + n * xc->in_unit, rest);
+            memcpy(&tmp[rest], spans[i + 1].data, xc->in_unit - rest);
+            xc->kernel(xc->dst, tmp, 1, xc->arg);
+            xc->dst += xc->out_unit;
+            remain--;
+            skip = xc->in_unit - rest;
+        }
+    }
+    
+    return (ring_buffer_size_t)(units * xc->in_unit);
+}
+
+/**
+ * @brief 写方向：用户数据 → 变换 → 缓冲区空闲段
+ */
+static ring_buffer_size_t xform_write_span_cb(void *ctx, const ring_buffer_span_t *spans, uint8_t count)
+{
+    xform_ctx_t *xc = (xform_ctx_t *)ctx;
+    ring_buffer_size_t total = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        total += spans[i].len;
+    }
+    
+    ring_buffer_size_t units = total / xc->out_unit;
+    if (units > xc->units_max) {
+        units = xc->units_max;
+    }
+    
+    ring_buffer_size_t remain = units;
+    ring_buffer_size_t skip = 0;
+    
+    for (uint8_t i = 0; i < count && remain > 0; i++) {
+        uint8_t *p = spans[i].data + skip;
+        ring_buffer_size_t seg_len = spans[i].len - skip;
+        ring_buffer_size_t n = seg_len / xc->out_unit;
+        
+        if (n > remain) {
+            n = remain;
+        }
+        
+        xc->kernel(p, xc->src, n, xc->arg);
+        xc->src += (uint32_t)n * xc->in_unit;
+        remain -= n;
+        skip = 0;
+        
+        /* 跨越末尾的单元：变换到临时区后拆分写入 */
+        ring_buffer_size_t rest = seg_len - n * xc->out_unit;
+        if (remain > 0 && rest > 0 && i + 1 < count) {
+            uint8_t tmp[XFORM_UNIT_MAX];
+            xc->kernel(tmp, xc->src, 1, xc->arg);
+            memcpy(p + n * xc->out_unit, tmp, rest);
+            memcpy(spans[i + 1].data, &tmp[rest], xc->out_unit - rest);
+            xc->src += xc->in_unit;
+            remain--;
+            skip = xc->out_unit - rest;
+        }
+    }
+    
+    return (ring_buffer_size_t)(units * xc->out_unit);
+}
+
+static bool xform_width_valid(uint8_t width)
+{
+    return (width == 2 || width == 4 || width == 8);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+uint32_t ring_buffer_crc32c(uint32_t crc, const uint8_t *data, ring_buffer_size_t len)
+{
+    if (!data || len == 0) {
+        return crc;
+    }
+    
+    return ~crc32c_update(~crc, NULL, data, len);
+}
+
+ring_buffer_size_t ring_buffer_write_multi_crc32c(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len, uint32_t *crc)
+{
+    if (!data) {
+        RB_LOG_ERROR("data is NULL");
+        return 0;
+    }
+    
+    if (!crc) {
+        RB_LOG_ERROR("crc is NULL");
+        return 0;
+    }
+    
+    uint32_t state = ~(*crc);
+    xform_ctx_t xc = {
+        .kernel = xform_crc32c_kernel,
+        .arg = &state,
+        .in_unit = 1,
+        .out_unit = 1,
+        .src = data,
+        .dst = NULL,
+        .units_max = len,
+    };
+    
+    ring_buffer_size_t written = ring_buffer_write_span(rb, len, xform_write_span_cb, &xc, 0);
+    *crc = ~state;
+    return written;
+}
+
+ring_buffer_size_t ring_buffer_read_multi_crc32c(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len, uint32_t *crc)
+{
+    if (!data) {
+        RB_LOG_ERROR("data is NULL");
+        return 0;
+    }
+    
+    if (!crc) {
+        RB_LOG_ERROR("crc is NULL");
+        return 0;
+    }
+    
+    uint32_t state = ~(*crc);
+    xform_ctx_t xc = {
+        .kernel = xform_crc32c_kernel,
+        .arg = &state,
+        .in_unit = 1,
+        .out_unit = 1,
+        .src = NULL,
+        .dst = data,
+        .units_max = len,
+    };
+    
+    ring_buffer_size_t read = ring_buffer_read_span(rb, len, xform_read_span_cb, &xc, 0);
+    *crc = ~state;
+    return read;
+}
+
+ring_buffer_size_t ring_buffer_write_multi_bswap(ring_buffer_t *rb, const uint8_t *data, ring_buffer_size_t len, uint8_t width)
+{
+    if (!data) {
+        RB_LOG_ERROR("data is NULL");
+        return 0;
+    }
+    
+    if (!xform_width_valid(width)) {
+        RB_LOG_ERROR("Invalid width %u (must be 2/4/8)", width);
+        return 0;
+    }
+    
+    xform_ctx_t xc = {
+        .kernel = xform_bswap_kernel,
+        .arg = &width,
+        .in_unit = width,
+        .out_unit = width,
+        .src = data,
+        .dst = NULL,
+        .units_max = len / width,
+    };
+    
+    return ring_buffer_write_span(rb, len - len % width, xform_write_span_cb, &xc, 0);
+}
+
+ring_buffer_size_t ring_buffer_read_multi_bswap(ring_buffer_t *rb, uint8_t *data, ring_buffer_size_t len, uint8_t width)
+{
+    if (!data) {
+        RB_LOG_ERROR("data is NULL");
+        return 0;
+    }
+    
+    if (!xform_width_valid(width)) {
+        RB_LOG_ERROR("Invalid width %u (must be 2/4/8)", width);
+        return 0;
+    }
+    
+    xform_ctx_t xc = {
+        .kernel = xform_bswap_kernel,
+        .arg = &width,
+        .in_unit = width,
+        .out_unit = width,
+        .src = NULL,
+        .dst = data,
+        .units_max = len / width,
+    };
+    
+    return ring_buffer_read_span(rb, len - len % width, xform_read_span_cb, &xc, 0);
+}
+
+ring_buffer_size_t ring_buffer_read_s16_to_f32(ring_buffer_t *rb, float *data, ring_buffer_size_t count, float scale)
+{
+    if (!data) {
+        RB_LOG_ERROR("data is NULL");
+        return 0;
+    }
+    
+    if (count > RING_BUFFER_SIZE_MAX / 2) {
+        count = RING_BUFFER_SIZE_MAX / 2;
+    }
+    
+    xform_ctx_t xc = {
+        .kernel = xform_s16_f32_kernel,
+        .arg = &scale,
+        .in_unit = 2,
+        .out_unit = 4,
+        .src = NULL,
+        .dst = (uint8_t *)data,
+        .units_max = count,
+    };
+    
+    return ring_buffer_read_span(rb, count * 2, xform_read_span_cb, &xc, 0) / 2;
+}